@@ -286,6 +286,7 @@ class RBL_CommanderAI
 	protected bool LaunchQRFVirtual(ERBLQRFType type, RBL_VirtualZone source, RBL_VirtualZone target, int cost)
 	{
 		m_iFactionResources -= cost;
+		RBL_StateVersion.Bump();
 		m_fTimeSinceLastQRF = 0;
 		
 		RBL_QRFOperation qrf = new RBL_QRFOperation();
@@ -487,6 +488,7 @@ class RBL_CommanderAI
 	protected bool LaunchQRFEntity(ERBLQRFType type, RBL_CampaignZone source, RBL_CampaignZone target, int cost)
 	{
 		m_iFactionResources -= cost;
+		RBL_StateVersion.Bump();
 		m_fTimeSinceLastQRF = 0;
 		
 		RBL_QRFOperation qrf = new RBL_QRFOperation();
@@ -575,8 +577,11 @@ class RBL_CommanderAI
 				income += zone.CalculateResourceIncome() / 10;
 		}
 		
+		int previousResources = m_iFactionResources;
 		m_iFactionResources += income;
 		m_iFactionResources = Math.Min(m_iFactionResources, RBL_Config.AI_MAX_RESOURCES);
+		if (m_iFactionResources != previousResources)
+			RBL_StateVersion.Bump();
 	}
 	
 	array<ref RBL_ActiveMissionData> GetActiveMissionData()
@@ -604,6 +609,7 @@ class RBL_CommanderAI
 	
 	int GetFactionResources() { return m_iFactionResources; }
 	int GetActiveQRFCount() { return m_aActiveQRFs.Count(); }
+	array<ref RBL_QRFOperation> GetActiveQRFs() { return m_aActiveQRFs; }
 	ERBLFactionKey GetControlledFaction() { return m_eControlledFaction; }
 }
 
@@ -869,6 +875,9 @@ class RBL_QRFOperation
 			{
 				m_aSpawnedUnits.Insert(unit);
 				AssignToAIGroup(unit);
+				
+				// Tracked but not counted toward any zone until arrival
+				RBL_ZonePresence.GetInstance().RegisterUnit(unit, "", m_eFaction);
 			}
 		}
 		
@@ -1136,6 +1145,13 @@ class RBL_QRFOperation
 	
 	protected void OnArrival()
 	{
+		// Surviving units now hold the target zone
+		RBL_ZonePresence presence = RBL_ZonePresence.GetInstance();
+		for (int i = 0; i < m_aSpawnedUnits.Count(); i++)
+		{
+			presence.MoveUnit(m_aSpawnedUnits[i], m_sTargetZoneID);
+		}
+		
 		// Reinforce the garrison at target zone
 		RBL_GarrisonManager garMgr = RBL_GarrisonManager.GetInstance();
 		if (garMgr)
@@ -1180,9 +1196,14 @@ class RBL_QRFOperation
 			}
 			
 			if (IsUnitAlive(unit))
+			{
 				alive++;
+			}
 			else
+			{
+				RBL_ZonePresence.GetInstance().UnregisterUnit(unit);
 				m_aSpawnedUnits.Remove(i);
+			}
 		}
 		return alive;
 	}
@@ -1229,11 +1250,15 @@ class RBL_QRFOperation
 	void Cleanup()
 	{
 		// Delete all spawned units
+		RBL_ZonePresence presence = RBL_ZonePresence.GetInstance();
 		for (int i = m_aSpawnedUnits.Count() - 1; i >= 0; i--)
 		{
 			IEntity unit = m_aSpawnedUnits[i];
 			if (unit)
+			{
+				presence.UnregisterUnit(unit);
 				SCR_EntityHelper.DeleteEntityAndChildren(unit);
+			}
 		}
 		m_aSpawnedUnits.Clear();
 		
@@ -1266,6 +1291,7 @@ class RBL_QRFOperation
 	float GetTimeStarted() { return m_fTimeStarted; }
 	int GetAliveCount() { return CountAliveUnits(); }
 	int GetTotalSpawned() { return m_aSpawnedUnits.Count() + m_aSpawnedVehicles.Count(); }
+	array<IEntity> GetSpawnedUnits() { return m_aSpawnedUnits; }
 	
 	bool IsComplete() 
 	{ 
@@ -81,6 +81,12 @@ class RBL_Config
 	
 	static const int ARSENAL_UNLOCK_THRESHOLD = 25;       // Items for unlimited
 	
+	// ========================================================================
+	// ECONOMY - LEDGER
+	// ========================================================================
+	
+	static const int ECONOMY_LEDGER_CAPACITY = 256;       // Committed transactions kept for audit/rollback
+	
 	// ========================================================================
 	// ECONOMY - RECRUITMENT
 	// ========================================================================
@@ -114,6 +120,15 @@ class RBL_Config
 	static const float AUTOSAVE_INTERVAL = 300.0;         // 5 minutes
 	static const string SAVE_FILE_PREFIX = "RBL_Campaign";
 	
+	// ========================================================================
+	// NETWORK
+	// ========================================================================
+	
+	static const float NET_STATS_CSV_INTERVAL = 60.0;     // Bandwidth CSV dump (multiplayer server)
+	static const float TRANSIENT_SEND_INTERVAL = 0.25;    // Capture, QRF and suspicion updates
+	static const float TRANSIENT_KEEPALIVE = 2.0;         // Resend transient state clients can predict
+	static const float TRANSIENT_STALE_TIME = 5.0;        // Client drops transient state not refreshed
+	
 	// ========================================================================
 	// ZONE STRATEGIC VALUES
 	// ========================================================================
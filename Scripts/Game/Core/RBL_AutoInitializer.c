@@ -36,25 +36,25 @@ class RBL_AutoInitializer
 		RBL_UndercoverSystem undercover = RBL_UndercoverSystem.GetInstance();
 		RBL_PersistenceIntegration persistence = RBL_PersistenceIntegration.GetInstance();
 		RBL_ZoneConfigurator zoneConfig = RBL_ZoneConfigurator.GetInstance();
+		
+		// Registers the shop catalog's item IDs before anything is deposited
+		RBL_ShopManager.GetInstance();
 
 		// Create virtual zones from config
 		CreateVirtualZones(zoneConfig, zoneMgr);
 
 		// Set starting resources from config
 		if (econMgr)
-		{
-			econMgr.SetMoney(RBL_Config.STARTING_MONEY);
-			econMgr.SetHR(RBL_Config.STARTING_HR);
-		}
+			econMgr.SetBalance(RBL_Config.STARTING_MONEY, RBL_Config.STARTING_HR);
 
 		// Give some starting items
 		if (econMgr)
 		{
-			econMgr.DepositItem("AK74", 5);
-			econMgr.DepositItem("AKM", 3);
-			econMgr.DepositItem("Makarov", 10);
-			econMgr.DepositItem("RGD5_Grenade", 10);
-			econMgr.DepositItem("Bandage", 20);
+			econMgr.DepositItem("ak74", 5);
+			econMgr.DepositItem("akm", 3);
+			econMgr.DepositItem("makarov", 10);
+			econMgr.DepositItem("grenade_frag", 10);
+			econMgr.DepositItem("bandage", 20);
 		}
 
 		m_bInitialized = true;
@@ -175,6 +175,7 @@ class RBL_VirtualZone
 	void SetUnderAttack(bool attacked) { m_bIsUnderAttack = attacked; }
 	void SetAlertState(ERBLAlertState state) { m_eAlertState = state; }
 	void SetCivilianSupport(int support) { m_iCivilianSupport = Math.Clamp(support, 0, 100); }
+	void SetCurrentGarrison(int strength) { m_iCurrentGarrison = Math.Max(0, strength); }
 
 	float GetDistanceTo(RBL_VirtualZone other)
 	{
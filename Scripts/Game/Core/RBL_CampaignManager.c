@@ -111,10 +111,7 @@ class RBL_CampaignManager : GenericEntity
 
 		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
 		if (econMgr)
-		{
-			econMgr.SetMoney(m_iStartingMoney);
-			econMgr.SetHR(m_iStartingHR);
-		}
+			econMgr.SetBalance(m_iStartingMoney, m_iStartingHR);
 
 		PrintFormat("[RBL] New campaign started. War Level: %1, Aggression: %2", m_iWarLevel, m_iAggression);
 	}
@@ -158,7 +155,10 @@ class RBL_CampaignManager : GenericEntity
 		m_iAggression = Math.Clamp(value, 0, 100);
 
 		if (previousAggression != m_iAggression)
+		{
+			RBL_StateVersion.Bump();
 			m_OnAggressionChanged.Invoke(m_iAggression);
+		}
 	}
 
 	protected void CheckWarLevelEscalation()
@@ -183,6 +183,7 @@ class RBL_CampaignManager : GenericEntity
 
 		if (previousLevel != m_iWarLevel)
 		{
+			RBL_StateVersion.Bump();
 			PrintFormat("[RBL] War Level escalated: %1 -> %2", previousLevel, m_iWarLevel);
 			m_OnWarLevelChanged.Invoke(m_iWarLevel);
 			OnCampaignEvent(ERBLCampaignEvent.WAR_LEVEL_CHANGED, null);
@@ -242,8 +243,10 @@ class RBL_CampaignManager : GenericEntity
 
 		if (totalMoney > 0 || totalHR > 0)
 		{
-			econMgr.AddMoney(totalMoney);
-			econMgr.AddHR(totalHR);
+			RBL_EconomyTransaction income = econMgr.BeginTransaction(RBL_EconomySource.RESOURCES);
+			income.AddMoney(totalMoney);
+			income.AddHR(totalHR);
+			econMgr.CommitTransaction(income);
 			PrintFormat("[RBL] Resource tick: +%1 Money, +%2 HR", totalMoney, totalHR);
 		}
 	}
@@ -251,6 +254,25 @@ class RBL_CampaignManager : GenericEntity
 	void SetDayNumber(int day)
 	{
 		m_iDayNumber = day;
+		RBL_StateVersion.Bump();
+	}
+
+	// Client: mirror the server's war state without raising campaign events
+	// or bumping the state version
+	void SetWarStateLocal(int warLevel, int aggression, int day, bool active)
+	{
+		int previousLevel = m_iWarLevel;
+		int previousAggression = m_iAggression;
+
+		m_iWarLevel = Math.Clamp(warLevel, 1, 10);
+		m_iAggression = Math.Clamp(aggression, 0, 100);
+		m_iDayNumber = day;
+		m_bCampaignActive = active;
+
+		if (previousLevel != m_iWarLevel)
+			m_OnWarLevelChanged.Invoke(m_iWarLevel);
+		if (previousAggression != m_iAggression)
+			m_OnAggressionChanged.Invoke(m_iAggression);
 	}
 
 	void OnZoneCaptured(RBL_CampaignZone zone, ERBLFactionKey previousOwner, ERBLFactionKey newOwner)
@@ -0,0 +1,219 @@
+// ============================================================================
+// PROJECT REBELLION - Economy Ledger
+// Money and HR changes are built as transactions and committed through
+// RBL_EconomyManager in one step: one balance event, one state version bump
+// and one ledger entry per commit, however many deltas it carries
+// The ledger is a fixed ring of the latest commits, used for auditing and
+// for rolling back recent changes, with running totals per source
+// ============================================================================
+
+// Where a transaction's money and HR came from or went to
+class RBL_EconomySource
+{
+	static const string RESOURCES = "Resources";
+	static const string MISSION = "Mission";
+	static const string CAPTURE = "Capture";
+	static const string PURCHASE = "Purchase";
+	static const string REFUND = "Refund";
+	static const string RECRUIT = "Recruit";
+	static const string ROLLBACK = "Rollback";
+	static const string DEBUG = "Debug";
+	static const string OTHER = "Other";
+}
+
+class RBL_EconomyTransaction
+{
+	string Source;
+	string Note;
+	
+	// Requested deltas; negative values are spends
+	int Money;
+	int HR;
+	
+	// Filled in on commit. Applied deltas can be smaller than requested
+	// when a balance hits its cap
+	int Sequence;
+	float Time;
+	int AppliedMoney;
+	int AppliedHR;
+	int MoneyAfter;
+	int HRAfter;
+	bool RolledBack;
+	
+	// Spends must be covered by the current balance; when false the
+	// balance is clamped at zero instead of rejecting the commit
+	bool RequireFunds = true;
+	
+	void RBL_EconomyTransaction(string source, string note = "")
+	{
+		Source = source;
+		Note = note;
+	}
+	
+	void AddMoney(int amount) { Money += amount; }
+	void AddHR(int amount) { HR += amount; }
+	void SpendMoney(int amount) { Money -= amount; }
+	void SpendHR(int amount) { HR -= amount; }
+	
+	bool IsEmpty() { return Money == 0 && HR == 0; }
+	
+	string Format()
+	{
+		string line = string.Format("#%1 %2 $%3 %4 HR -> $%5, %6 HR", Sequence, Source, AppliedMoney, AppliedHR, MoneyAfter, HRAfter);
+		if (!Note.IsEmpty())
+			line += " (" + Note + ")";
+		if (RolledBack)
+			line += " [rolled back]";
+		return line;
+	}
+}
+
+// Running totals of one source, rolled-back commits included
+class RBL_EconomySourceStats
+{
+	string Source;
+	int Commits;
+	int MoneyIn;
+	int MoneyOut;
+	int HRIn;
+	int HROut;
+}
+
+class RBL_EconomyLedger
+{
+	protected ref array<ref RBL_EconomyTransaction> m_aEntries;
+	protected int m_iCapacity;
+	protected int m_iNext;
+	protected int m_iCount;
+	protected int m_iSequence;
+	
+	protected ref map<string, ref RBL_EconomySourceStats> m_mSources;
+	
+	void RBL_EconomyLedger(int capacity)
+	{
+		m_iCapacity = Math.Max(1, capacity);
+		m_aEntries = new array<ref RBL_EconomyTransaction>();
+		m_aEntries.Resize(m_iCapacity);
+		m_mSources = new map<string, ref RBL_EconomySourceStats>();
+	}
+	
+	// ========================================================================
+	// RECORDING
+	// ========================================================================
+	
+	// Stamp a committed transaction and keep it, dropping the oldest entry
+	// once the ring is full
+	void Append(RBL_EconomyTransaction transaction)
+	{
+		m_iSequence++;
+		transaction.Sequence = m_iSequence;
+		
+		m_aEntries[m_iNext] = transaction;
+		m_iNext = (m_iNext + 1) % m_iCapacity;
+		m_iCount = Math.Min(m_iCount + 1, m_iCapacity);
+		
+		RBL_EconomySourceStats stats = m_mSources.Get(transaction.Source);
+		if (!stats)
+		{
+			stats = new RBL_EconomySourceStats();
+			stats.Source = transaction.Source;
+			m_mSources.Set(transaction.Source, stats);
+		}
+		
+		stats.Commits++;
+		if (transaction.AppliedMoney > 0)
+			stats.MoneyIn += transaction.AppliedMoney;
+		else
+			stats.MoneyOut -= transaction.AppliedMoney;
+		if (transaction.AppliedHR > 0)
+			stats.HRIn += transaction.AppliedHR;
+		else
+			stats.HROut -= transaction.AppliedHR;
+	}
+	
+	void Clear()
+	{
+		for (int i = 0; i < m_iCapacity; i++)
+		{
+			m_aEntries[i] = null;
+		}
+		m_iNext = 0;
+		m_iCount = 0;
+		m_mSources.Clear();
+	}
+	
+	// ========================================================================
+	// QUERIES
+	// ========================================================================
+	
+	int GetCount() { return m_iCount; }
+	int GetCapacity() { return m_iCapacity; }
+	int GetLastSequence() { return m_iSequence; }
+	
+	// Entry by age: 0 is the latest commit
+	RBL_EconomyTransaction GetRecent(int age)
+	{
+		if (age < 0 || age >= m_iCount)
+			return null;
+		
+		int index = (m_iNext - 1 - age + m_iCapacity) % m_iCapacity;
+		return m_aEntries[index];
+	}
+	
+	RBL_EconomySourceStats GetSourceStats(string source)
+	{
+		return m_mSources.Get(source);
+	}
+	
+	map<string, ref RBL_EconomySourceStats> GetAllSourceStats()
+	{
+		return m_mSources;
+	}
+	
+	// ========================================================================
+	// OUTPUT
+	// ========================================================================
+	
+	void PrintRecent(int count)
+	{
+		count = Math.Min(count, m_iCount);
+		PrintFormat("[RBL_Ledger] === LAST %1 OF %2 COMMITS ===", count, m_iSequence);
+		for (int age = count - 1; age >= 0; age--)
+		{
+			PrintFormat("  %1", GetRecent(age).Format());
+		}
+	}
+	
+	void PrintSources()
+	{
+		PrintFormat("[RBL_Ledger] === INCOME AND SPEND BY SOURCE ===");
+		for (int i = 0; i < m_mSources.Count(); i++)
+		{
+			RBL_EconomySourceStats stats = m_mSources.GetElement(i);
+			PrintFormat("  %1: %2 commits | money +%3 / -%4 | HR +%5 / -%6",
+				stats.Source, stats.Commits, stats.MoneyIn, stats.MoneyOut, stats.HRIn, stats.HROut);
+		}
+	}
+}
+
+// ============================================================================
+// DEBUG COMMANDS
+// ============================================================================
+class RBL_EconomyLedgerCommands
+{
+	static void PrintLedger(int count = 20)
+	{
+		RBL_EconomyManager.GetInstance().GetLedger().PrintRecent(count);
+	}
+	
+	static void PrintSources()
+	{
+		RBL_EconomyManager.GetInstance().GetLedger().PrintSources();
+	}
+	
+	static void Rollback(int count = 1)
+	{
+		int reverted = RBL_EconomyManager.GetInstance().RollbackTransactions(count);
+		PrintFormat("[RBL_Ledger] Rolled back %1 commits", reverted);
+	}
+}
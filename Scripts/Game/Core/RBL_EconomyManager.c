@@ -10,6 +10,10 @@ class RBL_EconomyManager
 	// Using RBL_Config constant for maintainability
 	protected const int MAX_MONEY = 999999;
 	protected const int MAX_HR = 9999;
+	
+	// Longest a confirmed purchase stays reserved while waiting for the
+	// replicated balance to show its charge
+	protected const float CONFIRMED_HOLD_SECONDS = 5.0;
 
 	protected int m_iMoney;
 	protected int m_iHumanResources;
@@ -22,18 +26,30 @@ class RBL_EconomyManager
 	protected int m_iTotalItemsBought;
 	protected int m_iTotalItemsSold;
 
-	protected ref map<string, int> m_mArsenalInventory;
-	protected ref set<string> m_sUnlockedItems;
+	// Arsenal stock and unlock flags, indexed by RBL_ItemRegistry handle
+	protected ref array<int> m_aArsenalCounts;
+	protected ref array<bool> m_aUnlocked;
 	protected ref map<int, int> m_mPlayerMoney;
 	protected ref map<int, int> m_mPlayerHR;
 
-	protected ref ScriptInvoker m_OnMoneyChanged;
-	protected ref ScriptInvoker m_OnHRChanged;
+	// Fired once per commit or balance overwrite with (money, hr)
+	protected ref ScriptInvoker m_OnBalanceChanged;
 	protected ref ScriptInvoker m_OnItemDeposited;
+	protected ref ScriptInvoker m_OnItemWithdrawn;
 	protected ref ScriptInvoker m_OnItemUnlocked;
+	protected ref ScriptInvoker m_OnPendingChanged;
+	
+	// Client-side prediction: costs of purchases sent to the server and not
+	// yet in the replicated balance, keyed by request ID. Shown as already spent
+	protected ref map<int, ref RBL_PendingTransaction> m_mPendingTransactions;
+	protected int m_iPendingMoney;
+	protected int m_iPendingHR;
 	
 	// Network: flag to allow local-only updates without authority check
 	protected bool m_bAllowLocalUpdate;
+	
+	// Server: latest committed transactions and per-source totals
+	protected ref RBL_EconomyLedger m_Ledger;
 
 	static RBL_EconomyManager GetInstance()
 	{
@@ -44,15 +60,21 @@ class RBL_EconomyManager
 
 	void RBL_EconomyManager()
 	{
-		m_mArsenalInventory = new map<string, int>();
-		m_sUnlockedItems = new set<string>();
+		m_aArsenalCounts = new array<int>();
+		m_aUnlocked = new array<bool>();
 		m_mPlayerMoney = new map<int, int>();
 		m_mPlayerHR = new map<int, int>();
 
-		m_OnMoneyChanged = new ScriptInvoker();
-		m_OnHRChanged = new ScriptInvoker();
+		m_OnBalanceChanged = new ScriptInvoker();
 		m_OnItemDeposited = new ScriptInvoker();
+		m_OnItemWithdrawn = new ScriptInvoker();
 		m_OnItemUnlocked = new ScriptInvoker();
+		m_OnPendingChanged = new ScriptInvoker();
+		
+		m_mPendingTransactions = new map<int, ref RBL_PendingTransaction>();
+		m_Ledger = new RBL_EconomyLedger(RBL_Config.ECONOMY_LEDGER_CAPACITY);
+		m_iPendingMoney = 0;
+		m_iPendingHR = 0;
 
 		m_iMoney = 0;
 		m_iHumanResources = 0;
@@ -84,56 +106,173 @@ class RBL_EconomyManager
 		m_bAllowLocalUpdate = allow;
 	}
 
-	void SetMoney(int amount)
+	// ========================================================================
+	// TRANSACTIONS
+	// ========================================================================
+	
+	// Start collecting deltas; nothing changes until CommitTransaction
+	RBL_EconomyTransaction BeginTransaction(string source, string note = "")
 	{
+		return new RBL_EconomyTransaction(source, note);
+	}
+	
+	// Apply every delta of the transaction at once. Fails without changing
+	// anything when a required spend is not covered
+	bool CommitTransaction(RBL_EconomyTransaction transaction)
+	{
+		if (!transaction)
+			return false;
+		
 		if (!CanModifyState())
 		{
-			PrintFormat("[RBL_Economy] SetMoney blocked - not server");
-			return;
+			PrintFormat("[RBL_Economy] Commit blocked - not server (%1)", transaction.Source);
+			return false;
 		}
 		
-		int previous = m_iMoney;
-		m_iMoney = Math.Clamp(amount, 0, MAX_MONEY);
-
-		if (previous != m_iMoney)
-			m_OnMoneyChanged.Invoke(m_iMoney);
+		if (transaction.IsEmpty())
+			return true;
+		
+		if (transaction.RequireFunds)
+		{
+			if (m_iMoney + transaction.Money < 0)
+			{
+				PrintFormat("[RBL_Economy] %1 rejected: Not enough money ($%2 < $%3)", transaction.Source, m_iMoney, -transaction.Money);
+				return false;
+			}
+			
+			if (m_iHumanResources + transaction.HR < 0)
+			{
+				PrintFormat("[RBL_Economy] %1 rejected: Not enough HR (%2 < %3)", transaction.Source, m_iHumanResources, -transaction.HR);
+				return false;
+			}
+		}
+		
+		int previousMoney = m_iMoney;
+		int previousHR = m_iHumanResources;
+		ApplyBalance(m_iMoney + transaction.Money, m_iHumanResources + transaction.HR);
+		
+		transaction.AppliedMoney = m_iMoney - previousMoney;
+		transaction.AppliedHR = m_iHumanResources - previousHR;
+		transaction.MoneyAfter = m_iMoney;
+		transaction.HRAfter = m_iHumanResources;
+		transaction.Time = GetGame().GetWorld().GetWorldTime() / 1000.0;
+		
+		// Refunds and rollbacks take earlier commits back out of the totals
+		bool undo = transaction.Source == RBL_EconomySource.REFUND || transaction.Source == RBL_EconomySource.ROLLBACK;
+		if (undo && transaction.AppliedMoney > 0)
+			m_iTotalMoneySpent = Math.Max(0, m_iTotalMoneySpent - transaction.AppliedMoney);
+		else if (undo)
+			m_iTotalMoneyEarned = Math.Max(0, m_iTotalMoneyEarned + transaction.AppliedMoney);
+		else if (transaction.AppliedMoney > 0)
+			m_iTotalMoneyEarned += transaction.AppliedMoney;
+		else
+			m_iTotalMoneySpent -= transaction.AppliedMoney;
+		
+		m_Ledger.Append(transaction);
+		return true;
 	}
 	
-	void SetMoneyLocal(int amount)
+	// Undo the latest commits that have not been undone yet with a single
+	// compensating commit; balances are clamped at zero rather than refused
+	int RollbackTransactions(int count)
 	{
-		int previous = m_iMoney;
-		m_iMoney = Math.Clamp(amount, 0, MAX_MONEY);
+		if (!CanModifyState())
+			return 0;
 		
-		if (previous != m_iMoney)
-			m_OnMoneyChanged.Invoke(m_iMoney);
+		RBL_EconomyTransaction reversal = BeginTransaction(RBL_EconomySource.ROLLBACK);
+		reversal.RequireFunds = false;
+		
+		array<RBL_EconomyTransaction> reverted = new array<RBL_EconomyTransaction>();
+		for (int age = 0; age < m_Ledger.GetCount() && reverted.Count() < count; age++)
+		{
+			RBL_EconomyTransaction entry = m_Ledger.GetRecent(age);
+			if (entry.RolledBack || entry.Source == RBL_EconomySource.ROLLBACK)
+				continue;
+			
+			reversal.Money -= entry.AppliedMoney;
+			reversal.HR -= entry.AppliedHR;
+			reverted.Insert(entry);
+		}
+		
+		if (reverted.IsEmpty())
+			return 0;
+		
+		reversal.Note = "#" + reverted[reverted.Count() - 1].Sequence.ToString() + "-#" + reverted[0].Sequence.ToString();
+		if (!CommitTransaction(reversal))
+			return 0;
+		
+		foreach (RBL_EconomyTransaction undone : reverted)
+		{
+			undone.RolledBack = true;
+		}
+		return reverted.Count();
 	}
-
-	void AddMoney(int amount)
+	
+	RBL_EconomyLedger GetLedger() { return m_Ledger; }
+	
+	// ========================================================================
+	// BALANCES
+	// ========================================================================
+	
+	// Clamp and store both balances; one version bump and one event if
+	// either changed
+	protected void ApplyBalance(int money, int hr)
+	{
+		int previousMoney = m_iMoney;
+		int previousHR = m_iHumanResources;
+		m_iMoney = Math.Clamp(money, 0, MAX_MONEY);
+		m_iHumanResources = Math.Clamp(hr, 0, MAX_HR);
+		
+		if (previousMoney == m_iMoney && previousHR == m_iHumanResources)
+			return;
+		
+		RBL_StateVersion.Bump();
+		m_OnBalanceChanged.Invoke(m_iMoney, m_iHumanResources);
+		
+		if (!m_mPendingTransactions.IsEmpty())
+			SettlePending();
+	}
+	
+	// Overwrite both balances (init, load, replication); not a transaction,
+	// so nothing is added to the ledger or the trade totals
+	void SetBalance(int money, int hr)
 	{
 		if (!CanModifyState())
 		{
-			PrintFormat("[RBL_Economy] AddMoney blocked - not server");
+			PrintFormat("[RBL_Economy] SetBalance blocked - not server");
 			return;
 		}
-		SetMoney(m_iMoney + amount);
-		if (amount > 0)
-			m_iTotalMoneyEarned += amount;
+		ApplyBalance(money, hr);
 	}
-
-	bool SpendMoney(int amount)
+	
+	void SetMoney(int amount)
 	{
 		if (!CanModifyState())
 		{
-			PrintFormat("[RBL_Economy] SpendMoney blocked - not server");
-			return false;
+			PrintFormat("[RBL_Economy] SetMoney blocked - not server");
+			return;
 		}
-		
-		if (m_iMoney < amount)
-			return false;
+		ApplyBalance(amount, m_iHumanResources);
+	}
+	
+	void SetMoneyLocal(int amount)
+	{
+		ApplyBalance(amount, m_iHumanResources);
+	}
 
-		SetMoney(m_iMoney - amount);
-		m_iTotalMoneySpent += amount;
-		return true;
+	void AddMoney(int amount, string source = RBL_EconomySource.OTHER)
+	{
+		RBL_EconomyTransaction transaction = BeginTransaction(source);
+		transaction.AddMoney(amount);
+		transaction.RequireFunds = false;
+		CommitTransaction(transaction);
+	}
+
+	bool SpendMoney(int amount, string source = RBL_EconomySource.PURCHASE)
+	{
+		RBL_EconomyTransaction transaction = BeginTransaction(source);
+		transaction.SpendMoney(amount);
+		return CommitTransaction(transaction);
 	}
 
 	int GetMoney() { return m_iMoney; }
@@ -147,46 +286,27 @@ class RBL_EconomyManager
 			PrintFormat("[RBL_Economy] SetHR blocked - not server");
 			return;
 		}
-		
-		int previous = m_iHumanResources;
-		m_iHumanResources = Math.Clamp(amount, 0, MAX_HR);
-
-		if (previous != m_iHumanResources)
-			m_OnHRChanged.Invoke(m_iHumanResources);
+		ApplyBalance(m_iMoney, amount);
 	}
 	
 	void SetHRLocal(int amount)
 	{
-		int previous = m_iHumanResources;
-		m_iHumanResources = Math.Clamp(amount, 0, MAX_HR);
-		
-		if (previous != m_iHumanResources)
-			m_OnHRChanged.Invoke(m_iHumanResources);
+		ApplyBalance(m_iMoney, amount);
 	}
 
-	void AddHR(int amount)
+	void AddHR(int amount, string source = RBL_EconomySource.OTHER)
 	{
-		if (!CanModifyState())
-		{
-			PrintFormat("[RBL_Economy] AddHR blocked - not server");
-			return;
-		}
-		SetHR(m_iHumanResources + amount);
+		RBL_EconomyTransaction transaction = BeginTransaction(source);
+		transaction.AddHR(amount);
+		transaction.RequireFunds = false;
+		CommitTransaction(transaction);
 	}
 
-	bool SpendHR(int amount)
+	bool SpendHR(int amount, string source = RBL_EconomySource.PURCHASE)
 	{
-		if (!CanModifyState())
-		{
-			PrintFormat("[RBL_Economy] SpendHR blocked - not server");
-			return false;
-		}
-		
-		if (m_iHumanResources < amount)
-			return false;
-
-		SetHR(m_iHumanResources - amount);
-		return true;
+		RBL_EconomyTransaction transaction = BeginTransaction(source);
+		transaction.SpendHR(amount);
+		return CommitTransaction(transaction);
 	}
 
 	int GetHR() { return m_iHumanResources; }
@@ -253,88 +373,152 @@ class RBL_EconomyManager
 		m_mPlayerHR.Set(playerId, Math.Max(0, amount));
 	}
 
+	// ========================================================================
+	// ARSENAL
+	// ========================================================================
+	
+	// Grow the dense arrays to cover every item registered so far
+	protected void EnsureArsenalCapacity(int handle)
+	{
+		int previous = m_aArsenalCounts.Count();
+		if (handle < previous)
+			return;
+		
+		int size = Math.Max(handle + 1, RBL_ItemRegistry.GetInstance().GetCount());
+		m_aArsenalCounts.Resize(size);
+		m_aUnlocked.Resize(size);
+		for (int i = previous; i < size; i++)
+		{
+			m_aArsenalCounts[i] = 0;
+			m_aUnlocked[i] = false;
+		}
+	}
+	
+	protected int InternItem(string itemID)
+	{
+		int handle = RBL_ItemRegistry.GetInstance().Intern(itemID);
+		if (handle != RBL_ItemRegistry.INVALID_HANDLE)
+			EnsureArsenalCapacity(handle);
+		return handle;
+	}
+	
 	void DepositItem(string itemPrefab, int count)
 	{
-		int currentCount = 0;
-		m_mArsenalInventory.Find(itemPrefab, currentCount);
-
-		int newCount = currentCount + count;
-		m_mArsenalInventory.Set(itemPrefab, newCount);
-
-		m_OnItemDeposited.Invoke(itemPrefab, newCount);
-
-		if (newCount >= RBL_Config.ARSENAL_UNLOCK_THRESHOLD && !m_sUnlockedItems.Contains(itemPrefab))
+		DepositItemByHandle(InternItem(itemPrefab), count);
+	}
+	
+	void DepositItemByHandle(int handle, int count)
+	{
+		if (handle < 0)
+			return;
+		
+		EnsureArsenalCapacity(handle);
+		int newCount = m_aArsenalCounts[handle] + count;
+		m_aArsenalCounts[handle] = newCount;
+		RBL_StateVersion.Bump();
+		
+		string itemID = RBL_ItemRegistry.GetInstance().GetID(handle);
+		m_OnItemDeposited.Invoke(itemID, newCount);
+		
+		if (newCount >= RBL_Config.ARSENAL_UNLOCK_THRESHOLD && !m_aUnlocked[handle])
 		{
-			m_sUnlockedItems.Insert(itemPrefab);
-			PrintFormat("[RBL_Economy] Item UNLOCKED: %1", itemPrefab);
-			m_OnItemUnlocked.Invoke(itemPrefab);
+			m_aUnlocked[handle] = true;
+			PrintFormat("[RBL_Economy] Item UNLOCKED: %1", itemID);
+			m_OnItemUnlocked.Invoke(itemID);
 		}
-
-		PrintFormat("[RBL_Economy] Deposited %1 x%2 (Total: %3)", itemPrefab, count, newCount);
+		
+		PrintFormat("[RBL_Economy] Deposited %1 x%2 (Total: %3)", itemID, count, newCount);
 	}
-
+	
 	bool WithdrawItem(string itemPrefab, int count)
 	{
-		if (m_sUnlockedItems.Contains(itemPrefab))
-			return true;
-
-		int currentCount = 0;
-		if (!m_mArsenalInventory.Find(itemPrefab, currentCount))
+		return WithdrawItemByHandle(RBL_ItemRegistry.GetInstance().Find(itemPrefab), count);
+	}
+	
+	bool WithdrawItemByHandle(int handle, int count)
+	{
+		if (handle < 0 || handle >= m_aArsenalCounts.Count())
 			return false;
-
+		
+		if (m_aUnlocked[handle])
+			return true;
+		
+		int currentCount = m_aArsenalCounts[handle];
 		if (currentCount < count)
 			return false;
-
+		
 		int newCount = currentCount - count;
-		m_mArsenalInventory.Set(itemPrefab, newCount);
-
+		m_aArsenalCounts[handle] = newCount;
+		RBL_StateVersion.Bump();
+		
+		m_OnItemWithdrawn.Invoke(RBL_ItemRegistry.GetInstance().GetID(handle), newCount);
+		
 		return true;
 	}
-
+	
 	int GetItemCount(string itemPrefab)
 	{
-		int count = 0;
-		m_mArsenalInventory.Find(itemPrefab, count);
-		return count;
+		return GetItemCountByHandle(RBL_ItemRegistry.GetInstance().Find(itemPrefab));
 	}
-
+	
+	int GetItemCountByHandle(int handle)
+	{
+		if (handle < 0 || handle >= m_aArsenalCounts.Count())
+			return 0;
+		return m_aArsenalCounts[handle];
+	}
+	
+	bool IsItemUnlockedByHandle(int handle)
+	{
+		if (handle < 0 || handle >= m_aUnlocked.Count())
+			return false;
+		return m_aUnlocked[handle];
+	}
+	
 	ERBLItemAvailability GetItemAvailability(string itemPrefab)
 	{
-		if (m_sUnlockedItems.Contains(itemPrefab))
+		int handle = RBL_ItemRegistry.GetInstance().Find(itemPrefab);
+		if (IsItemUnlockedByHandle(handle))
 			return ERBLItemAvailability.UNLIMITED;
-
-		int count = GetItemCount(itemPrefab);
-		if (count > 0)
+		
+		if (GetItemCountByHandle(handle) > 0)
 			return ERBLItemAvailability.LIMITED;
-
+		
 		return ERBLItemAvailability.LOCKED;
 	}
-
-	bool IsItemUnlocked(string itemPrefab) { return m_sUnlockedItems.Contains(itemPrefab); }
-
+	
+	bool IsItemUnlocked(string itemPrefab)
+	{
+		return IsItemUnlockedByHandle(RBL_ItemRegistry.GetInstance().Find(itemPrefab));
+	}
+	
 	bool IsItemAvailable(string itemPrefab)
 	{
-		if (m_sUnlockedItems.Contains(itemPrefab))
-			return true;
-		if (GetItemCount(itemPrefab) > 0)
-			return true;
-		return false;
+		return GetItemAvailability(itemPrefab) != ERBLItemAvailability.LOCKED;
 	}
-
+	
 	void SetArsenalItemCount(string itemPrefab, int count)
 	{
-		m_mArsenalInventory.Set(itemPrefab, count);
-
+		int handle = InternItem(itemPrefab);
+		if (handle < 0)
+			return;
+		
+		m_aArsenalCounts[handle] = count;
+		RBL_StateVersion.Bump();
+		
 		if (count >= RBL_Config.ARSENAL_UNLOCK_THRESHOLD)
-			m_sUnlockedItems.Insert(itemPrefab);
+			m_aUnlocked[handle] = true;
 	}
 	
+	// IDs of items currently in stock
 	array<string> GetArsenalItemIDs()
 	{
+		RBL_ItemRegistry registry = RBL_ItemRegistry.GetInstance();
 		array<string> keys = new array<string>();
-		for (int i = 0; i < m_mArsenalInventory.Count(); i++)
+		for (int handle = 0; handle < m_aArsenalCounts.Count(); handle++)
 		{
-			keys.Insert(m_mArsenalInventory.GetKey(i));
+			if (m_aArsenalCounts[handle] > 0)
+				keys.Insert(registry.GetID(handle));
 		}
 		return keys;
 	}
@@ -346,17 +530,45 @@ class RBL_EconomyManager
 	
 	array<string> GetUnlockedItems()
 	{
+		RBL_ItemRegistry registry = RBL_ItemRegistry.GetInstance();
 		array<string> items = new array<string>();
-		foreach (string item : m_sUnlockedItems)
+		for (int handle = 0; handle < m_aUnlocked.Count(); handle++)
 		{
-			items.Insert(item);
+			if (m_aUnlocked[handle])
+				items.Insert(registry.GetID(handle));
 		}
 		return items;
 	}
 	
+	int GetStockedItemCount()
+	{
+		int stocked = 0;
+		foreach (int count : m_aArsenalCounts)
+		{
+			if (count > 0)
+				stocked++;
+		}
+		return stocked;
+	}
+	
+	int GetUnlockedItemCount()
+	{
+		int unlocked = 0;
+		foreach (bool flag : m_aUnlocked)
+		{
+			if (flag)
+				unlocked++;
+		}
+		return unlocked;
+	}
+	
 	void ClearArsenal()
 	{
-		m_mArsenalInventory.Clear();
+		for (int handle = 0; handle < m_aArsenalCounts.Count(); handle++)
+		{
+			m_aArsenalCounts[handle] = 0;
+		}
+		RBL_StateVersion.Bump();
 	}
 	
 	void AddToArsenal(string itemID, int quantity)
@@ -368,19 +580,86 @@ class RBL_EconomyManager
 	
 	void ClearUnlocks()
 	{
-		m_sUnlockedItems.Clear();
+		for (int handle = 0; handle < m_aUnlocked.Count(); handle++)
+		{
+			m_aUnlocked[handle] = false;
+		}
+		RBL_StateVersion.Bump();
 	}
 	
 	void UnlockItem(string itemID)
 	{
-		if (itemID.IsEmpty())
+		int handle = InternItem(itemID);
+		if (handle < 0 || m_aUnlocked[handle])
 			return;
 		
-		if (!m_sUnlockedItems.Contains(itemID))
+		m_aUnlocked[handle] = true;
+		RBL_StateVersion.Bump();
+		m_OnItemUnlocked.Invoke(RBL_ItemRegistry.GetInstance().GetID(handle));
+	}
+	
+	// ========================================================================
+	// ARSENAL BULK TRANSFER
+	// ========================================================================
+	
+	// Every stocked item and its count in one pass over the arrays
+	void ExportArsenal(array<string> outItemIDs, array<int> outCounts)
+	{
+		outItemIDs.Clear();
+		outCounts.Clear();
+		
+		RBL_ItemRegistry registry = RBL_ItemRegistry.GetInstance();
+		for (int handle = 0; handle < m_aArsenalCounts.Count(); handle++)
 		{
-			m_sUnlockedItems.Insert(itemID);
-			m_OnItemUnlocked.Invoke(itemID);
+			int count = m_aArsenalCounts[handle];
+			if (count <= 0)
+				continue;
+			
+			outItemIDs.Insert(registry.GetID(handle));
+			outCounts.Insert(count);
+		}
+	}
+	
+	// Replace the whole arsenal without per-item events; IDs differing only
+	// in case are merged. Items at the threshold unlock as when deposited
+	void ImportArsenal(array<string> itemIDs, array<int> counts)
+	{
+		for (int handle = 0; handle < m_aArsenalCounts.Count(); handle++)
+		{
+			m_aArsenalCounts[handle] = 0;
+		}
+		
+		int entries = Math.Min(itemIDs.Count(), counts.Count());
+		for (int i = 0; i < entries; i++)
+		{
+			int itemHandle = InternItem(itemIDs[i]);
+			if (itemHandle < 0 || counts[i] <= 0)
+				continue;
+			
+			m_aArsenalCounts[itemHandle] = m_aArsenalCounts[itemHandle] + counts[i];
+			if (m_aArsenalCounts[itemHandle] >= RBL_Config.ARSENAL_UNLOCK_THRESHOLD)
+				m_aUnlocked[itemHandle] = true;
 		}
+		
+		RBL_StateVersion.Bump();
+	}
+	
+	// Replace every unlock flag without per-item events
+	void ImportUnlocks(array<string> itemIDs)
+	{
+		for (int handle = 0; handle < m_aUnlocked.Count(); handle++)
+		{
+			m_aUnlocked[handle] = false;
+		}
+		
+		foreach (string itemID : itemIDs)
+		{
+			int itemHandle = InternItem(itemID);
+			if (itemHandle >= 0)
+				m_aUnlocked[itemHandle] = true;
+		}
+		
+		RBL_StateVersion.Bump();
 	}
 	
 	void RecalculateIncome()
@@ -388,12 +667,11 @@ class RBL_EconomyManager
 		// Placeholder for future income recalculation logic.
 	}
 
-	map<string, int> GetArsenalInventory() { return m_mArsenalInventory; }
-
-	ScriptInvoker GetOnMoneyChanged() { return m_OnMoneyChanged; }
-	ScriptInvoker GetOnHRChanged() { return m_OnHRChanged; }
+	ScriptInvoker GetOnBalanceChanged() { return m_OnBalanceChanged; }
 	ScriptInvoker GetOnItemDeposited() { return m_OnItemDeposited; }
+	ScriptInvoker GetOnItemWithdrawn() { return m_OnItemWithdrawn; }
 	ScriptInvoker GetOnItemUnlocked() { return m_OnItemUnlocked; }
+	ScriptInvoker GetOnPendingChanged() { return m_OnPendingChanged; }
 
 	int GetVehiclePrice(string vehiclePrefab)
 	{
@@ -418,12 +696,10 @@ class RBL_EconomyManager
 
 	bool RecruitUnit(int hrCost, int moneyCost)
 	{
-		if (m_iHumanResources < hrCost || m_iMoney < moneyCost)
-			return false;
-
-		SpendHR(hrCost);
-		SpendMoney(moneyCost);
-		return true;
+		RBL_EconomyTransaction transaction = BeginTransaction(RBL_EconomySource.RECRUIT);
+		transaction.SpendMoney(moneyCost);
+		transaction.SpendHR(hrCost);
+		return CommitTransaction(transaction);
 	}
 
 	bool TryPurchase(string itemID, int moneyCost, int hrCost)
@@ -434,21 +710,11 @@ class RBL_EconomyManager
 			return false;
 		}
 		
-		if (m_iMoney < moneyCost)
-		{
-			PrintFormat("[RBL_Economy] TryPurchase failed: Not enough money ($%1 < $%2)", m_iMoney, moneyCost);
-			return false;
-		}
-		
-		if (m_iHumanResources < hrCost)
-		{
-			PrintFormat("[RBL_Economy] TryPurchase failed: Not enough HR (%1 < %2)", m_iHumanResources, hrCost);
+		RBL_EconomyTransaction transaction = BeginTransaction(RBL_EconomySource.PURCHASE, itemID);
+		transaction.SpendMoney(moneyCost);
+		transaction.SpendHR(hrCost);
+		if (!CommitTransaction(transaction))
 			return false;
-		}
-		
-		SpendMoney(moneyCost);
-		if (hrCost > 0)
-			SpendHR(hrCost);
 		
 		PrintFormat("[RBL_Economy] Purchase successful: %1 ($%2, %3 HR)", itemID, moneyCost, hrCost);
 		return true;
@@ -458,10 +724,7 @@ class RBL_EconomyManager
 	{
 		RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
 		if (netMgr)
-		{
-			int playerID = RBL_NetworkUtils.GetLocalPlayerID();
-			netMgr.RequestPurchase(playerID, itemID, moneyCost, hrCost);
-		}
+			netMgr.RequestPurchase(itemID);
 		else if (RBL_NetworkUtils.IsSinglePlayer())
 		{
 			TryPurchase(itemID, moneyCost, hrCost);
@@ -473,18 +736,111 @@ class RBL_EconomyManager
 		return (m_iMoney >= moneyCost) && (m_iHumanResources >= hrCost);
 	}
 
+	// Return a purchase's cost after its delivery failed
+	void RefundPurchase(int moneyCost, int hrCost, string note = "")
+	{
+		RBL_EconomyTransaction transaction = BeginTransaction(RBL_EconomySource.REFUND, note);
+		transaction.AddMoney(moneyCost);
+		transaction.AddHR(hrCost);
+		CommitTransaction(transaction);
+	}
+
 	void PrintEconomyStatus()
 	{
 		PrintFormat("[RBL_Economy] === ECONOMY STATUS ===");
 		PrintFormat("Money: $%1", m_iMoney);
 		PrintFormat("Human Resources: %1", m_iHumanResources);
-		PrintFormat("Arsenal Items: %1", m_mArsenalInventory.Count());
-		PrintFormat("Unlocked Items: %1", m_sUnlockedItems.Count());
+		PrintFormat("Ledger: %1 of %2 commits kept", m_Ledger.GetCount(), m_Ledger.GetLastSequence());
+		PrintFormat("Arsenal Items: %1", GetStockedItemCount());
+		PrintFormat("Unlocked Items: %1", GetUnlockedItemCount());
 		PrintFormat("Is Server: %1", RBL_NetworkUtils.IsServer());
 		PrintFormat("Is Singleplayer: %1", RBL_NetworkUtils.IsSinglePlayer());
 		PrintFormat("Can Modify: %1", CanModifyState());
 	}
 	
+	// ========================================================================
+	// PREDICTED TRANSACTIONS
+	// ========================================================================
+	
+	// Reserve a purchase's cost until the server answers the request
+	void ReservePending(int requestID, int moneyCost, int hrCost)
+	{
+		RBL_PendingTransaction transaction = new RBL_PendingTransaction();
+		transaction.Money = moneyCost;
+		transaction.HR = hrCost;
+		m_mPendingTransactions.Set(requestID, transaction);
+		
+		m_iPendingMoney += moneyCost;
+		m_iPendingHR += hrCost;
+		m_OnPendingChanged.Invoke(m_iPendingMoney, m_iPendingHR);
+	}
+	
+	// Settle a request with the server's answer. A rejection drops the
+	// reservation at once; a confirmed purchase keeps it until the
+	// replicated balance reaches the server's post-purchase balance, so the
+	// shown balance never bounces back to its pre-purchase value
+	void ResolvePending(int requestID, bool success, int moneyAfter, int hrAfter)
+	{
+		RBL_PendingTransaction transaction = m_mPendingTransactions.Get(requestID);
+		if (!transaction)
+			return;
+		
+		if (!success || moneyAfter < 0 || hrAfter < 0)
+		{
+			ReleasePending(requestID, transaction);
+			return;
+		}
+		
+		transaction.Confirmed = true;
+		transaction.MoneyAfter = moneyAfter;
+		transaction.HRAfter = hrAfter;
+		transaction.ConfirmedTime = GetGame().GetWorld().GetWorldTime() / 1000.0;
+		SettlePending();
+	}
+	
+	// Release confirmed reservations the replicated balance now carries, or
+	// that have waited too long because other changes moved the balance past
+	// the server's figures
+	void SettlePending()
+	{
+		if (m_mPendingTransactions.IsEmpty())
+			return;
+		
+		float now = GetGame().GetWorld().GetWorldTime() / 1000.0;
+		array<int> settled = new array<int>();
+		foreach (int requestID, RBL_PendingTransaction transaction : m_mPendingTransactions)
+		{
+			if (!transaction.Confirmed)
+				continue;
+			
+			bool replicated = m_iMoney == transaction.MoneyAfter && m_iHumanResources == transaction.HRAfter;
+			if (replicated || now - transaction.ConfirmedTime >= CONFIRMED_HOLD_SECONDS)
+				settled.Insert(requestID);
+		}
+		
+		foreach (int settledID : settled)
+		{
+			ReleasePending(settledID, m_mPendingTransactions.Get(settledID));
+		}
+	}
+	
+	protected void ReleasePending(int requestID, RBL_PendingTransaction transaction)
+	{
+		m_mPendingTransactions.Remove(requestID);
+		m_iPendingMoney -= transaction.Money;
+		m_iPendingHR -= transaction.HR;
+		m_OnPendingChanged.Invoke(m_iPendingMoney, m_iPendingHR);
+	}
+	
+	// Balances with pending purchases already taken off; what the UI shows
+	// and what new purchases are checked against
+	int GetAvailableMoney() { return Math.Max(0, m_iMoney - m_iPendingMoney); }
+	int GetAvailableHR() { return Math.Max(0, m_iHumanResources - m_iPendingHR); }
+	
+	int GetPendingMoney() { return m_iPendingMoney; }
+	int GetPendingHR() { return m_iPendingHR; }
+	bool HasPendingTransactions() { return !m_mPendingTransactions.IsEmpty(); }
+	
 	// ========================================================================
 	// NETWORK SERIALIZATION
 	// ========================================================================
@@ -497,24 +853,22 @@ class RBL_EconomyManager
 	
 	void DeserializeFromNetwork(int money, int hr)
 	{
-		m_bAllowLocalUpdate = true;
-		SetMoneyLocal(money);
-		SetHRLocal(hr);
-		m_bAllowLocalUpdate = false;
+		ApplyBalance(money, hr);
 	}
 	
 	string SerializeArsenalToString()
 	{
+		array<string> itemIDs = new array<string>();
+		array<int> counts = new array<int>();
+		ExportArsenal(itemIDs, counts);
+		
 		string result = "";
-		for (int i = 0; i < m_mArsenalInventory.Count(); i++)
+		for (int i = 0; i < itemIDs.Count(); i++)
 		{
-			string key = m_mArsenalInventory.GetKey(i);
-			int count = m_mArsenalInventory.Get(key);
-			
-			if (result.Length() > 0)
+			if (i > 0)
 				result += ";";
 			
-			result += key + ":" + count.ToString();
+			result += itemIDs[i] + ":" + counts[i].ToString();
 		}
 		
 		return result;
@@ -522,13 +876,11 @@ class RBL_EconomyManager
 	
 	void DeserializeArsenalFromString(string data)
 	{
-		m_mArsenalInventory.Clear();
-		
-		if (data.IsEmpty())
-			return;
+		array<string> itemIDs = new array<string>();
+		array<int> counts = new array<int>();
 		
 		array<string> entries = new array<string>();
-		data.Split(";", entries, false);
+		data.Split(";", entries, true);
 		
 		for (int i = 0; i < entries.Count(); i++)
 		{
@@ -538,10 +890,24 @@ class RBL_EconomyManager
 			if (parts.Count() != 2)
 				continue;
 			
-			string itemID = parts[0];
-			int count = parts[1].ToInt();
-			
-			m_mArsenalInventory.Set(itemID, count);
+			itemIDs.Insert(parts[0]);
+			counts.Insert(parts[1].ToInt());
 		}
+		
+		ImportArsenal(itemIDs, counts);
 	}
 }
+
+// Cost reserved for a purchase awaiting the server's answer, then for
+// the replicated balance to catch up with it
+class RBL_PendingTransaction
+{
+	int Money;
+	int HR;
+	
+	// Set once the server confirms; the balances it reported and when
+	bool Confirmed;
+	int MoneyAfter;
+	int HRAfter;
+	float ConfirmedTime;
+}
@@ -0,0 +1,79 @@
+// ============================================================================
+// PROJECT REBELLION - Item Registry
+// Interns item IDs to dense integer handles so per-item state (arsenal
+// counts, unlocks) can live in flat arrays indexed by handle
+// IDs are compared case-insensitively: "AK74" and "ak74" are the same item
+// The shop catalog is registered when the shop builds its lookups; IDs from
+// older saves or scripts outside the catalog are interned on first use
+// ============================================================================
+
+class RBL_ItemRegistry
+{
+	static const int INVALID_HANDLE = -1;
+	
+	protected static ref RBL_ItemRegistry s_Instance;
+	
+	// Normalised ID -> handle, and handle -> normalised ID
+	protected ref map<string, int> m_mHandles;
+	protected ref array<string> m_aIDs;
+	
+	static RBL_ItemRegistry GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new RBL_ItemRegistry();
+		return s_Instance;
+	}
+	
+	void RBL_ItemRegistry()
+	{
+		m_mHandles = new map<string, int>();
+		m_aIDs = new array<string>();
+	}
+	
+	// Canonical spelling used for lookups, events and saves
+	static string Normalize(string itemID)
+	{
+		string normalized = itemID.Trim();
+		normalized.ToLower();
+		return normalized;
+	}
+	
+	// ========================================================================
+	// INTERNING
+	// ========================================================================
+	
+	// Handle of the item, registering it if it is new
+	int Intern(string itemID)
+	{
+		string normalized = Normalize(itemID);
+		if (normalized.IsEmpty())
+			return INVALID_HANDLE;
+		
+		int handle;
+		if (m_mHandles.Find(normalized, handle))
+			return handle;
+		
+		handle = m_aIDs.Insert(normalized);
+		m_mHandles.Set(normalized, handle);
+		return handle;
+	}
+	
+	// Handle of an already registered item, or INVALID_HANDLE
+	int Find(string itemID)
+	{
+		int handle;
+		if (m_mHandles.Find(Normalize(itemID), handle))
+			return handle;
+		return INVALID_HANDLE;
+	}
+	
+	string GetID(int handle)
+	{
+		if (handle < 0 || handle >= m_aIDs.Count())
+			return "";
+		return m_aIDs[handle];
+	}
+	
+	// Handles run from 0 to GetCount() - 1
+	int GetCount() { return m_aIDs.Count(); }
+}
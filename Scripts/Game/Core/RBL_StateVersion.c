@@ -0,0 +1,20 @@
+// ============================================================================
+// PROJECT REBELLION - State Version
+// Global counter bumped whenever persistent campaign state changes
+// Lets the autosave manager tell that nothing changed since its last save
+// ============================================================================
+
+class RBL_StateVersion
+{
+	protected static int s_iVersion;
+	
+	static void Bump()
+	{
+		s_iVersion++;
+	}
+	
+	static int Get()
+	{
+		return s_iVersion;
+	}
+}
@@ -333,6 +333,19 @@ class RBL_VictoryManager
 		PrintFormat("[RBL_VictoryMgr] Player death recorded: %1/%2", m_iPlayerDeaths, m_iMaxPlayerDeaths);
 	}
 	
+	// Client: mirror the server's outcome without ending the campaign or
+	// showing the end notification, which the game end broadcast owns
+	void SetCampaignStateLocal(ERBLCampaignState state, int playerDeaths)
+	{
+		m_iPlayerDeaths = playerDeaths;
+		
+		if (m_eCampaignState == state)
+			return;
+		
+		m_eCampaignState = state;
+		m_OnCampaignStateChanged.Invoke(m_eCampaignState);
+	}
+	
 	// ========================================================================
 	// CONFIGURATION
 	// ========================================================================
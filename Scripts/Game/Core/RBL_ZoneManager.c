@@ -11,6 +11,9 @@ class RBL_ZoneManager
 	protected ref array<ref RBL_VirtualZone> m_aVirtualZones;
 	protected ref map<string, RBL_CampaignZone> m_mZonesByID;
 	protected ref map<string, ref RBL_VirtualZone> m_mVirtualZonesByID;
+	// Registration index of each virtual zone; identical on every machine,
+	// so it can stand in for the zone ID in network messages
+	protected ref map<string, int> m_mVirtualZoneHandles;
 
 	protected float m_fTimeSinceSimulation;
 	protected const float SIMULATION_INTERVAL = 5.0;
@@ -32,6 +35,7 @@ class RBL_ZoneManager
 		m_aVirtualZones = new array<ref RBL_VirtualZone>();
 		m_mZonesByID = new map<string, RBL_CampaignZone>();
 		m_mVirtualZonesByID = new map<string, ref RBL_VirtualZone>();
+		m_mVirtualZoneHandles = new map<string, int>();
 		m_fTimeSinceSimulation = 0;
 		
 		m_OnZoneOwnershipChanged = new ScriptInvoker();
@@ -82,6 +86,7 @@ class RBL_ZoneManager
 			return;
 		}
 
+		m_mVirtualZoneHandles.Set(zoneID, m_aVirtualZones.Count());
 		m_aVirtualZones.Insert(zone);
 		m_mVirtualZonesByID.Set(zoneID, zone);
 	}
@@ -137,6 +142,22 @@ class RBL_ZoneManager
 		return GetVirtualZoneByID(zoneID);
 	}
 
+	// Small integer for the zone, or -1 if it is not a virtual zone
+	int GetVirtualZoneHandle(string zoneID)
+	{
+		int handle;
+		if (m_mVirtualZoneHandles.Find(zoneID, handle))
+			return handle;
+		return -1;
+	}
+
+	RBL_VirtualZone GetVirtualZoneByHandle(int handle)
+	{
+		if (handle < 0 || handle >= m_aVirtualZones.Count())
+			return null;
+		return m_aVirtualZones[handle];
+	}
+
 	array<RBL_CampaignZone> GetAllZones() { return m_aAllZones; }
 	array<ref RBL_VirtualZone> GetAllVirtualZones() { return m_aVirtualZones; }
 
@@ -450,6 +471,7 @@ class RBL_ZoneManager
 		{
 			ERBLFactionKey previousOwner = vZone.GetOwnerFaction();
 			vZone.SetOwnerFaction(newOwner);
+			RBL_StateVersion.Bump();
 			
 			m_OnZoneOwnershipChanged.Invoke(zoneID, previousOwner, newOwner);
 			
@@ -161,3 +161,15 @@ enum ERBLVehicleClass
 	HELICOPTER,
 	BOAT
 }
+
+enum ERBLSaveFormat
+{
+	JSON = 0,
+	BINARY
+}
+
+enum ERBLSaveCodec
+{
+	NONE = 0,
+	LZ
+}
@@ -245,6 +245,16 @@ class RBL_GameMode : SCR_BaseGameMode
 		if (garrisonMgr)
 			garrisonMgr.Update(timeSlice);
 		
+		// AI position index (feeds undercover proximity checks)
+		RBL_AISpatialHash aiHash = RBL_AISpatialHash.GetInstance();
+		if (aiHash)
+			aiHash.Update(timeSlice);
+		
+		// Live AI presence per zone (feeds capture)
+		RBL_ZonePresence zonePresence = RBL_ZonePresence.GetInstance();
+		if (zonePresence)
+			zonePresence.Update(timeSlice);
+		
 		// Undercover system
 		RBL_UndercoverSystem undercover = RBL_UndercoverSystem.GetInstance();
 		if (undercover)
@@ -260,6 +270,9 @@ class RBL_GameMode : SCR_BaseGameMode
 		if (victoryMgr)
 			victoryMgr.Update(timeSlice);
 		
+		// Notification bus (coalesced toasts, one batched RPC per tick)
+		RBL_NotificationBus.GetInstance().Update(timeSlice);
+		
 		// NEW UI System
 		if (m_bShowHUD)
 		{
@@ -365,6 +378,14 @@ modded class SCR_BaseGameMode
 		if (m_RBLAddon)
 			m_RBLAddon.OnGameModeFrame(timeSlice);
 	}
+
+	override void OnPlayerDisconnected(int playerId, KickCauseCode cause, int timeout)
+	{
+		super.OnPlayerDisconnected(playerId, cause, timeout);
+
+		if (m_RBLAddon)
+			m_RBLAddon.OnPlayerDisconnected(playerId);
+	}
 }
 
 class RBL_GameModeAddon
@@ -384,6 +405,13 @@ class RBL_GameModeAddon
 		PrintFormat("[RBL] Rebellion addon attached to game mode");
 	}
 
+	void OnPlayerDisconnected(int playerId)
+	{
+		RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
+		if (netMgr)
+			netMgr.HandlePlayerDisconnected(playerId);
+	}
+
 	void OnGameModeFrame(float timeSlice)
 	{
 		if (m_bInitialized)
@@ -584,6 +612,16 @@ class RBL_GameModeAddon
 		if (garrisonMgr)
 			garrisonMgr.Update(timeSlice);
 		
+		// AI position index
+		RBL_AISpatialHash aiHash = RBL_AISpatialHash.GetInstance();
+		if (aiHash)
+			aiHash.Update(timeSlice);
+		
+		// Live AI presence per zone
+		RBL_ZonePresence zonePresence = RBL_ZonePresence.GetInstance();
+		if (zonePresence)
+			zonePresence.Update(timeSlice);
+		
 		// Undercover
 		RBL_UndercoverSystem undercover = RBL_UndercoverSystem.GetInstance();
 		if (undercover)
@@ -599,6 +637,9 @@ class RBL_GameModeAddon
 		if (victoryMgr)
 			victoryMgr.Update(timeSlice);
 		
+		// Notification bus (coalesced toasts, one batched RPC per tick)
+		RBL_NotificationBus.GetInstance().Update(timeSlice);
+		
 		// NEW UI System
 		RBL_UIManager uiMgr = RBL_UIManager.GetInstance();
 		if (uiMgr)
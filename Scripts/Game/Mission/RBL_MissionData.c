@@ -91,6 +91,18 @@ class RBL_MissionObjective
 		return obj;
 	}
 	
+	// Client copy of a server objective; only what the UI shows
+	static RBL_MissionObjective CreateReplicated(ERBLObjectiveType type, string description, int targetCount, bool optional)
+	{
+		RBL_MissionObjective obj = new RBL_MissionObjective();
+		obj.m_sID = "obj_replicated";
+		obj.m_sDescription = description;
+		obj.m_eType = type;
+		obj.m_iTargetCount = targetCount;
+		obj.m_bOptional = optional;
+		return obj;
+	}
+	
 	// Update
 	void Update(float timeSlice)
 	{
@@ -131,6 +143,13 @@ class RBL_MissionObjective
 		m_bCompleted = completed;
 	}
 	
+	// Client: progress as reported by the server
+	void SetReplicatedProgress(int count, bool completed)
+	{
+		m_iCurrentCount = count;
+		m_bCompleted = completed;
+	}
+	
 	// Getters
 	string GetID() { return m_sID; }
 	string GetDescription() { return m_sDescription; }
@@ -284,6 +303,9 @@ class RBL_Mission
 	void SetMinWarLevel(int level) { m_iMinWarLevel = level; }
 	void SetRepeatable(bool repeatable) { m_bRepeatable = repeatable; }
 	
+	// Client: status as reported by the server
+	void SetStatus(ERBLMissionStatus status) { m_eStatus = status; }
+	
 	void AddObjective(RBL_MissionObjective objective)
 	{
 		if (objective)
@@ -24,6 +24,8 @@ class RBL_MissionManager
 	protected float m_fTimeSinceRefresh;
 	protected int m_iTotalMissionsCompleted;
 	protected int m_iTotalMissionsFailed;
+	// Bumped whenever a mission joins, leaves or moves between lists
+	protected int m_iListVersion;
 	
 	// Events
 	protected ref ScriptInvoker m_OnMissionAvailable;
@@ -62,6 +64,12 @@ class RBL_MissionManager
 	// NETWORK HELPERS
 	// ========================================================================
 	
+	protected void MarkListChanged()
+	{
+		m_iListVersion++;
+		RBL_StateVersion.Bump();
+	}
+	
 	protected bool IsServer()
 	{
 		return RBL_NetworkUtils.IsSinglePlayer() || RBL_NetworkUtils.IsServer();
@@ -89,9 +97,13 @@ class RBL_MissionManager
 		if (!m_bInitialized)
 			return;
 		
-		// Mission processing is server-authoritative
+		// Mission processing is server-authoritative; clients only count
+		// down the timers between server corrections
 		if (!IsServer())
+		{
+			UpdateReplicatedTimers(timeSlice);
 			return;
+		}
 		
 		// Update active missions
 		for (int i = m_aActiveMissions.Count() - 1; i >= 0; i--)
@@ -159,6 +171,7 @@ class RBL_MissionManager
 		m_aActiveMissions.Insert(mission);
 		
 		// Notify locally
+		MarkListChanged();
 		m_OnMissionStarted.Invoke(mission);
 		
 		// Broadcast to all clients
@@ -202,6 +215,7 @@ class RBL_MissionManager
 		m_aActiveMissions.Insert(mission);
 		
 		// Notify locally
+		MarkListChanged();
 		m_OnMissionStarted.Invoke(mission);
 		
 		PrintFormat("[RBL_MissionMgr] Mission restored: %1", mission.GetName());
@@ -225,6 +239,7 @@ class RBL_MissionManager
 		ApplyMissionReward(mission);
 		
 		// Notify locally
+		MarkListChanged();
 		m_OnMissionCompleted.Invoke(mission);
 		
 		// Broadcast to all clients
@@ -256,6 +271,7 @@ class RBL_MissionManager
 		m_iTotalMissionsFailed++;
 		
 		// Notify locally
+		MarkListChanged();
 		m_OnMissionFailed.Invoke(mission);
 		
 		// Broadcast to all clients
@@ -278,17 +294,16 @@ class RBL_MissionManager
 		if (!econMgr)
 			return;
 		
+		RBL_EconomyTransaction payout = econMgr.BeginTransaction(RBL_EconomySource.MISSION, mission.GetID());
+		payout.AddMoney(Math.Max(0, reward.GetMoney()));
+		payout.AddHR(Math.Max(0, reward.GetHR()));
+		econMgr.CommitTransaction(payout);
+		
 		if (reward.GetMoney() > 0)
-		{
-			econMgr.AddMoney(reward.GetMoney());
 			RBL_Notifications.MoneyReceived(reward.GetMoney(), "Mission");
-		}
 		
 		if (reward.GetHR() > 0)
-		{
-			econMgr.AddHR(reward.GetHR());
 			RBL_Notifications.HRReceived(reward.GetHR(), "Mission");
-		}
 		
 		// Apply aggression
 		if (reward.GetAggression() != 0)
@@ -301,6 +316,37 @@ class RBL_MissionManager
 		PrintFormat("[RBL_MissionMgr] Reward applied: %1", reward.GetRewardString());
 	}
 	
+	// ========================================================================
+	// CLIENT: REPLICATED MISSIONS
+	// ========================================================================
+	
+	// Replace the client's lists with missions rebuilt from server records
+	void SetReplicatedMissions(array<ref RBL_Mission> missions)
+	{
+		if (IsServer())
+			return;
+		
+		m_aActiveMissions.Clear();
+		m_aAvailableMissions.Clear();
+		foreach (RBL_Mission mission : missions)
+		{
+			if (mission.IsActive())
+				m_aActiveMissions.Insert(mission);
+			else if (mission.IsAvailable())
+				m_aAvailableMissions.Insert(mission);
+		}
+		m_iListVersion++;
+	}
+	
+	protected void UpdateReplicatedTimers(float timeSlice)
+	{
+		foreach (RBL_Mission mission : m_aActiveMissions)
+		{
+			if (mission.HasTimeLimit() && mission.GetTimeRemaining() > 0)
+				mission.SetTimeRemaining(Math.Max(0, mission.GetTimeRemaining() - timeSlice));
+		}
+	}
+	
 	// ========================================================================
 	// MISSION GENERATION
 	// ========================================================================
@@ -314,6 +360,7 @@ class RBL_MissionManager
 			if (mission && mission.GetStatus() == ERBLMissionStatus.EXPIRED)
 			{
 				m_aAvailableMissions.Remove(i);
+				MarkListChanged();
 				m_OnMissionExpired.Invoke(mission);
 			}
 		}
@@ -333,6 +380,7 @@ class RBL_MissionManager
 		if (mission)
 		{
 			m_aAvailableMissions.Insert(mission);
+			MarkListChanged();
 			m_OnMissionAvailable.Invoke(mission);
 		}
 	}
@@ -406,6 +454,7 @@ class RBL_MissionManager
 	int GetTotalMissionsFailed() { return m_iTotalMissionsFailed; }
 	bool CanStartMoreMissions() { return m_aActiveMissions.Count() < MAX_ACTIVE_MISSIONS; }
 	bool IsInitialized() { return m_bInitialized; }
+	int GetListVersion() { return m_iListVersion; }
 	
 	ScriptInvoker GetOnMissionAvailable() { return m_OnMissionAvailable; }
 	ScriptInvoker GetOnMissionStarted() { return m_OnMissionStarted; }
@@ -0,0 +1,443 @@
+// ============================================================================
+// PROJECT REBELLION - Campaign Snapshot
+// Join-in-progress state for late-joining clients
+// A newly connected client asks for one snapshot through its player endpoint.
+// The server builds it once, splits it into chunks and streams a few chunks
+// per frame to that client only; players already connected see no traffic
+// Format: one record per line, the first naming the format version
+//   H|version|stateVersion
+//   E|money|hr
+//   W|warLevel|aggression|day|active|campaignState|deaths
+//   Z|zone (RBL_ZoneNetworkState, comma separated)
+//   M|mission slot (RBL_MissionReplication.FormatSlotLines)
+// Deltas that arrive while a snapshot is still streaming are re-applied on top
+// of it, so the older snapshot cannot undo them
+// ============================================================================
+
+// Chunks of one snapshot still to be sent to one player
+class RBL_SnapshotStream
+{
+	int PlayerID;
+	int SnapshotID;
+	ref array<string> Chunks;
+	int NextChunk;
+}
+
+class RBL_CampaignSnapshot
+{
+	static const int FORMAT_VERSION = 1;
+	
+	protected static const string LINE_SEPARATOR = "\n";
+	protected static const string FIELD_SEPARATOR = "|";
+	
+	// Characters per chunk RPC, and chunks per player per frame
+	protected static const int CHUNK_SIZE = 1024;
+	protected static const int CHUNKS_PER_FRAME = 2;
+	
+	// Seconds before the same player may ask for another snapshot
+	protected static const float REQUEST_COOLDOWN_SECONDS = 30.0;
+	
+	protected static ref RBL_CampaignSnapshot s_Instance;
+	
+	// Server: snapshots being streamed
+	protected ref array<ref RBL_SnapshotStream> m_aStreams;
+	protected int m_iNextSnapshotID;
+	protected int m_iSnapshotsSent;
+	protected int m_iRequestsRejected;
+	
+	// Server: when each player last had a snapshot queued
+	protected ref map<int, float> m_mLastRequestTimes;
+	
+	// Client: snapshot being received
+	protected int m_iReceivingID;
+	protected ref array<string> m_aReceivedChunks;
+	protected int m_iChunksReceived;
+	protected bool m_bApplied;
+	protected int m_iAppliedBytes;
+	
+	// Client: ownership deltas received mid-stream
+	protected ref map<string, int> m_mDeferredZoneOwners;
+	
+	protected ref ScriptInvoker m_OnSnapshotApplied;
+	
+	static RBL_CampaignSnapshot GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new RBL_CampaignSnapshot();
+		return s_Instance;
+	}
+	
+	void RBL_CampaignSnapshot()
+	{
+		m_aStreams = new array<ref RBL_SnapshotStream>();
+		m_iNextSnapshotID = 1;
+		m_mLastRequestTimes = new map<int, float>();
+		
+		m_iReceivingID = -1;
+		m_aReceivedChunks = new array<string>();
+		m_mDeferredZoneOwners = new map<string, int>();
+		
+		m_OnSnapshotApplied = new ScriptInvoker();
+	}
+	
+	// ========================================================================
+	// SERVER: BUILD
+	// ========================================================================
+	
+	string Build()
+	{
+		array<string> lines = new array<string>();
+		lines.Insert("H" + FIELD_SEPARATOR + FORMAT_VERSION.ToString() + FIELD_SEPARATOR + RBL_StateVersion.Get().ToString());
+		
+		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
+		if (econMgr)
+			lines.Insert("E" + FIELD_SEPARATOR + econMgr.GetMoney().ToString() + FIELD_SEPARATOR + econMgr.GetHR().ToString());
+		
+		RBL_CampaignManager campMgr = RBL_CampaignManager.GetInstance();
+		if (campMgr)
+		{
+			int campaignState = ERBLCampaignState.ACTIVE;
+			int deaths = 0;
+			RBL_VictoryManager victoryMgr = RBL_VictoryManager.GetInstance();
+			if (victoryMgr)
+			{
+				campaignState = victoryMgr.GetCampaignState();
+				deaths = victoryMgr.GetPlayerDeaths();
+			}
+			
+			int active = campMgr.IsCampaignActive();
+			lines.Insert(string.Format("W|%1|%2|%3|%4|%5|%6",
+				campMgr.GetWarLevel(), campMgr.GetAggression(), campMgr.GetDayNumber(), active, campaignState, deaths));
+		}
+		
+		AddZoneLines(lines);
+		RBL_MissionReplication.GetInstance().FormatSlotLines(lines, "M" + FIELD_SEPARATOR);
+		
+		return RBL_FileReader.Join(JoinLines(lines));
+	}
+	
+	protected void AddZoneLines(array<string> lines)
+	{
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!zoneMgr)
+			return;
+		
+		RBL_CaptureManager captureMgr = RBL_CaptureManager.GetInstance();
+		
+		foreach (RBL_VirtualZone zone : zoneMgr.GetAllVirtualZones())
+		{
+			if (!zone)
+				continue;
+			
+			RBL_ZoneNetworkState state = new RBL_ZoneNetworkState();
+			state.ZoneID = zone.GetZoneID();
+			state.OwnerFaction = zone.GetOwnerFaction();
+			state.CivilianSupport = zone.GetCivilianSupport();
+			state.GarrisonStrength = zone.GetCurrentGarrison();
+			state.AlertState = zone.GetAlertState();
+			if (captureMgr)
+			{
+				state.CaptureProgress = captureMgr.GetCaptureProgress(state.ZoneID);
+				state.CapturingFaction = captureMgr.GetCapturingFaction(state.ZoneID);
+			}
+			lines.Insert("Z" + FIELD_SEPARATOR + state.Serialize());
+		}
+	}
+	
+	// Lines with the separator after each, ready for RBL_FileReader.Join
+	protected array<string> JoinLines(array<string> lines)
+	{
+		array<string> terminated = new array<string>();
+		foreach (string line : lines)
+		{
+			terminated.Insert(line + LINE_SEPARATOR);
+		}
+		return terminated;
+	}
+	
+	// ========================================================================
+	// SERVER: STREAM
+	// ========================================================================
+	
+	// Queue a fresh snapshot for one player. Every request costs a full
+	// Build, so one is refused while that player's stream is still in
+	// flight or within the cooldown of their last one
+	bool QueueFor(int playerID)
+	{
+		float now = GetGame().GetWorld().GetWorldTime() / 1000.0;
+		if (IsStreamingTo(playerID) || (m_mLastRequestTimes.Contains(playerID) && now - m_mLastRequestTimes.Get(playerID) < REQUEST_COOLDOWN_SECONDS))
+		{
+			m_iRequestsRejected++;
+			PrintFormat("[RBL_Snapshot] Refused repeat snapshot request from player %1", playerID);
+			return false;
+		}
+		m_mLastRequestTimes.Set(playerID, now);
+		
+		string snapshot = Build();
+		
+		RBL_SnapshotStream stream = new RBL_SnapshotStream();
+		stream.PlayerID = playerID;
+		stream.SnapshotID = m_iNextSnapshotID;
+		stream.Chunks = new array<string>();
+		stream.NextChunk = 0;
+		m_iNextSnapshotID++;
+		
+		for (int pos = 0; pos < snapshot.Length(); pos += CHUNK_SIZE)
+		{
+			stream.Chunks.Insert(snapshot.Substring(pos, Math.Min(CHUNK_SIZE, snapshot.Length() - pos)));
+		}
+		
+		m_aStreams.Insert(stream);
+		PrintFormat("[RBL_Snapshot] Streaming snapshot %1 to player %2: %3 chars in %4 chunks",
+			stream.SnapshotID, playerID, snapshot.Length(), stream.Chunks.Count());
+		return true;
+	}
+	
+	bool IsStreamingTo(int playerID)
+	{
+		foreach (RBL_SnapshotStream stream : m_aStreams)
+		{
+			if (stream.PlayerID == playerID)
+				return true;
+		}
+		return false;
+	}
+	
+	// A reconnecting player gets a new snapshot straight away
+	void OnPlayerDisconnected(int playerID)
+	{
+		m_mLastRequestTimes.Remove(playerID);
+		for (int i = m_aStreams.Count() - 1; i >= 0; i--)
+		{
+			if (m_aStreams[i].PlayerID == playerID)
+				m_aStreams.Remove(i);
+		}
+	}
+	
+	void Update(float timeSlice)
+	{
+		for (int i = m_aStreams.Count() - 1; i >= 0; i--)
+		{
+			RBL_SnapshotStream stream = m_aStreams[i];
+			RBL_PlayerNetworkComponent endpoint = RBL_PlayerNetworkComponent.GetForPlayer(stream.PlayerID);
+			
+			// Player left before the snapshot finished
+			if (!endpoint)
+			{
+				m_aStreams.Remove(i);
+				continue;
+			}
+			
+			int sent = 0;
+			while (stream.NextChunk < stream.Chunks.Count() && sent < CHUNKS_PER_FRAME)
+			{
+				endpoint.SendSnapshotChunk(stream.SnapshotID, stream.NextChunk, stream.Chunks.Count(), stream.Chunks[stream.NextChunk]);
+				stream.NextChunk++;
+				sent++;
+			}
+			
+			if (stream.NextChunk >= stream.Chunks.Count())
+			{
+				m_aStreams.Remove(i);
+				m_iSnapshotsSent++;
+			}
+		}
+	}
+	
+	// ========================================================================
+	// CLIENT: RECEIVE
+	// ========================================================================
+	
+	void ReceiveChunk(int snapshotID, int index, int count, string data)
+	{
+		if (count <= 0 || index < 0 || index >= count)
+			return;
+		
+		// A newer snapshot replaces one still being received
+		if (snapshotID != m_iReceivingID)
+		{
+			m_iReceivingID = snapshotID;
+			m_aReceivedChunks.Clear();
+			m_aReceivedChunks.Resize(count);
+			m_iChunksReceived = 0;
+		}
+		
+		if (m_aReceivedChunks.Count() != count || !m_aReceivedChunks[index].IsEmpty())
+			return;
+		
+		m_aReceivedChunks[index] = data;
+		m_iChunksReceived++;
+		
+		if (m_iChunksReceived < count)
+			return;
+		
+		string snapshot = RBL_FileReader.Join(m_aReceivedChunks);
+		m_aReceivedChunks.Clear();
+		m_iReceivingID = -1;
+		Apply(snapshot);
+	}
+	
+	bool IsReceiving() { return m_iReceivingID != -1; }
+	
+	// ========================================================================
+	// CLIENT: APPLY
+	// ========================================================================
+	
+	protected void Apply(string snapshot)
+	{
+		array<string> lines = new array<string>();
+		snapshot.Split(LINE_SEPARATOR, lines, true);
+		
+		if (lines.IsEmpty())
+			return;
+		
+		array<string> header = new array<string>();
+		lines[0].Split(FIELD_SEPARATOR, header, false);
+		if (header.Count() != 3 || header[0] != "H" || header[1].ToInt() != FORMAT_VERSION)
+		{
+			PrintFormat("[RBL_Snapshot] Ignoring snapshot with unknown format: %1", lines[0]);
+			return;
+		}
+		
+		for (int i = 1; i < lines.Count(); i++)
+		{
+			string line = lines[i];
+			if (line.Length() < 2)
+				continue;
+			
+			string tag = line.Substring(0, 1);
+			string body = line.Substring(2, line.Length() - 2);
+			
+			if (tag == "E")
+				ApplyEconomy(body);
+			else if (tag == "W")
+				ApplyWarState(body);
+			else if (tag == "Z")
+				ApplyZone(body);
+			else if (tag == "M")
+				RBL_MissionReplication.GetInstance().ApplySlotLine(body);
+		}
+		
+		// Ownership changes that arrived while the snapshot was in flight
+		// are newer than it
+		for (int d = 0; d < m_mDeferredZoneOwners.Count(); d++)
+		{
+			SetZoneOwner(m_mDeferredZoneOwners.GetKey(d), m_mDeferredZoneOwners.GetElement(d));
+		}
+		m_mDeferredZoneOwners.Clear();
+		RBL_MissionReplication.GetInstance().FinishSnapshot();
+		
+		m_bApplied = true;
+		m_iAppliedBytes = snapshot.Length();
+		m_OnSnapshotApplied.Invoke();
+		
+		PrintFormat("[RBL_Snapshot] Applied snapshot: %1 chars, %2 records", snapshot.Length(), lines.Count());
+	}
+	
+	protected void ApplyEconomy(string body)
+	{
+		array<string> parts = new array<string>();
+		body.Split(FIELD_SEPARATOR, parts, false);
+		if (parts.Count() != 2)
+			return;
+		
+		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
+		if (econMgr)
+			econMgr.DeserializeFromNetwork(parts[0].ToInt(), parts[1].ToInt());
+	}
+	
+	protected void ApplyWarState(string body)
+	{
+		array<string> parts = new array<string>();
+		body.Split(FIELD_SEPARATOR, parts, false);
+		if (parts.Count() != 6)
+			return;
+		
+		RBL_CampaignManager campMgr = RBL_CampaignManager.GetInstance();
+		if (campMgr)
+			campMgr.SetWarStateLocal(parts[0].ToInt(), parts[1].ToInt(), parts[2].ToInt(), parts[3].ToInt() != 0);
+		
+		RBL_VictoryManager victoryMgr = RBL_VictoryManager.GetInstance();
+		if (victoryMgr)
+			victoryMgr.SetCampaignStateLocal(parts[4].ToInt(), parts[5].ToInt());
+	}
+	
+	protected void ApplyZone(string body)
+	{
+		RBL_ZoneNetworkState state = new RBL_ZoneNetworkState();
+		if (!state.Deserialize(body))
+			return;
+		
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!zoneMgr)
+			return;
+		
+		RBL_VirtualZone zone = zoneMgr.GetVirtualZoneByID(state.ZoneID);
+		if (!zone)
+			return;
+		
+		zone.SetOwnerFaction(state.OwnerFaction);
+		zone.SetCivilianSupport(state.CivilianSupport);
+		zone.SetAlertState(state.AlertState);
+		zone.SetCurrentGarrison(state.GarrisonStrength);
+		
+		RBL_CaptureManager captureMgr = RBL_CaptureManager.GetInstance();
+		if (captureMgr && (state.CaptureProgress > 0 || captureMgr.GetCaptureProgress(state.ZoneID) > 0))
+			captureMgr.SetCaptureProgressLocal(state.ZoneID, state.CaptureProgress, state.CapturingFaction);
+	}
+	
+	protected void SetZoneOwner(string zoneID, int owner)
+	{
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!zoneMgr)
+			return;
+		
+		RBL_VirtualZone zone = zoneMgr.GetVirtualZoneByID(zoneID);
+		if (zone)
+			zone.SetOwnerFaction(owner);
+	}
+	
+	// ========================================================================
+	// CLIENT: DELTAS
+	// ========================================================================
+	
+	// Ownership change broadcast; kept until a snapshot in flight is applied
+	void OnZoneOwnerDelta(string zoneID, int newOwner)
+	{
+		if (IsReceiving())
+			m_mDeferredZoneOwners.Set(zoneID, newOwner);
+	}
+	
+	// ========================================================================
+	// GETTERS
+	// ========================================================================
+	
+	bool IsApplied() { return m_bApplied; }
+	int GetAppliedBytes() { return m_iAppliedBytes; }
+	int GetActiveStreamCount() { return m_aStreams.Count(); }
+	int GetSnapshotsSent() { return m_iSnapshotsSent; }
+	int GetRequestsRejected() { return m_iRequestsRejected; }
+	ScriptInvoker GetOnSnapshotApplied() { return m_OnSnapshotApplied; }
+}
+
+// ============================================================================
+// DEBUG COMMANDS
+// ============================================================================
+class RBL_SnapshotCommands
+{
+	// Size and record count of the snapshot the server would send now
+	static void PrintSnapshot()
+	{
+		string snapshot = RBL_CampaignSnapshot.GetInstance().Build();
+		array<string> lines = new array<string>();
+		snapshot.Split("\n", lines, true);
+		PrintFormat("[RBL_Snapshot] %1 records, %2 chars", lines.Count(), snapshot.Length());
+	}
+	
+	static void PrintStatus()
+	{
+		RBL_CampaignSnapshot snapshot = RBL_CampaignSnapshot.GetInstance();
+		PrintFormat("[RBL_Snapshot] Applied: %1 (%2 chars), receiving: %3", snapshot.IsApplied(), snapshot.GetAppliedBytes(), snapshot.IsReceiving());
+		PrintFormat("[RBL_Snapshot] Streams: %1 active, %2 sent, %3 requests refused", snapshot.GetActiveStreamCount(), snapshot.GetSnapshotsSent(), snapshot.GetRequestsRejected());
+	}
+}
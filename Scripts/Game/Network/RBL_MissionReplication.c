@@ -0,0 +1,532 @@
+// ============================================================================
+// PROJECT REBELLION - Mission Replication
+// Server: gives every active or available mission a slot and sends, through
+// RBL_ReplicatedState, only what changed since the last sync:
+//   - info (name, rewards, objectives) once, when the mission takes a slot
+//   - a packed RBL_MissionNetworkState when type, status, progress or target
+//     changes, and every TIME_RESYNC_SECONDS for timed missions
+//   - objective progress as per-objective deltas
+//   - a clear when the mission leaves both lists
+// Client: rebuilds RBL_Mission copies per slot, updates them in place and
+// hands the mission manager new lists only when membership or status changes
+// Target zones travel as RBL_ZoneManager virtual zone handles
+// ============================================================================
+
+class RBL_MissionReplication
+{
+	static const int MAX_SLOTS = 16;
+	protected static const float TIME_RESYNC_SECONDS = 15.0;
+	
+	protected static const string FIELD_SEPARATOR = "|";
+	protected static const string OBJECTIVE_SEPARATOR = ";";
+	protected static const string OBJECTIVE_FIELD_SEPARATOR = "~";
+	
+	protected static ref RBL_MissionReplication s_Instance;
+	
+	// Server: mission in each slot ("" = free) and what was last sent for it
+	protected ref array<string> m_aSlotIDs;
+	protected ref array<int> m_aSentRecords;
+	protected ref array<float> m_aSentAt;
+	// Per slot, one entry per objective: count << 1 | completed
+	protected ref array<ref array<int>> m_aSentObjectives;
+	
+	// Client: rebuilt missions and their last record per slot
+	protected ref array<ref RBL_Mission> m_aSlotMissions;
+	protected ref array<int> m_aSlotRecords;
+	protected ref array<int> m_aSlotProgress;
+	// Slots touched by a live message while a snapshot may be in flight
+	protected ref array<bool> m_aLiveSlots;
+	
+	protected int m_iInfosSent;
+	protected int m_iRecordsSent;
+	protected int m_iObjectiveDeltasSent;
+	protected int m_iClearsSent;
+	protected int m_iPublishes;
+	
+	static RBL_MissionReplication GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new RBL_MissionReplication();
+		return s_Instance;
+	}
+	
+	void RBL_MissionReplication()
+	{
+		m_aSlotIDs = new array<string>();
+		m_aSentRecords = new array<int>();
+		m_aSentAt = new array<float>();
+		m_aSentObjectives = new array<ref array<int>>();
+		
+		m_aSlotMissions = new array<ref RBL_Mission>();
+		m_aSlotRecords = new array<int>();
+		m_aSlotProgress = new array<int>();
+		m_aLiveSlots = new array<bool>();
+		
+		for (int i = 0; i < MAX_SLOTS; i++)
+		{
+			m_aSlotIDs.Insert("");
+			m_aSentRecords.Insert(-1);
+			m_aSentAt.Insert(0);
+			m_aSentObjectives.Insert(new array<int>());
+			
+			m_aSlotMissions.Insert(null);
+			m_aSlotRecords.Insert(-1);
+			m_aSlotProgress.Insert(0);
+			m_aLiveSlots.Insert(false);
+		}
+	}
+	
+	// ========================================================================
+	// SERVER: SYNC
+	// ========================================================================
+	
+	// Called after each replicated state sync on the authority
+	void Sync(RBL_ReplicatedState state)
+	{
+		RBL_MissionManager missionMgr = RBL_MissionManager.GetInstance();
+		if (!state || !missionMgr)
+			return;
+		
+		array<RBL_Mission> missions = new array<RBL_Mission>();
+		foreach (RBL_Mission active : missionMgr.GetActiveMissions())
+		{
+			if (active)
+				missions.Insert(active);
+		}
+		foreach (RBL_Mission available : missionMgr.GetAvailableMissions())
+		{
+			if (available)
+				missions.Insert(available);
+		}
+		
+		// Free the slots of missions that left both lists
+		for (int slot = 0; slot < MAX_SLOTS; slot++)
+		{
+			if (m_aSlotIDs[slot].IsEmpty() || FindMissionByID(missions, m_aSlotIDs[slot]))
+				continue;
+			
+			m_aSlotIDs[slot] = "";
+			m_aSentRecords[slot] = -1;
+			m_aSentObjectives[slot].Clear();
+			state.SendMissionCleared(slot);
+			m_iClearsSent++;
+		}
+		
+		float now = GetGame().GetWorld().GetWorldTime() / 1000.0;
+		
+		foreach (RBL_Mission mission : missions)
+		{
+			int missionSlot = m_aSlotIDs.Find(mission.GetID());
+			if (missionSlot == -1)
+			{
+				missionSlot = m_aSlotIDs.Find("");
+				if (missionSlot == -1)
+					continue;
+				
+				m_aSlotIDs[missionSlot] = mission.GetID();
+				state.SendMissionInfo(missionSlot, BuildInfo(mission));
+				m_iInfosSent++;
+				RememberObjectives(missionSlot, mission);
+			}
+			else
+			{
+				SendObjectiveDeltas(state, missionSlot, mission);
+			}
+			
+			RBL_MissionNetworkState record = BuildRecord(missionSlot, mission);
+			int packed = record.Pack();
+			bool resync = mission.HasTimeLimit() && now - m_aSentAt[missionSlot] >= TIME_RESYNC_SECONDS;
+			if (packed == m_aSentRecords[missionSlot] && !resync)
+				continue;
+			
+			m_aSentRecords[missionSlot] = packed;
+			m_aSentAt[missionSlot] = now;
+			state.SendMissionRecord(record);
+			m_iRecordsSent++;
+		}
+	}
+	
+	protected RBL_Mission FindMissionByID(array<RBL_Mission> missions, string missionID)
+	{
+		foreach (RBL_Mission mission : missions)
+		{
+			if (mission.GetID() == missionID)
+				return mission;
+		}
+		return null;
+	}
+	
+	protected RBL_MissionNetworkState BuildRecord(int slot, RBL_Mission mission)
+	{
+		RBL_MissionNetworkState record = new RBL_MissionNetworkState();
+		record.Slot = slot;
+		record.MissionType = mission.GetType();
+		record.Status = mission.GetStatus();
+		record.Progress = Math.Round(Math.Clamp(mission.GetOverallProgress(), 0, 1) * 255);
+		record.ZoneHandle = GetZoneHandle(mission.GetTargetZoneID());
+		record.TimeRemaining = Math.Ceil(mission.GetTimeRemaining());
+		return record;
+	}
+	
+	protected void RememberObjectives(int slot, RBL_Mission mission)
+	{
+		array<int> sent = m_aSentObjectives[slot];
+		sent.Clear();
+		foreach (RBL_MissionObjective objective : mission.GetObjectives())
+		{
+			sent.Insert(PackObjective(objective));
+		}
+	}
+	
+	protected void SendObjectiveDeltas(RBL_ReplicatedState state, int slot, RBL_Mission mission)
+	{
+		array<ref RBL_MissionObjective> objectives = mission.GetObjectives();
+		array<int> sent = m_aSentObjectives[slot];
+		
+		for (int i = 0; i < objectives.Count() && i < sent.Count(); i++)
+		{
+			int current = PackObjective(objectives[i]);
+			if (current == sent[i])
+				continue;
+			
+			sent[i] = current;
+			int completed = objectives[i].IsCompleted();
+			state.SendObjectiveProgress(slot | (i << 4) | (completed << 8), objectives[i].GetCurrentCount());
+			m_iObjectiveDeltasSent++;
+		}
+	}
+	
+	protected int PackObjective(RBL_MissionObjective objective)
+	{
+		int completed = objective.IsCompleted();
+		return (objective.GetCurrentCount() << 1) | completed;
+	}
+	
+	protected int GetZoneHandle(string zoneID)
+	{
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!zoneMgr || zoneID.IsEmpty())
+			return -1;
+		return zoneMgr.GetVirtualZoneHandle(zoneID);
+	}
+	
+	// ========================================================================
+	// INFO FORMAT
+	// missionID|name|difficulty|money|hr|timeLimit|objectives
+	// objectives: type~target~optional~count~completed~description, ";" joined
+	// ========================================================================
+	
+	protected string BuildInfo(RBL_Mission mission)
+	{
+		int money = 0;
+		int hr = 0;
+		RBL_MissionReward reward = mission.GetReward();
+		if (reward)
+		{
+			money = reward.GetMoney();
+			hr = reward.GetHR();
+		}
+		
+		string objectives = "";
+		foreach (RBL_MissionObjective objective : mission.GetObjectives())
+		{
+			if (!objectives.IsEmpty())
+				objectives += OBJECTIVE_SEPARATOR;
+			
+			int optional = objective.IsOptional();
+			int completed = objective.IsCompleted();
+			objectives += string.Format("%1~%2~%3~%4~%5~%6",
+				objective.GetType(), objective.GetTargetCount(), optional,
+				objective.GetCurrentCount(), completed, Clean(objective.GetDescription()));
+		}
+		
+		return string.Format("%1|%2|%3|%4|%5|%6|%7",
+			Clean(mission.GetID()), Clean(mission.GetName()), mission.GetDifficulty(),
+			money, hr, Math.Ceil(mission.GetTimeLimit()), objectives);
+	}
+	
+	protected string Clean(string value)
+	{
+		string cleaned = value;
+		cleaned.Replace(FIELD_SEPARATOR, "/");
+		cleaned.Replace(OBJECTIVE_SEPARATOR, ",");
+		cleaned.Replace(OBJECTIVE_FIELD_SEPARATOR, "-");
+		cleaned.Replace("\n", " ");
+		return cleaned;
+	}
+	
+	// ========================================================================
+	// CLIENT: APPLY
+	// The apply methods return true when the mission lists changed
+	// ========================================================================
+	
+	bool ApplyInfo(int slot, string info, bool live)
+	{
+		if (!IsClientSlot(slot))
+			return false;
+		
+		if (live)
+			m_aLiveSlots[slot] = true;
+		
+		array<string> parts = new array<string>();
+		info.Split(FIELD_SEPARATOR, parts, false);
+		if (parts.Count() != 7)
+			return false;
+		
+		RBL_Mission mission = new RBL_Mission();
+		mission.SetID(parts[0]);
+		mission.SetName(parts[1]);
+		mission.SetDifficulty(parts[2].ToInt());
+		mission.SetReward(RBL_MissionReward.Create(parts[3].ToInt(), parts[4].ToInt()));
+		mission.SetTimeLimit(parts[5].ToInt());
+		
+		array<string> objectives = new array<string>();
+		parts[6].Split(OBJECTIVE_SEPARATOR, objectives, true);
+		foreach (string objectiveData : objectives)
+		{
+			array<string> fields = new array<string>();
+			objectiveData.Split(OBJECTIVE_FIELD_SEPARATOR, fields, false);
+			if (fields.Count() != 6)
+				continue;
+			
+			RBL_MissionObjective objective = RBL_MissionObjective.CreateReplicated(fields[0].ToInt(), fields[5], fields[1].ToInt(), fields[2].ToInt() != 0);
+			objective.SetReplicatedProgress(fields[3].ToInt(), fields[4].ToInt() != 0);
+			mission.AddObjective(objective);
+		}
+		
+		m_aSlotMissions[slot] = mission;
+		
+		// A record that arrived before the info
+		if (m_aSlotRecords[slot] == -1)
+			return false;
+		
+		RBL_MissionNetworkState record = new RBL_MissionNetworkState();
+		record.Unpack(m_aSlotRecords[slot]);
+		ApplyRecordTo(mission, record);
+		Publish();
+		return true;
+	}
+	
+	bool ApplyRecord(int packed, int timeRemaining, bool live)
+	{
+		RBL_MissionNetworkState record = new RBL_MissionNetworkState();
+		record.Unpack(packed);
+		record.TimeRemaining = timeRemaining;
+		
+		int slot = record.Slot;
+		if (!IsClientSlot(slot))
+			return false;
+		
+		if (live)
+			m_aLiveSlots[slot] = true;
+		
+		int previous = m_aSlotRecords[slot];
+		m_aSlotRecords[slot] = packed;
+		m_aSlotProgress[slot] = record.Progress;
+		
+		RBL_Mission mission = m_aSlotMissions[slot];
+		if (!mission)
+			return false;
+		
+		ApplyRecordTo(mission, record);
+		
+		// Progress and time are updated in place; only a new mission or a
+		// status change moves it between lists
+		RBL_MissionNetworkState old = new RBL_MissionNetworkState();
+		old.Unpack(previous);
+		if (previous != -1 && old.Status == record.Status)
+			return false;
+		
+		Publish();
+		return true;
+	}
+	
+	protected void ApplyRecordTo(RBL_Mission mission, RBL_MissionNetworkState record)
+	{
+		mission.SetType(record.MissionType);
+		mission.SetStatus(record.Status);
+		mission.SetTimeRemaining(record.TimeRemaining);
+		mission.SetTargetZone(GetZoneID(record.ZoneHandle));
+	}
+	
+	bool ApplyCleared(int slot, bool live)
+	{
+		if (!IsClientSlot(slot))
+			return false;
+		
+		if (live)
+			m_aLiveSlots[slot] = true;
+		
+		bool wasShown = m_aSlotMissions[slot] && m_aSlotRecords[slot] != -1;
+		m_aSlotMissions[slot] = null;
+		m_aSlotRecords[slot] = -1;
+		m_aSlotProgress[slot] = 0;
+		
+		if (!wasShown)
+			return false;
+		
+		Publish();
+		return true;
+	}
+	
+	void ApplyObjective(int packed, int count)
+	{
+		int slot = packed & 15;
+		if (!IsClientSlot(slot))
+			return;
+		
+		RBL_Mission mission = m_aSlotMissions[slot];
+		if (!mission)
+			return;
+		
+		int index = (packed >> 4) & 15;
+		array<ref RBL_MissionObjective> objectives = mission.GetObjectives();
+		if (index < objectives.Count())
+			objectives[index].SetReplicatedProgress(count, ((packed >> 8) & 1) != 0);
+	}
+	
+	// The authority owns the real missions and ignores its own broadcasts
+	protected bool IsClientSlot(int slot)
+	{
+		if (slot < 0 || slot >= MAX_SLOTS)
+			return false;
+		
+		RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
+		return !netMgr || !netMgr.IsAuthority();
+	}
+	
+	protected string GetZoneID(int handle)
+	{
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!zoneMgr)
+			return "";
+		
+		RBL_VirtualZone zone = zoneMgr.GetVirtualZoneByHandle(handle);
+		if (!zone)
+			return "";
+		return zone.GetZoneID();
+	}
+	
+	protected void Publish()
+	{
+		RBL_MissionManager missionMgr = RBL_MissionManager.GetInstance();
+		if (!missionMgr)
+			return;
+		
+		array<ref RBL_Mission> missions = new array<ref RBL_Mission>();
+		for (int slot = 0; slot < MAX_SLOTS; slot++)
+		{
+			if (m_aSlotMissions[slot] && m_aSlotRecords[slot] != -1)
+				missions.Insert(m_aSlotMissions[slot]);
+		}
+		
+		missionMgr.SetReplicatedMissions(missions);
+		m_iPublishes++;
+	}
+	
+	// ========================================================================
+	// SNAPSHOT
+	// One line body per occupied slot: packed|timeRemaining|info
+	// ========================================================================
+	
+	// Server: current state of every slot, as a joining client needs it
+	void FormatSlotLines(array<string> lines, string prefix)
+	{
+		RBL_MissionManager missionMgr = RBL_MissionManager.GetInstance();
+		if (!missionMgr)
+			return;
+		
+		for (int slot = 0; slot < MAX_SLOTS; slot++)
+		{
+			if (m_aSlotIDs[slot].IsEmpty())
+				continue;
+			
+			RBL_Mission mission = missionMgr.GetActiveMissionByID(m_aSlotIDs[slot]);
+			if (!mission)
+				mission = missionMgr.GetAvailableMissionByID(m_aSlotIDs[slot]);
+			if (!mission)
+				continue;
+			
+			RBL_MissionNetworkState record = BuildRecord(slot, mission);
+			lines.Insert(prefix + record.Pack().ToString() + FIELD_SEPARATOR + record.TimeRemaining.ToString() + FIELD_SEPARATOR + BuildInfo(mission));
+		}
+	}
+	
+	// Client: one slot from a snapshot. Slots already updated by live
+	// messages are newer and are only completed, never overwritten
+	void ApplySlotLine(string body)
+	{
+		int packedEnd = body.IndexOf(FIELD_SEPARATOR);
+		if (packedEnd < 0)
+			return;
+		
+		int timeEnd = body.IndexOfFrom(packedEnd + 1, FIELD_SEPARATOR);
+		if (timeEnd < 0)
+			return;
+		
+		int packed = body.Substring(0, packedEnd).ToInt();
+		int timeRemaining = body.Substring(packedEnd + 1, timeEnd - packedEnd - 1).ToInt();
+		string info = body.Substring(timeEnd + 1, body.Length() - timeEnd - 1);
+		
+		int slot = packed & 15;
+		if (slot >= MAX_SLOTS)
+			return;
+		
+		if (!m_aLiveSlots[slot])
+		{
+			ApplyInfo(slot, info, false);
+			ApplyRecord(packed, timeRemaining, false);
+			return;
+		}
+		
+		// A live record arrived for a mission whose info was sent before
+		// this client joined
+		if (!m_aSlotMissions[slot] && m_aSlotRecords[slot] != -1)
+			ApplyInfo(slot, info, false);
+	}
+	
+	void FinishSnapshot()
+	{
+		for (int slot = 0; slot < MAX_SLOTS; slot++)
+		{
+			m_aLiveSlots[slot] = false;
+		}
+	}
+	
+	// ========================================================================
+	// STATS
+	// ========================================================================
+	
+	int GetUsedSlotCount()
+	{
+		int used = 0;
+		for (int slot = 0; slot < MAX_SLOTS; slot++)
+		{
+			if (!m_aSlotIDs[slot].IsEmpty() || m_aSlotMissions[slot])
+				used++;
+		}
+		return used;
+	}
+	
+	int GetInfosSent() { return m_iInfosSent; }
+	int GetRecordsSent() { return m_iRecordsSent; }
+	int GetObjectiveDeltasSent() { return m_iObjectiveDeltasSent; }
+	int GetClearsSent() { return m_iClearsSent; }
+	int GetPublishCount() { return m_iPublishes; }
+	int GetSlotProgress(int slot) { return m_aSlotProgress[slot]; }
+}
+
+// ============================================================================
+// DEBUG COMMANDS
+// ============================================================================
+class RBL_MissionReplicationCommands
+{
+	static void PrintStats()
+	{
+		RBL_MissionReplication replication = RBL_MissionReplication.GetInstance();
+		PrintFormat("[RBL_MissionRpl] Slots used: %1/%2", replication.GetUsedSlotCount(), RBL_MissionReplication.MAX_SLOTS);
+		PrintFormat("[RBL_MissionRpl] Sent: %1 infos, %2 records, %3 objective deltas, %4 clears",
+			replication.GetInfosSent(), replication.GetRecordsSent(), replication.GetObjectiveDeltasSent(), replication.GetClearsSent());
+		PrintFormat("[RBL_MissionRpl] Client list rebuilds: %1", replication.GetPublishCount());
+	}
+}
@@ -33,12 +33,22 @@ class RBL_NetworkManager : GenericEntity
 	protected ref ScriptInvoker m_OnPlayerConnected;
 	protected ref ScriptInvoker m_OnPlayerDisconnected;
 	protected ref ScriptInvoker m_OnPurchaseRequest;
-	protected ref ScriptInvoker m_OnPurchaseResult;
+	protected ref ScriptInvoker m_OnCartResult;
 	
-	// Request tracking
+	// Request tracking (client): carts sent but not yet answered, resent
+	// with the same ID until the server replies
 	protected ref map<int, ref array<string>> m_mPendingRequests;
+	protected ref map<int, float> m_mPendingRequestTimes;
 	protected int m_iNextRequestID;
 	
+	// Server: recent cart results per player, so a retried request is
+	// answered again instead of charged again
+	protected ref map<int, ref map<int, ref RBL_CartResult>> m_mCartResults;
+	
+	protected const float CART_RETRY_SECONDS = 5.0;
+	protected const int CART_RESULTS_PER_PLAYER = 16;
+	static const string CART_SEPARATOR = ",";
+	
 	static RBL_NetworkManager GetInstance()
 	{
 		return s_Instance;
@@ -52,10 +62,15 @@ class RBL_NetworkManager : GenericEntity
 		m_OnPlayerConnected = new ScriptInvoker();
 		m_OnPlayerDisconnected = new ScriptInvoker();
 		m_OnPurchaseRequest = new ScriptInvoker();
-		m_OnPurchaseResult = new ScriptInvoker();
+		m_OnCartResult = new ScriptInvoker();
 		
 		m_mPendingRequests = new map<int, ref array<string>>();
-		m_iNextRequestID = 1;
+		m_mPendingRequestTimes = new map<int, float>();
+		m_mCartResults = new map<int, ref map<int, ref RBL_CartResult>>();
+		
+		// Random start so a reconnecting client does not reuse IDs the
+		// server still remembers from its previous session
+		m_iNextRequestID = Math.RandomInt(1, 1 << 30);
 		
 		m_bInitialized = false;
 		
@@ -79,8 +94,23 @@ class RBL_NetworkManager : GenericEntity
 		if (!m_bInitialized)
 			return;
 		
+		RBL_NetworkStats.GetInstance().Update(timeSlice);
+		
+		RBL_TransientChannel.GetInstance().Update(timeSlice);
+		
 		if (m_bIsAuthority)
+		{
 			SyncStateFromManagers();
+			RBL_CampaignSnapshot.GetInstance().Update(timeSlice);
+		}
+		else
+		{
+			RetryPendingCarts();
+			
+			RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
+			if (econMgr && econMgr.HasPendingTransactions())
+				econMgr.SettlePending();
+		}
 	}
 	
 	protected void UpdateAuthorityState()
@@ -134,6 +164,7 @@ class RBL_NetworkManager : GenericEntity
 			{
 				m_iRplMoney = newMoney;
 				m_iRplHR = newHR;
+				RBL_NetworkStats.GetInstance().Record("BumpMe_NetworkManager", RBL_NetworkStats.Number() * 4);
 				Replication.BumpMe();
 			}
 		}
@@ -148,6 +179,7 @@ class RBL_NetworkManager : GenericEntity
 			{
 				m_iRplWarLevel = newWarLevel;
 				m_iRplAggression = newAggression;
+				RBL_NetworkStats.GetInstance().Record("BumpMe_NetworkManager", RBL_NetworkStats.Number() * 4);
 				Replication.BumpMe();
 			}
 		}
@@ -187,104 +219,174 @@ class RBL_NetworkManager : GenericEntity
 	}
 	
 	// ========================================================================
-	// PURCHASE SYSTEM (Client -> Server -> Client)
+	// PURCHASE CART (Client -> Server -> Owning client)
 	// ========================================================================
 	
-	void RequestPurchase(int playerID, string itemID, int moneyCost, int hrCost)
+	// Send a whole cart as one request. Returns the request ID, or -1 if
+	// it could not be sent
+	int RequestCart(array<string> itemIDs)
 	{
+		if (!itemIDs || itemIDs.IsEmpty())
+			return -1;
+		
+		int requestID = m_iNextRequestID;
+		m_iNextRequestID++;
+		
 		if (m_bIsAuthority)
 		{
-			ProcessPurchaseOnServer(playerID, itemID, moneyCost, hrCost);
+			ProcessCartOnServer(RBL_NetworkUtils.GetLocalPlayerID(), requestID, JoinCart(itemIDs));
+			return requestID;
 		}
-		else
+		
+		RBL_PlayerNetworkComponent endpoint = RBL_PlayerNetworkComponent.GetForPlayer(RBL_NetworkUtils.GetLocalPlayerID());
+		if (!endpoint)
 		{
-			Rpc(RpcAsk_Purchase, playerID, itemID, moneyCost, hrCost);
+			PrintFormat("[RBL_Network] No player endpoint to send cart %1 through", requestID);
+			return -1;
 		}
+		
+		array<string> pending = new array<string>();
+		pending.Copy(itemIDs);
+		m_mPendingRequests.Set(requestID, pending);
+		m_mPendingRequestTimes.Set(requestID, GetGame().GetWorld().GetWorldTime() / 1000.0);
+		
+		endpoint.SendCart(requestID, JoinCart(itemIDs));
+		return requestID;
 	}
 	
-	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
-	protected void RpcAsk_Purchase(int playerID, string itemID, int moneyCost, int hrCost)
+	// Single items go through the cart path, so the server takes the buyer
+	// from the sending controller and charges catalog prices
+	int RequestPurchase(string itemID)
 	{
-		ProcessPurchaseOnServer(playerID, itemID, moneyCost, hrCost);
+		array<string> itemIDs = {itemID};
+		return RequestCart(itemIDs);
 	}
 	
-	protected void ProcessPurchaseOnServer(int playerID, string itemID, int moneyCost, int hrCost)
+	// Resend carts the server has not answered; the request ID makes a
+	// duplicate harmless
+	protected void RetryPendingCarts()
 	{
-		if (!m_bIsAuthority)
+		if (m_mPendingRequests.IsEmpty())
 			return;
 		
-		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
-		if (!econMgr)
-		{
-			SendPurchaseResult(playerID, itemID, false, "Economy system unavailable");
+		RBL_PlayerNetworkComponent endpoint = RBL_PlayerNetworkComponent.GetForPlayer(RBL_NetworkUtils.GetLocalPlayerID());
+		if (!endpoint)
 			return;
-		}
 		
-		if (!econMgr.CanAffordPurchase(moneyCost, hrCost))
+		float now = GetGame().GetWorld().GetWorldTime() / 1000.0;
+		for (int i = 0; i < m_mPendingRequests.Count(); i++)
 		{
-			SendPurchaseResult(playerID, itemID, false, "Insufficient funds");
-			return;
+			int requestID = m_mPendingRequests.GetKey(i);
+			if (now - m_mPendingRequestTimes.Get(requestID) < CART_RETRY_SECONDS)
+				continue;
+			
+			m_mPendingRequestTimes.Set(requestID, now);
+			endpoint.SendCart(requestID, JoinCart(m_mPendingRequests.GetElement(i)));
+			PrintFormat("[RBL_NetworkMgr] Retrying cart request %1", requestID);
 		}
+	}
+	
+	// Server: process a cart once per request ID and reply to its sender
+	void ProcessCartOnServer(int playerID, int requestID, string itemList)
+	{
+		if (!m_bIsAuthority)
+			return;
 		
-		bool success = econMgr.TryPurchase(itemID, moneyCost, hrCost);
-		
-		if (success)
+		map<int, ref RBL_CartResult> results = m_mCartResults.Get(playerID);
+		if (!results)
 		{
-			DeliverItemToPlayer(playerID, itemID);
-			SendPurchaseResult(playerID, itemID, true, "Purchase successful");
+			results = new map<int, ref RBL_CartResult>();
+			m_mCartResults.Set(playerID, results);
 		}
-		else
+		
+		RBL_CartResult result = results.Get(requestID);
+		if (!result)
 		{
-			SendPurchaseResult(playerID, itemID, false, "Purchase failed");
+			array<string> itemIDs = new array<string>();
+			itemList.Split(CART_SEPARATOR, itemIDs, true);
+			
+			RBL_ShopManager shopMgr = RBL_ShopManager.GetInstance();
+			result = shopMgr.ProcessCart(playerID, itemIDs);
+			result.RequestID = requestID;
+			
+			if (results.Count() >= CART_RESULTS_PER_PLAYER)
+				RemoveOldestCartResult(results);
+			results.Set(requestID, result);
+			
+			PrintFormat("[RBL_NetworkMgr] Cart %1 from player %2: %3", requestID, playerID, result.Message);
 		}
+		
+		RBL_PlayerNetworkComponent endpoint = RBL_PlayerNetworkComponent.GetForPlayer(playerID);
+		if (endpoint)
+			endpoint.SendCartResult(result);
+		else
+			HandleCartResult(result);
 	}
 	
-	protected void DeliverItemToPlayer(int playerID, string itemID)
+	// A client's request IDs only grow, so the lowest is the oldest
+	protected void RemoveOldestCartResult(map<int, ref RBL_CartResult> results)
 	{
-		RBL_ShopManager shopMgr = RBL_ShopManager.GetInstance();
-		if (!shopMgr)
-			return;
-		
-		RBL_ItemDelivery delivery = RBL_ItemDelivery.GetInstance();
-		if (!delivery)
-			return;
-		
-		// Use centralized lookup from ShopManager
-		RBL_ShopItem item = shopMgr.GetItemByID(itemID);
-		
-		if (item)
+		int oldest = results.GetKey(0);
+		for (int i = 1; i < results.Count(); i++)
 		{
-			// Use the new DeliverShopItem method that works with getter methods
-			delivery.DeliverShopItem(item, playerID);
-			PrintFormat("[RBL_Network] Delivered %1 to player %2", item.GetDisplayName(), playerID);
+			oldest = Math.Min(oldest, results.GetKey(i));
 		}
-		else
+		results.Remove(oldest);
+	}
+	
+	// Server: forget a leaving player's cart results, snapshot and
+	// suspicion state. A reconnecting client starts from a fresh random
+	// request ID, so the results are never needed again
+	void HandlePlayerDisconnected(int playerID)
+	{
+		if (m_bIsAuthority)
 		{
-			PrintFormat("[RBL_Network] Item not found for delivery: %1", itemID);
+			m_mCartResults.Remove(playerID);
+			RBL_CampaignSnapshot.GetInstance().OnPlayerDisconnected(playerID);
+			RBL_TransientChannel.GetInstance().OnPlayerDisconnected(playerID);
 		}
+		
+		m_OnPlayerDisconnected.Invoke(playerID);
 	}
 	
-	protected void SendPurchaseResult(int playerID, string itemID, bool success, string message)
+	// Cart result arriving on the buyer's machine
+	void HandleCartResult(RBL_CartResult result)
 	{
-		m_OnPurchaseResult.Invoke(playerID, itemID, success, message);
+		// Answers to retries of a settled request are dropped
+		if (!m_bIsAuthority && !m_mPendingRequests.Contains(result.RequestID))
+			return;
+		
+		m_mPendingRequests.Remove(result.RequestID);
+		m_mPendingRequestTimes.Remove(result.RequestID);
+		
+		// A confirmed cost stays reserved until the replicated balance
+		// reaches the server's balance after the purchase
+		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
+		if (econMgr && !m_bIsAuthority)
+			econMgr.ResolvePending(result.RequestID, result.Success, result.MoneyAfter, result.HRAfter);
+		
+		m_OnCartResult.Invoke(result);
 		
-		Rpc(RpcDo_PurchaseResult, playerID, itemID, success, message);
+		if (result.Success)
+			RBL_Notifications.ItemPurchased(result.ItemCount.ToString() + " items", result.MoneyCharged);
+		else
+			RBL_Notifications.ErrorMessage(result.Message);
 	}
 	
-	[RplRpc(RplChannel.Reliable, RplRcver.Broadcast)]
-	protected void RpcDo_PurchaseResult(int playerID, string itemID, bool success, string message)
+	protected string JoinCart(array<string> itemIDs)
 	{
-		if (RBL_NetworkUtils.GetLocalPlayerID() == playerID)
+		string joined = "";
+		foreach (int i, string itemID : itemIDs)
 		{
-			m_OnPurchaseResult.Invoke(playerID, itemID, success, message);
-			
-			if (success)
-				RBL_Notifications.ItemPurchased(itemID, 0);
-			else
-				RBL_Notifications.ErrorMessage(message);
+			if (i > 0)
+				joined += CART_SEPARATOR;
+			joined += itemID;
 		}
+		return joined;
 	}
 	
+	int GetPendingCartCount() { return m_mPendingRequests.Count(); }
+	
 	// ========================================================================
 	// ZONE CAPTURE (Server -> Clients)
 	// ========================================================================
@@ -294,6 +396,7 @@ class RBL_NetworkManager : GenericEntity
 		if (!m_bIsAuthority)
 			return;
 		
+		RBL_NetworkStats.GetInstance().Record("RpcDo_ZoneCaptured", RBL_NetworkStats.Text(zoneID) + RBL_NetworkStats.Number() * 2);
 		Rpc(RpcDo_ZoneCaptured, zoneID, previousOwner, newOwner);
 	}
 	
@@ -309,6 +412,7 @@ class RBL_NetworkManager : GenericEntity
 		if (zone && !m_bIsAuthority)
 		{
 			zone.SetOwnerFaction(newOwner);
+			RBL_CampaignSnapshot.GetInstance().OnZoneOwnerDelta(zoneID, newOwner);
 		}
 		
 		// Show notification
@@ -322,21 +426,25 @@ class RBL_NetworkManager : GenericEntity
 			RBL_Notifications.ZoneLost(zoneName);
 	}
 	
-	void BroadcastCaptureProgress(string zoneID, float progress, int capturingFaction)
+	// ========================================================================
+	// TRANSIENT STATE (Server -> Clients, unreliable)
+	// ========================================================================
+	
+	// Every packet carries the full current set, so a lost one is replaced
+	// by the next instead of being resent
+	void BroadcastTransientState(int sequence, array<int> captures, array<int> qrfs)
 	{
 		if (!m_bIsAuthority)
 			return;
 		
-		Rpc(RpcDo_CaptureProgress, zoneID, progress, capturingFaction);
+		RBL_NetworkStats.GetInstance().Record("RpcDo_TransientState", RBL_NetworkStats.Number() * (3 + captures.Count() + qrfs.Count()));
+		Rpc(RpcDo_TransientState, sequence, captures, qrfs);
 	}
 	
 	[RplRpc(RplChannel.Unreliable, RplRcver.Broadcast)]
-	protected void RpcDo_CaptureProgress(string zoneID, float progress, int capturingFaction)
+	protected void RpcDo_TransientState(int sequence, array<int> captures, array<int> qrfs)
 	{
-		// Update local capture UI
-		RBL_UIManager uiMgr = RBL_UIManager.GetInstance();
-		if (uiMgr)
-			uiMgr.UpdateCaptureProgress(zoneID, progress, capturingFaction);
+		RBL_TransientChannel.GetInstance().Receive(sequence, captures, qrfs);
 	}
 	
 	// ========================================================================
@@ -348,14 +456,44 @@ class RBL_NetworkManager : GenericEntity
 		if (!m_bIsAuthority)
 			return;
 		
+		RBL_NetworkStats.GetInstance().Record("RpcDo_Notification", RBL_NetworkStats.Text(message) + RBL_NetworkStats.Number() * 3);
 		Rpc(RpcDo_Notification, message, color, duration, -1);
 	}
 	
+	// One reliable RPC for everything the notification bus released this tick
+	void BroadcastNotificationBatch(string batch)
+	{
+		if (!m_bIsAuthority)
+			return;
+		
+		RBL_NetworkStats.GetInstance().Record("RpcDo_NotificationBatch", RBL_NetworkStats.Text(batch));
+		Rpc(RpcDo_NotificationBatch, batch);
+		
+		// Broadcast RPCs do not run on the sender; a listen server host
+		// shows the batch itself
+		if (!RBL_NetworkUtils.IsDedicatedServer())
+			RBL_NotificationBus.ShowBatch(batch);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Broadcast)]
+	protected void RpcDo_NotificationBatch(string batch)
+	{
+		RBL_NotificationBus.ShowBatch(batch);
+	}
+	
 	void SendNotificationToPlayer(int playerID, string message, int color, float duration)
 	{
 		if (!m_bIsAuthority)
 			return;
 		
+		RBL_PlayerNetworkComponent endpoint = RBL_PlayerNetworkComponent.GetForPlayer(playerID);
+		if (endpoint)
+		{
+			endpoint.SendNotification(message, color, duration);
+			return;
+		}
+		
+		RBL_NetworkStats.GetInstance().Record("RpcDo_Notification", RBL_NetworkStats.Text(message) + RBL_NetworkStats.Number() * 3);
 		Rpc(RpcDo_Notification, message, color, duration, playerID);
 	}
 	
@@ -363,6 +501,7 @@ class RBL_NetworkManager : GenericEntity
 	protected void RpcDo_Notification(string message, int color, float duration, int targetPlayerID)
 	{
 		// If targetPlayerID is -1, show to all; otherwise only to target
+		// (fallback for controllers without a player endpoint)
 		if (targetPlayerID != -1 && RBL_NetworkUtils.GetLocalPlayerID() != targetPlayerID)
 			return;
 		
@@ -371,6 +510,52 @@ class RBL_NetworkManager : GenericEntity
 			uiMgr.ShowNotification(message, color, duration);
 	}
 	
+	// ========================================================================
+	// PER-PLAYER MESSAGES (Server -> Owning client)
+	// ========================================================================
+	
+	void SendHintToPlayer(int playerID, string message, string title, float duration)
+	{
+		if (!m_bIsAuthority)
+			return;
+		
+		RBL_PlayerNetworkComponent endpoint = RBL_PlayerNetworkComponent.GetForPlayer(playerID);
+		if (endpoint)
+			endpoint.SendHint(message, title, duration);
+		else
+			SendNotificationToPlayer(playerID, message, RBL_UIColors.COLOR_TEXT_PRIMARY, duration);
+	}
+	
+	void SendDeliveryResult(int playerID, string itemName, string category, ERBLDeliveryResult result)
+	{
+		if (!m_bIsAuthority)
+			return;
+		
+		RBL_PlayerNetworkComponent endpoint = RBL_PlayerNetworkComponent.GetForPlayer(playerID);
+		if (endpoint)
+		{
+			endpoint.SendDeliveryResult(itemName, category, result);
+			return;
+		}
+		
+		if (result == ERBLDeliveryResult.SUCCESS)
+			SendNotificationToPlayer(playerID, "Delivered: " + itemName, RBL_UIColors.COLOR_TEXT_PRIMARY, 2.0);
+		else
+			SendNotificationToPlayer(playerID, "Delivery Failed: " + itemName, RBL_UIColors.COLOR_ACCENT_RED, 3.0);
+	}
+	
+	// Cover state is only ever sent to its player; there is no broadcast
+	// fallback
+	void SendCoverStatus(int playerID, ERBLCoverStatus status, float suspicion, string reason)
+	{
+		if (!m_bIsAuthority)
+			return;
+		
+		RBL_PlayerNetworkComponent endpoint = RBL_PlayerNetworkComponent.GetForPlayer(playerID);
+		if (endpoint)
+			endpoint.SendCoverStatus(status, suspicion, reason);
+	}
+	
 	// ========================================================================
 	// MISSION SYNC (Server -> Clients)
 	// ========================================================================
@@ -380,6 +565,7 @@ class RBL_NetworkManager : GenericEntity
 		if (!m_bIsAuthority)
 			return;
 		
+		RBL_NetworkStats.GetInstance().Record("RpcDo_MissionStarted", RBL_NetworkStats.Text(missionID) + RBL_NetworkStats.Text(missionName));
 		Rpc(RpcDo_MissionStarted, missionID, missionName);
 	}
 	
@@ -394,6 +580,7 @@ class RBL_NetworkManager : GenericEntity
 		if (!m_bIsAuthority)
 			return;
 		
+		RBL_NetworkStats.GetInstance().Record("RpcDo_MissionCompleted", RBL_NetworkStats.Text(missionID) + RBL_NetworkStats.Text(missionName));
 		Rpc(RpcDo_MissionCompleted, missionID, missionName);
 	}
 	
@@ -408,6 +595,7 @@ class RBL_NetworkManager : GenericEntity
 		if (!m_bIsAuthority)
 			return;
 		
+		RBL_NetworkStats.GetInstance().Record("RpcDo_MissionFailed", RBL_NetworkStats.Text(missionID) + RBL_NetworkStats.Text(missionName));
 		Rpc(RpcDo_MissionFailed, missionID, missionName);
 	}
 	
@@ -427,8 +615,10 @@ class RBL_NetworkManager : GenericEntity
 			return;
 		
 		m_iRplWarLevel = newLevel;
+		RBL_NetworkStats.GetInstance().Record("BumpMe_NetworkManager", RBL_NetworkStats.Number() * 4);
 		Replication.BumpMe();
 		
+		RBL_NetworkStats.GetInstance().Record("RpcDo_WarLevelChanged", RBL_NetworkStats.Number());
 		Rpc(RpcDo_WarLevelChanged, newLevel);
 	}
 	
@@ -443,6 +633,7 @@ class RBL_NetworkManager : GenericEntity
 		if (!m_bIsAuthority)
 			return;
 		
+		RBL_NetworkStats.GetInstance().Record("RpcDo_QRFIncoming", RBL_NetworkStats.Text(qrfType) + RBL_NetworkStats.Text(targetZone));
 		Rpc(RpcDo_QRFIncoming, qrfType, targetZone);
 	}
 	
@@ -457,6 +648,7 @@ class RBL_NetworkManager : GenericEntity
 		if (!m_bIsAuthority)
 			return;
 		
+		RBL_NetworkStats.GetInstance().Record("RpcDo_GameEnd", RBL_NetworkStats.Flag());
 		Rpc(RpcDo_GameEnd, victory);
 	}
 	
@@ -481,7 +673,7 @@ class RBL_NetworkManager : GenericEntity
 	ScriptInvoker GetOnPlayerConnected() { return m_OnPlayerConnected; }
 	ScriptInvoker GetOnPlayerDisconnected() { return m_OnPlayerDisconnected; }
 	ScriptInvoker GetOnPurchaseRequest() { return m_OnPurchaseRequest; }
-	ScriptInvoker GetOnPurchaseResult() { return m_OnPurchaseResult; }
+	ScriptInvoker GetOnCartResult() { return m_OnCartResult; }
 	
 	// ========================================================================
 	// DEBUG
@@ -549,14 +741,11 @@ class RBL_Network
 		return RBL_NetworkUtils.IsSinglePlayer() || RBL_NetworkUtils.IsServer();
 	}
 	
-	void RequestPurchase(string itemID, int moneyCost, int hrCost)
+	void RequestPurchase(string itemID)
 	{
 		RBL_NetworkManager mgr = GetManager();
 		if (mgr)
-		{
-			int playerID = RBL_NetworkUtils.GetLocalPlayerID();
-			mgr.RequestPurchase(playerID, itemID, moneyCost, hrCost);
-		}
+			mgr.RequestPurchase(itemID);
 	}
 	
 	void BroadcastNotification(string message, int color, float duration)
@@ -0,0 +1,254 @@
+// ============================================================================
+// PROJECT REBELLION - Network Stats
+// Counts calls and approximate payload bytes of every RPC and every
+// Replication.BumpMe sent by the mod, per second with peaks
+// Sizes are estimates from the arguments (4 bytes per number, strings by
+// length plus a length prefix) and a fixed per-message header; they are for
+// comparing features and spotting regressions, not exact wire figures
+// ============================================================================
+
+class RBL_NetworkStatEntry
+{
+	string Name;
+	
+	int TotalCalls;
+	int TotalBytes;
+	
+	// Second being accumulated, and the last completed one
+	int WindowCalls;
+	int WindowBytes;
+	int LastCalls;
+	int LastBytes;
+	
+	int PeakCalls;
+	int PeakBytes;
+	
+	// Since the last CSV dump
+	int IntervalCalls;
+	int IntervalBytes;
+}
+
+class RBL_NetworkStats
+{
+	// Entity and method identifiers ahead of the arguments
+	protected static const int HEADER_BYTES = 8;
+	protected static const string CSV_PATH = "$profile:Rebellion/netstats.csv";
+	protected static const string CSV_HEADER = "time_s,name,calls,bytes,calls_per_s,bytes_per_s,peak_calls_per_s,peak_bytes_per_s";
+	
+	protected static ref RBL_NetworkStats s_Instance;
+	
+	protected ref map<string, ref RBL_NetworkStatEntry> m_mEntries;
+	
+	protected float m_fTime;
+	protected float m_fWindowTimer;
+	protected float m_fDumpTimer;
+	protected float m_fLastDumpTime;
+	protected bool m_bCsvEnabled;
+	
+	// All messages together
+	protected int m_iWindowBytes;
+	protected int m_iLastBytes;
+	protected int m_iPeakBytes;
+	
+	static RBL_NetworkStats GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new RBL_NetworkStats();
+		return s_Instance;
+	}
+	
+	void RBL_NetworkStats()
+	{
+		m_mEntries = new map<string, ref RBL_NetworkStatEntry>();
+		m_bCsvEnabled = true;
+	}
+	
+	// ========================================================================
+	// SIZE ESTIMATES
+	// ========================================================================
+	
+	static int Number() { return 4; }
+	static int Flag() { return 1; }
+	static int Text(string value) { return value.Length() + 2; }
+	
+	// ========================================================================
+	// RECORDING
+	// ========================================================================
+	
+	void Record(string name, int payloadBytes)
+	{
+		RBL_NetworkStatEntry entry = m_mEntries.Get(name);
+		if (!entry)
+		{
+			entry = new RBL_NetworkStatEntry();
+			entry.Name = name;
+			m_mEntries.Set(name, entry);
+		}
+		
+		int bytes = payloadBytes + HEADER_BYTES;
+		entry.TotalCalls++;
+		entry.TotalBytes += bytes;
+		entry.WindowCalls++;
+		entry.WindowBytes += bytes;
+		entry.IntervalCalls++;
+		entry.IntervalBytes += bytes;
+		m_iWindowBytes += bytes;
+	}
+	
+	// ========================================================================
+	// UPDATE
+	// ========================================================================
+	
+	void Update(float timeSlice)
+	{
+		m_fTime += timeSlice;
+		
+		m_fWindowTimer += timeSlice;
+		if (m_fWindowTimer >= 1.0)
+		{
+			m_fWindowTimer = 0;
+			CloseWindow();
+		}
+		
+		if (!m_bCsvEnabled || !RBL_NetworkUtils.IsMultiplayer() || !RBL_NetworkUtils.IsServer())
+			return;
+		
+		m_fDumpTimer += timeSlice;
+		if (m_fDumpTimer >= RBL_Config.NET_STATS_CSV_INTERVAL)
+		{
+			m_fDumpTimer = 0;
+			DumpCsv();
+		}
+	}
+	
+	protected void CloseWindow()
+	{
+		for (int i = 0; i < m_mEntries.Count(); i++)
+		{
+			RBL_NetworkStatEntry entry = m_mEntries.GetElement(i);
+			entry.LastCalls = entry.WindowCalls;
+			entry.LastBytes = entry.WindowBytes;
+			entry.PeakCalls = Math.Max(entry.PeakCalls, entry.WindowCalls);
+			entry.PeakBytes = Math.Max(entry.PeakBytes, entry.WindowBytes);
+			entry.WindowCalls = 0;
+			entry.WindowBytes = 0;
+		}
+		
+		m_iLastBytes = m_iWindowBytes;
+		m_iPeakBytes = Math.Max(m_iPeakBytes, m_iWindowBytes);
+		m_iWindowBytes = 0;
+	}
+	
+	// ========================================================================
+	// OUTPUT
+	// ========================================================================
+	
+	// Append one row per message type that was sent since the last dump
+	void DumpCsv()
+	{
+		bool exists = FileIO.FileExists(CSV_PATH);
+		FileHandle file;
+		if (exists)
+			file = FileIO.OpenFile(CSV_PATH, FileMode.APPEND);
+		else
+			file = FileIO.OpenFile(CSV_PATH, FileMode.WRITE);
+		
+		if (!file)
+		{
+			PrintFormat("[RBL_NetStats] Could not open %1", CSV_PATH);
+			return;
+		}
+		
+		if (!exists)
+			file.WriteLine(CSV_HEADER);
+		
+		float interval = Math.Max(m_fTime - m_fLastDumpTime, 1.0);
+		for (int i = 0; i < m_mEntries.Count(); i++)
+		{
+			RBL_NetworkStatEntry entry = m_mEntries.GetElement(i);
+			if (entry.IntervalCalls == 0)
+				continue;
+			
+			file.WriteLine(string.Format("%1,%2,%3,%4,%5,%6,%7,%8",
+				Math.Round(m_fTime), entry.Name, entry.IntervalCalls, entry.IntervalBytes,
+				entry.IntervalCalls / interval, entry.IntervalBytes / interval, entry.PeakCalls, entry.PeakBytes));
+			
+			entry.IntervalCalls = 0;
+			entry.IntervalBytes = 0;
+		}
+		file.Close();
+		
+		m_fLastDumpTime = m_fTime;
+	}
+	
+	// Message types by total bytes, largest first
+	void PrintReport()
+	{
+		array<ref RBL_NetworkStatEntry> sorted = new array<ref RBL_NetworkStatEntry>();
+		for (int i = 0; i < m_mEntries.Count(); i++)
+		{
+			RBL_NetworkStatEntry entry = m_mEntries.GetElement(i);
+			int at = 0;
+			while (at < sorted.Count() && sorted[at].TotalBytes >= entry.TotalBytes)
+			{
+				at++;
+			}
+			sorted.InsertAt(entry, at);
+		}
+		
+		PrintFormat("[RBL_NetStats] === BANDWIDTH (%1 s) ===", Math.Round(m_fTime));
+		PrintFormat("[RBL_NetStats] All: %1 B/s last second, peak %2 B/s", m_iLastBytes, m_iPeakBytes);
+		foreach (RBL_NetworkStatEntry entry : sorted)
+		{
+			PrintFormat("  %1: %2 calls, %3 B total | last %4/s, %5 B/s | peak %6/s, %7 B/s",
+				entry.Name, entry.TotalCalls, entry.TotalBytes, entry.LastCalls, entry.LastBytes, entry.PeakCalls, entry.PeakBytes);
+		}
+	}
+	
+	void Reset()
+	{
+		m_mEntries.Clear();
+		m_iWindowBytes = 0;
+		m_iLastBytes = 0;
+		m_iPeakBytes = 0;
+		m_fLastDumpTime = m_fTime;
+	}
+	
+	void SetCsvEnabled(bool enabled) { m_bCsvEnabled = enabled; }
+	bool IsCsvEnabled() { return m_bCsvEnabled; }
+	int GetPeakBytesPerSecond() { return m_iPeakBytes; }
+	
+	RBL_NetworkStatEntry GetEntry(string name)
+	{
+		return m_mEntries.Get(name);
+	}
+}
+
+// ============================================================================
+// DEBUG COMMANDS
+// ============================================================================
+class RBL_NetworkStatsCommands
+{
+	static void Print()
+	{
+		RBL_NetworkStats.GetInstance().PrintReport();
+	}
+	
+	static void Reset()
+	{
+		RBL_NetworkStats.GetInstance().Reset();
+		PrintFormat("[RBL_NetStats] Counters reset");
+	}
+	
+	static void DumpCsv()
+	{
+		RBL_NetworkStats.GetInstance().DumpCsv();
+		PrintFormat("[RBL_NetStats] Written to $profile:Rebellion/netstats.csv");
+	}
+	
+	static void EnableCsv(bool enabled)
+	{
+		RBL_NetworkStats.GetInstance().SetCsvEnabled(enabled);
+		PrintFormat("[RBL_NetStats] Periodic CSV dump: %1", enabled);
+	}
+}
@@ -0,0 +1,284 @@
+// ============================================================================
+// PROJECT REBELLION - Player Network Component
+// Per-player endpoint on the player controller. The owning client is the
+// only receiver of its RPCs, so private messages (purchase results,
+// deliveries, cover state, hints) are not sent to every other client, and
+// the server knows which player sent a request
+// Add to the player controller prefab used by the game mode; without it the
+// network manager falls back to filtered broadcasts
+// ============================================================================
+
+class RBL_PlayerNetworkComponentClass : ScriptComponentClass
+{
+}
+
+class RBL_PlayerNetworkComponent : ScriptComponent
+{
+	protected PlayerController m_PlayerController;
+	
+	// Client: how long to wait for this controller to become ours before
+	// giving up on asking for a join snapshot
+	protected const float SNAPSHOT_REQUEST_TIMEOUT = 30.0;
+	protected float m_fSnapshotWait;
+	
+	override void OnPostInit(IEntity owner)
+	{
+		super.OnPostInit(owner);
+		
+		m_PlayerController = PlayerController.Cast(owner);
+		
+		// Ownership is not known yet; EOnFrame asks once it is
+		if (!RBL_NetworkUtils.IsServer())
+			SetEventMask(owner, EntityEvent.FRAME);
+	}
+	
+	override void EOnFrame(IEntity owner, float timeSlice)
+	{
+		m_fSnapshotWait += timeSlice;
+		
+		if (IsOwnerLocal())
+		{
+			RBL_NetworkStats.GetInstance().Record("Player_RpcAsk_Snapshot", 0);
+			Rpc(RpcAsk_Snapshot);
+			ClearEventMask(owner, EntityEvent.FRAME);
+			return;
+		}
+		
+		if (m_fSnapshotWait >= SNAPSHOT_REQUEST_TIMEOUT)
+			ClearEventMask(owner, EntityEvent.FRAME);
+	}
+	
+	// ========================================================================
+	// LOOKUP
+	// ========================================================================
+	
+	// Endpoint of the given player, or null if their controller has none
+	static RBL_PlayerNetworkComponent GetForPlayer(int playerID)
+	{
+		PlayerManager pm = GetGame().GetPlayerManager();
+		if (!pm)
+			return null;
+		
+		PlayerController pc = pm.GetPlayerController(playerID);
+		if (!pc)
+			return null;
+		
+		return RBL_PlayerNetworkComponent.Cast(pc.FindComponent(RBL_PlayerNetworkComponent));
+	}
+	
+	int GetPlayerID()
+	{
+		if (!m_PlayerController)
+			return -1;
+		return m_PlayerController.GetPlayerId();
+	}
+	
+	// The owning client is this machine (singleplayer or listen server host).
+	// RPCs to the owner would not run here, so handlers are called directly
+	protected bool IsOwnerLocal()
+	{
+		return m_PlayerController && m_PlayerController == GetGame().GetPlayerController();
+	}
+	
+	// ========================================================================
+	// PURCHASE CART (Owner -> Server -> Owner)
+	// ========================================================================
+	
+	// The server takes the buyer from this controller, not from the request
+	void SendCart(int requestID, string itemList)
+	{
+		RBL_NetworkStats.GetInstance().Record("Player_RpcAsk_Cart", RBL_NetworkStats.Number() + RBL_NetworkStats.Text(itemList));
+		Rpc(RpcAsk_Cart, requestID, itemList);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
+	protected void RpcAsk_Cart(int requestID, string itemList)
+	{
+		RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
+		if (netMgr)
+			netMgr.ProcessCartOnServer(GetPlayerID(), requestID, itemList);
+	}
+	
+	void SendCartResult(RBL_CartResult result)
+	{
+		if (IsOwnerLocal())
+		{
+			RpcDo_CartResult(result.RequestID, result.Success, result.Message, result.MoneyCharged, result.HRCharged, result.ItemCount, result.MoneyAfter, result.HRAfter);
+			return;
+		}
+		
+		RBL_NetworkStats.GetInstance().Record("Player_RpcDo_CartResult", RBL_NetworkStats.Number() * 7 + RBL_NetworkStats.Flag() + RBL_NetworkStats.Text(result.Message));
+		Rpc(RpcDo_CartResult, result.RequestID, result.Success, result.Message, result.MoneyCharged, result.HRCharged, result.ItemCount, result.MoneyAfter, result.HRAfter);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+	protected void RpcDo_CartResult(int requestID, bool success, string message, int moneyCharged, int hrCharged, int itemCount, int moneyAfter, int hrAfter)
+	{
+		RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
+		if (!netMgr)
+			return;
+		
+		RBL_CartResult result = new RBL_CartResult();
+		result.RequestID = requestID;
+		result.Success = success;
+		result.Message = message;
+		result.MoneyCharged = moneyCharged;
+		result.HRCharged = hrCharged;
+		result.ItemCount = itemCount;
+		result.MoneyAfter = moneyAfter;
+		result.HRAfter = hrAfter;
+		netMgr.HandleCartResult(result);
+	}
+	
+	// ========================================================================
+	// NOTIFICATIONS AND HINTS (Server -> Owner)
+	// ========================================================================
+	
+	void SendNotification(string message, int color, float duration)
+	{
+		if (IsOwnerLocal())
+		{
+			RpcDo_Notification(message, color, duration);
+			return;
+		}
+		
+		RBL_NetworkStats.GetInstance().Record("Player_RpcDo_Notification", RBL_NetworkStats.Text(message) + RBL_NetworkStats.Number() * 2);
+		Rpc(RpcDo_Notification, message, color, duration);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+	protected void RpcDo_Notification(string message, int color, float duration)
+	{
+		RBL_Notifications.ShowNotification(message, color, duration);
+	}
+	
+	void SendHint(string message, string title, float duration)
+	{
+		if (IsOwnerLocal())
+		{
+			RpcDo_Hint(message, title, duration);
+			return;
+		}
+		
+		RBL_NetworkStats.GetInstance().Record("Player_RpcDo_Hint", RBL_NetworkStats.Text(message) + RBL_NetworkStats.Text(title) + RBL_NetworkStats.Number());
+		Rpc(RpcDo_Hint, message, title, duration);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+	protected void RpcDo_Hint(string message, string title, float duration)
+	{
+		SCR_HintUIInfo hint = SCR_HintUIInfo.CreateInfo(message, title, duration, EHint.UNDEFINED, EFieldManualEntryId.NONE, false);
+		if (!hint)
+			return;
+		
+		SCR_HintManagerComponent hintMgr = SCR_HintManagerComponent.GetInstance();
+		if (hintMgr)
+			hintMgr.Show(hint);
+	}
+	
+	// ========================================================================
+	// DELIVERY OUTCOME (Server -> Owner)
+	// ========================================================================
+	
+	void SendDeliveryResult(string itemName, string category, ERBLDeliveryResult result)
+	{
+		if (IsOwnerLocal())
+		{
+			RpcDo_DeliveryResult(itemName, category, result);
+			return;
+		}
+		
+		RBL_NetworkStats.GetInstance().Record("Player_RpcDo_DeliveryResult", RBL_NetworkStats.Text(itemName) + RBL_NetworkStats.Text(category) + RBL_NetworkStats.Number());
+		Rpc(RpcDo_DeliveryResult, itemName, category, result);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+	protected void RpcDo_DeliveryResult(string itemName, string category, int result)
+	{
+		RBL_ItemDelivery delivery = RBL_ItemDelivery.GetInstance();
+		if (!delivery)
+			return;
+		
+		if (result == ERBLDeliveryResult.SUCCESS)
+			delivery.NotifyDeliverySuccess(itemName, category);
+		else
+			RBL_Notifications.DeliveryFailed(itemName);
+	}
+	
+	// ========================================================================
+	// JOIN SNAPSHOT (Owner -> Server -> Owner)
+	// ========================================================================
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Server)]
+	protected void RpcAsk_Snapshot()
+	{
+		RBL_CampaignSnapshot.GetInstance().QueueFor(GetPlayerID());
+	}
+	
+	void SendSnapshotChunk(int snapshotID, int index, int count, string data)
+	{
+		// The host builds its state locally and never needs one
+		if (IsOwnerLocal())
+			return;
+		
+		RBL_NetworkStats.GetInstance().Record("Player_RpcDo_SnapshotChunk", RBL_NetworkStats.Number() * 3 + RBL_NetworkStats.Text(data));
+		Rpc(RpcDo_SnapshotChunk, snapshotID, index, count, data);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+	protected void RpcDo_SnapshotChunk(int snapshotID, int index, int count, string data)
+	{
+		RBL_CampaignSnapshot.GetInstance().ReceiveChunk(snapshotID, index, count, data);
+	}
+	
+	// ========================================================================
+	// COVER STATE (Server -> Owner)
+	// ========================================================================
+	
+	void SendCoverStatus(ERBLCoverStatus status, float suspicion, string reason)
+	{
+		// The host's undercover system already holds its own state
+		if (IsOwnerLocal())
+			return;
+		
+		RBL_NetworkStats.GetInstance().Record("Player_RpcDo_CoverStatus", RBL_NetworkStats.Number() * 2 + RBL_NetworkStats.Text(reason));
+		Rpc(RpcDo_CoverStatus, status, suspicion, reason);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Owner)]
+	protected void RpcDo_CoverStatus(int status, float suspicion, string reason)
+	{
+		RBL_UndercoverSystem undercover = RBL_UndercoverSystem.GetInstance();
+		if (!undercover)
+			return;
+		
+		int playerID = GetPlayerID();
+		int previous = undercover.GetCoverStatus(playerID);
+		undercover.SetCoverStatus(playerID, status);
+		undercover.SetSuspicionLevel(playerID, suspicion);
+		
+		if (status == previous)
+			return;
+		
+		if (status == ERBLCoverStatus.COMPROMISED)
+			RBL_Notifications.CoverBlown(reason);
+		else if (status == ERBLCoverStatus.HIDDEN)
+			RBL_Notifications.CoverRestored();
+	}
+	
+	// Suspicion level as a byte; unreliable, RBL_TransientChannel resends it
+	void SendSuspicion(int sequence, int level)
+	{
+		if (IsOwnerLocal())
+			return;
+		
+		RBL_NetworkStats.GetInstance().Record("Player_RpcDo_Suspicion", RBL_NetworkStats.Number() * 2);
+		Rpc(RpcDo_Suspicion, sequence, level);
+	}
+	
+	[RplRpc(RplChannel.Unreliable, RplRcver.Owner)]
+	protected void RpcDo_Suspicion(int sequence, int level)
+	{
+		RBL_TransientChannel.GetInstance().ReceiveSuspicion(GetPlayerID(), sequence, level);
+	}
+}
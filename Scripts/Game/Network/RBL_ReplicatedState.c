@@ -51,15 +51,8 @@ class RBL_ReplicatedState : GenericEntity
 	[RplProp(onRplName: "OnRpl_ZoneSupport")]
 	protected string m_sZoneSupportData;
 	
-	// ========================================================================
-	// REPLICATED MISSION STATE
-	// ========================================================================
-	
-	[RplProp(onRplName: "OnRpl_ActiveMissions")]
-	protected string m_sActiveMissionsData;
-	
-	[RplProp(onRplName: "OnRpl_AvailableMissions")]
-	protected string m_sAvailableMissionsData;
+	// Missions are not properties: RBL_MissionReplication sends per-slot
+	// records and objective deltas through the RPCs below
 	
 	// ========================================================================
 	// REPLICATED VICTORY STATE
@@ -245,7 +238,22 @@ class RBL_ReplicatedState : GenericEntity
 		}
 		
 		if (needsBump)
+		{
+			RBL_NetworkStats.GetInstance().Record("BumpMe_ReplicatedState", EstimateStateBytes());
 			Replication.BumpMe();
+		}
+		
+		if (RBL_NetworkUtils.IsMultiplayer())
+			RBL_MissionReplication.GetInstance().Sync(this);
+	}
+	
+	// Approximate size of a full property update: eight numbers, one flag
+	// and the packed zone strings
+	protected int EstimateStateBytes()
+	{
+		int bytes = RBL_NetworkStats.Number() * 8 + RBL_NetworkStats.Flag();
+		bytes += RBL_NetworkStats.Text(m_sZoneOwnershipData) + RBL_NetworkStats.Text(m_sZoneSupportData);
+		return bytes;
 	}
 	
 	protected string BuildZoneOwnershipString()
@@ -360,16 +368,6 @@ class RBL_ReplicatedState : GenericEntity
 		// Zone support data changed
 	}
 	
-	protected void OnRpl_ActiveMissions()
-	{
-		m_OnMissionsChanged.Invoke();
-	}
-	
-	protected void OnRpl_AvailableMissions()
-	{
-		m_OnMissionsChanged.Invoke();
-	}
-	
 	protected void OnRpl_VictoryState()
 	{
 		m_OnVictoryStateChanged.Invoke(m_iVictoryState);
@@ -392,6 +390,64 @@ class RBL_ReplicatedState : GenericEntity
 		// Player deaths changed
 	}
 	
+	// ========================================================================
+	// MISSIONS (Server -> Clients)
+	// ========================================================================
+	
+	// Name, rewards and objective definitions; sent once when a mission takes
+	// a slot
+	void SendMissionInfo(int slot, string info)
+	{
+		RBL_NetworkStats.GetInstance().Record("RpcDo_MissionInfo", RBL_NetworkStats.Number() + RBL_NetworkStats.Text(info));
+		Rpc(RpcDo_MissionInfo, slot, info);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Broadcast)]
+	protected void RpcDo_MissionInfo(int slot, string info)
+	{
+		if (RBL_MissionReplication.GetInstance().ApplyInfo(slot, info, true))
+			m_OnMissionsChanged.Invoke();
+	}
+	
+	void SendMissionRecord(RBL_MissionNetworkState record)
+	{
+		RBL_NetworkStats.GetInstance().Record("RpcDo_MissionRecord", RBL_NetworkStats.Number() * 2);
+		Rpc(RpcDo_MissionRecord, record.Pack(), record.TimeRemaining);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Broadcast)]
+	protected void RpcDo_MissionRecord(int packed, int timeRemaining)
+	{
+		if (RBL_MissionReplication.GetInstance().ApplyRecord(packed, timeRemaining, true))
+			m_OnMissionsChanged.Invoke();
+	}
+	
+	void SendMissionCleared(int slot)
+	{
+		RBL_NetworkStats.GetInstance().Record("RpcDo_MissionCleared", RBL_NetworkStats.Number());
+		Rpc(RpcDo_MissionCleared, slot);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Broadcast)]
+	protected void RpcDo_MissionCleared(int slot)
+	{
+		if (RBL_MissionReplication.GetInstance().ApplyCleared(slot, true))
+			m_OnMissionsChanged.Invoke();
+	}
+	
+	// packed: slot | objective index << 4 | completed << 8
+	void SendObjectiveProgress(int packed, int count)
+	{
+		RBL_NetworkStats.GetInstance().Record("RpcDo_ObjectiveProgress", RBL_NetworkStats.Number() * 2);
+		Rpc(RpcDo_ObjectiveProgress, packed, count);
+	}
+	
+	[RplRpc(RplChannel.Reliable, RplRcver.Broadcast)]
+	protected void RpcDo_ObjectiveProgress(int packed, int count)
+	{
+		RBL_MissionReplication.GetInstance().ApplyObjective(packed, count);
+	}
+	
 	// ========================================================================
 	// GETTERS
 	// ========================================================================
@@ -415,6 +471,7 @@ class RBL_ReplicatedState : GenericEntity
 			return;
 		
 		m_iMoney = value;
+		RBL_NetworkStats.GetInstance().Record("BumpMe_ReplicatedState", EstimateStateBytes());
 		Replication.BumpMe();
 	}
 	
@@ -424,6 +481,7 @@ class RBL_ReplicatedState : GenericEntity
 			return;
 		
 		m_iHumanResources = value;
+		RBL_NetworkStats.GetInstance().Record("BumpMe_ReplicatedState", EstimateStateBytes());
 		Replication.BumpMe();
 	}
 	
@@ -433,6 +491,7 @@ class RBL_ReplicatedState : GenericEntity
 			return;
 		
 		m_iWarLevel = value;
+		RBL_NetworkStats.GetInstance().Record("BumpMe_ReplicatedState", EstimateStateBytes());
 		Replication.BumpMe();
 	}
 	
@@ -442,6 +501,7 @@ class RBL_ReplicatedState : GenericEntity
 			return;
 		
 		m_iAggression = value;
+		RBL_NetworkStats.GetInstance().Record("BumpMe_ReplicatedState", EstimateStateBytes());
 		Replication.BumpMe();
 	}
 	
@@ -451,6 +511,7 @@ class RBL_ReplicatedState : GenericEntity
 			return;
 		
 		m_iVictoryState = state;
+		RBL_NetworkStats.GetInstance().Record("BumpMe_ReplicatedState", EstimateStateBytes());
 		Replication.BumpMe();
 	}
 	
@@ -536,41 +597,39 @@ class RBL_ZoneNetworkState
 }
 
 // ============================================================================
-// MISSION REPLICATED STATE - Mission network data
+// MISSION REPLICATED STATE - Compact per-slot mission record
+// Packed into one int: slot (4 bits), type (4), status (4), progress byte (8)
+// and target zone handle + 1 (12). Time remaining travels beside it in whole
+// seconds; names and objectives are sent once per mission by
+// RBL_MissionReplication
 // ============================================================================
 class RBL_MissionNetworkState
 {
-	string MissionID;
-	string MissionName;
+	int Slot;
 	int MissionType;
 	int Status;
-	float Progress;
-	int RewardMoney;
-	int RewardHR;
+	int Progress;
+	// Index into the zone manager's virtual zones, -1 for none
+	int ZoneHandle;
+	int TimeRemaining;
 	
-	string Serialize()
+	int Pack()
 	{
-		return string.Format("%1|%2|%3|%4|%5|%6|%7",
-			MissionID, MissionName, MissionType, Status, Progress, RewardMoney, RewardHR);
+		int packed = Slot & 15;
+		packed |= (MissionType & 15) << 4;
+		packed |= (Status & 15) << 8;
+		packed |= (Progress & 255) << 12;
+		packed |= ((ZoneHandle + 1) & 4095) << 20;
+		return packed;
 	}
 	
-	bool Deserialize(string data)
+	void Unpack(int packed)
 	{
-		array<string> parts = new array<string>();
-		data.Split("|", parts, false);
-		
-		if (parts.Count() != 7)
-			return false;
-		
-		MissionID = parts[0];
-		MissionName = parts[1];
-		MissionType = parts[2].ToInt();
-		Status = parts[3].ToInt();
-		Progress = parts[4].ToFloat();
-		RewardMoney = parts[5].ToInt();
-		RewardHR = parts[6].ToInt();
-		
-		return true;
+		Slot = packed & 15;
+		MissionType = (packed >> 4) & 15;
+		Status = (packed >> 8) & 15;
+		Progress = (packed >> 12) & 255;
+		ZoneHandle = ((packed >> 20) & 4095) - 1;
 	}
 }
 
@@ -0,0 +1,541 @@
+// ============================================================================
+// PROJECT REBELLION - Transient Channel
+// Unreliable, quantised updates for values that change continuously:
+//   - capture progress: one int per zone (zone handle, progress byte, faction)
+//   - QRF positions: two ints per QRF (handle, type, target zone handle and a
+//     16-bit grid coordinate per axis)
+//   - suspicion: one byte per player, sent to that player only
+// Every packet is the full current set, so a lost packet costs nothing.
+// Clients carry capture progress forward at the rate between the last two
+// packets and move QRF markers between samples; the server only sends when
+// an entry appears or disappears, when progress strays from what clients
+// predict, or every TRANSIENT_KEEPALIVE seconds. Clients drop entries
+// missing from a packet, and everything after TRANSIENT_STALE_TIME without one
+// ============================================================================
+
+class RBL_QRFTrack
+{
+	int Handle;
+	int QRFType;
+	string TargetZoneID;
+	
+	protected vector m_vFrom;
+	protected vector m_vTo;
+	protected float m_fAge;
+	protected float m_fInterval;
+	
+	void RBL_QRFTrack(int handle, vector position)
+	{
+		Handle = handle;
+		m_vFrom = position;
+		m_vTo = position;
+		m_fInterval = RBL_Config.TRANSIENT_SEND_INTERVAL;
+	}
+	
+	// Start moving from where the marker is drawn now to the new sample
+	void AddSample(vector position, float sinceLast)
+	{
+		m_vFrom = GetPosition();
+		m_vTo = position;
+		m_fAge = 0;
+		m_fInterval = Math.Clamp(sinceLast, RBL_Config.TRANSIENT_SEND_INTERVAL, RBL_Config.TRANSIENT_KEEPALIVE);
+	}
+	
+	void Advance(float timeSlice)
+	{
+		m_fAge += timeSlice;
+	}
+	
+	vector GetPosition()
+	{
+		float t = Math.Clamp(m_fAge / m_fInterval, 0, 1);
+		return vector.Lerp(m_vFrom, m_vTo, t);
+	}
+}
+
+class RBL_TransientChannel
+{
+	// Metres per grid step; 16 bits cover 32 km
+	protected static const float GRID_STEP = 0.5;
+	protected static const int GRID_MAX = 65535;
+	protected static const int MAX_QRF_HANDLES = 256;
+	// Empty packets sent after the last entry disappears
+	protected static const int EMPTY_REPEATS = 3;
+	// Progress bytes clients may drift from the server before a correction
+	protected static const int CAPTURE_TOLERANCE = 3;
+	
+	protected static ref RBL_TransientChannel s_Instance;
+	
+	// Server
+	protected int m_iSequence;
+	protected float m_fSendTimer;
+	protected float m_fSinceSend;
+	protected int m_iEmptyRepeats;
+	protected ref array<int> m_aLastCaptures;
+	protected ref array<int> m_aLastQRFs;
+	// Progress rate per zone handle as clients derive it, in bytes per second
+	protected ref map<int, float> m_mSentRates;
+	protected ref map<string, int> m_mQRFHandles;
+	protected int m_iNextQRFHandle;
+	protected ref map<int, int> m_mSentSuspicion;
+	protected float m_fSuspicionKeepalive;
+	protected int m_iSuspicionSequence;
+	
+	// Client
+	protected int m_iLastReceived;
+	protected float m_fSinceReceived;
+	protected ref array<string> m_aCaptureZones;
+	protected ref map<int, ref RBL_QRFTrack> m_mQRFTracks;
+	protected float m_fSinceQRFSample;
+	protected int m_iLastSuspicionSequence;
+	
+	protected int m_iPacketsSent;
+	protected int m_iPacketsReceived;
+	protected int m_iPacketsSkipped;
+	
+	static RBL_TransientChannel GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new RBL_TransientChannel();
+		return s_Instance;
+	}
+	
+	void RBL_TransientChannel()
+	{
+		m_aLastCaptures = new array<int>();
+		m_aLastQRFs = new array<int>();
+		m_mSentRates = new map<int, float>();
+		m_mQRFHandles = new map<string, int>();
+		m_mSentSuspicion = new map<int, int>();
+		
+		m_iLastReceived = -1;
+		m_iLastSuspicionSequence = -1;
+		m_aCaptureZones = new array<string>();
+		m_mQRFTracks = new map<int, ref RBL_QRFTrack>();
+	}
+	
+	// ========================================================================
+	// QUANTISATION
+	// ========================================================================
+	
+	static int ToByte(float value, float max)
+	{
+		return Math.Clamp(Math.Round(value / max * 255), 0, 255);
+	}
+	
+	static float FromByte(int value, float max)
+	{
+		return value / 255.0 * max;
+	}
+	
+	static int PackPosition(vector position)
+	{
+		int x = Math.Clamp(Math.Round(position[0] / GRID_STEP), 0, GRID_MAX);
+		int z = Math.Clamp(Math.Round(position[2] / GRID_STEP), 0, GRID_MAX);
+		return x | (z << 16);
+	}
+	
+	// Height is taken from the terrain
+	static vector UnpackPosition(int packed)
+	{
+		vector position = vector.Zero;
+		position[0] = (packed & GRID_MAX) * GRID_STEP;
+		position[2] = ((packed >> 16) & GRID_MAX) * GRID_STEP;
+		
+		BaseWorld world = GetGame().GetWorld();
+		if (world)
+			position[1] = world.GetSurfaceY(position[0], position[2]);
+		return position;
+	}
+	
+	// ========================================================================
+	// UPDATE
+	// ========================================================================
+	
+	void Update(float timeSlice)
+	{
+		RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
+		if (!netMgr)
+			return;
+		
+		m_fSinceQRFSample += timeSlice;
+		for (int i = 0; i < m_mQRFTracks.Count(); i++)
+		{
+			m_mQRFTracks.GetElement(i).Advance(timeSlice);
+		}
+		
+		if (netMgr.IsAuthority())
+		{
+			if (RBL_NetworkUtils.IsMultiplayer())
+				UpdateServer(netMgr, timeSlice);
+			return;
+		}
+		
+		UpdateClient(timeSlice);
+	}
+	
+	// ========================================================================
+	// SERVER
+	// ========================================================================
+	
+	protected void UpdateServer(RBL_NetworkManager netMgr, float timeSlice)
+	{
+		m_fSendTimer += timeSlice;
+		m_fSinceSend += timeSlice;
+		if (m_fSendTimer < RBL_Config.TRANSIENT_SEND_INTERVAL)
+			return;
+		m_fSendTimer = 0;
+		
+		array<int> captures = new array<int>();
+		array<int> qrfs = new array<int>();
+		CollectCaptures(captures);
+		CollectQRFs(qrfs);
+		
+		// The host has no client side, but its markers use the same tracks
+		if (!RBL_NetworkUtils.IsDedicatedServer())
+			ApplyQRFs(qrfs);
+		
+		SendSuspicion();
+		
+		bool changed = !SameMembers(captures, m_aLastCaptures, 1) || !SameMembers(qrfs, m_aLastQRFs, 2);
+		bool empty = captures.IsEmpty() && qrfs.IsEmpty();
+		
+		if (changed)
+			m_iEmptyRepeats = 0;
+		
+		if (empty)
+		{
+			if (m_iEmptyRepeats >= EMPTY_REPEATS)
+				return;
+			m_iEmptyRepeats++;
+		}
+		else if (!changed && !HasCaptureDrift(captures) && m_fSinceSend < RBL_Config.TRANSIENT_KEEPALIVE)
+		{
+			return;
+		}
+		
+		m_iSequence++;
+		netMgr.BroadcastTransientState(m_iSequence, captures, qrfs);
+		RememberRates(captures);
+		m_aLastCaptures = captures;
+		m_aLastQRFs = qrfs;
+		m_fSinceSend = 0;
+		m_iPacketsSent++;
+	}
+	
+	// zone handle (12 bits) | progress byte << 12 | faction << 20
+	protected void CollectCaptures(array<int> captures)
+	{
+		RBL_CaptureManager captureMgr = RBL_CaptureManager.GetInstance();
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!captureMgr || !zoneMgr)
+			return;
+		
+		foreach (RBL_VirtualZone zone : captureMgr.GetActiveZones())
+		{
+			if (!zone)
+				continue;
+			
+			string zoneID = zone.GetZoneID();
+			float progress = captureMgr.GetCaptureProgress(zoneID);
+			int handle = zoneMgr.GetVirtualZoneHandle(zoneID);
+			if (progress <= 0 || handle < 0)
+				continue;
+			
+			int progressByte = Math.Max(ToByte(progress, 100.0), 1);
+			captures.Insert((handle & 4095) | (progressByte << 12) | ((captureMgr.GetCapturingFaction(zoneID) & 15) << 20));
+		}
+	}
+	
+	// handle (8 bits) | type << 8 | (target zone handle + 1) << 12, position
+	protected void CollectQRFs(array<int> qrfs)
+	{
+		RBL_CommanderAI commander = RBL_CommanderAI.GetInstance();
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!commander || !zoneMgr)
+			return;
+		
+		array<string> live = new array<string>();
+		foreach (RBL_QRFOperation qrf : commander.GetActiveQRFs())
+		{
+			if (!qrf || qrf.IsComplete())
+				continue;
+			
+			string operationID = qrf.GetOperationID();
+			live.Insert(operationID);
+			
+			int handle;
+			if (!m_mQRFHandles.Find(operationID, handle))
+			{
+				handle = m_iNextQRFHandle;
+				m_iNextQRFHandle = (m_iNextQRFHandle + 1) % MAX_QRF_HANDLES;
+				m_mQRFHandles.Set(operationID, handle);
+			}
+			
+			int zoneHandle = zoneMgr.GetVirtualZoneHandle(qrf.GetTargetZoneID());
+			qrfs.Insert(handle | ((qrf.GetQRFType() & 15) << 8) | (((zoneHandle + 1) & 4095) << 12));
+			qrfs.Insert(PackPosition(qrf.GetCurrentPosition()));
+		}
+		
+		for (int i = m_mQRFHandles.Count() - 1; i >= 0; i--)
+		{
+			if (live.Find(m_mQRFHandles.GetKey(i)) == -1)
+				m_mQRFHandles.RemoveElement(i);
+		}
+	}
+	
+	// Each remote player gets their own level, when it moves by a step or
+	// once per keepalive
+	protected void SendSuspicion()
+	{
+		RBL_UndercoverSystem undercover = RBL_UndercoverSystem.GetInstance();
+		PlayerManager pm = GetGame().GetPlayerManager();
+		if (!undercover || !pm)
+			return;
+		
+		m_fSuspicionKeepalive += RBL_Config.TRANSIENT_SEND_INTERVAL;
+		bool keepalive = m_fSuspicionKeepalive >= RBL_Config.TRANSIENT_KEEPALIVE;
+		if (keepalive)
+			m_fSuspicionKeepalive = 0;
+		
+		m_iSuspicionSequence++;
+		array<int> playerIDs = new array<int>();
+		pm.GetPlayers(playerIDs);
+		foreach (int playerID : playerIDs)
+		{
+			int level = ToByte(undercover.GetPlayerSuspicionLevel(playerID), 1.0);
+			int sent;
+			if (m_mSentSuspicion.Find(playerID, sent) && sent == level && !keepalive)
+				continue;
+			
+			RBL_PlayerNetworkComponent endpoint = RBL_PlayerNetworkComponent.GetForPlayer(playerID);
+			if (!endpoint)
+				continue;
+			
+			m_mSentSuspicion.Set(playerID, level);
+			endpoint.SendSuspicion(m_iSuspicionSequence, level);
+		}
+	}
+	
+	// A reconnecting player is sent their level again instead of waiting
+	// for the keepalive
+	void OnPlayerDisconnected(int playerID)
+	{
+		m_mSentSuspicion.Remove(playerID);
+	}
+	
+	// Same entries in the same order, comparing everything but the payload:
+	// the low 12 bits of capture entries, the header int of QRF pairs
+	protected bool SameMembers(array<int> current, array<int> previous, int stride)
+	{
+		if (current.Count() != previous.Count())
+			return false;
+		
+		for (int i = 0; i < current.Count(); i += stride)
+		{
+			if (stride == 1)
+			{
+				int mask = 4095 | (15 << 20);
+				if ((current[i] & mask) != (previous[i] & mask))
+					return false;
+			}
+			else if (current[i] != previous[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+	
+	// True if any zone's progress is further from the clients' extrapolation
+	// than the tolerance
+	protected bool HasCaptureDrift(array<int> captures)
+	{
+		for (int i = 0; i < captures.Count(); i++)
+		{
+			int handle = captures[i] & 4095;
+			int sentByte = (m_aLastCaptures[i] >> 12) & 255;
+			float rate;
+			m_mSentRates.Find(handle, rate);
+			
+			float predicted = Math.Clamp(sentByte + rate * m_fSinceSend, 0, 255);
+			if (Math.AbsFloat(((captures[i] >> 12) & 255) - predicted) > CAPTURE_TOLERANCE)
+				return true;
+		}
+		return false;
+	}
+	
+	// Mirror of the rate clients compute between consecutive packets
+	protected void RememberRates(array<int> captures)
+	{
+		map<int, float> rates = new map<int, float>();
+		foreach (int entry : captures)
+		{
+			int handle = entry & 4095;
+			float rate = 0;
+			int previous = FindCapture(m_aLastCaptures, handle);
+			if (previous != -1 && m_fSinceSend > 0.05)
+				rate = (((entry >> 12) & 255) - ((previous >> 12) & 255)) / m_fSinceSend;
+			rates.Set(handle, rate);
+		}
+		m_mSentRates = rates;
+	}
+	
+	protected int FindCapture(array<int> captures, int handle)
+	{
+		foreach (int entry : captures)
+		{
+			if ((entry & 4095) == handle)
+				return entry;
+		}
+		return -1;
+	}
+	
+	// ========================================================================
+	// CLIENT
+	// ========================================================================
+	
+	void Receive(int sequence, array<int> captures, array<int> qrfs)
+	{
+		// Unreliable packets can arrive out of order; an older one is
+		// already superseded
+		if (sequence <= m_iLastReceived)
+		{
+			m_iPacketsSkipped++;
+			return;
+		}
+		
+		m_iLastReceived = sequence;
+		m_iPacketsReceived++;
+		
+		ApplyCaptures(captures);
+		ApplyQRFs(qrfs);
+		m_fSinceReceived = 0;
+	}
+	
+	protected void ApplyCaptures(array<int> captures)
+	{
+		RBL_CaptureManager captureMgr = RBL_CaptureManager.GetInstance();
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!captureMgr || !zoneMgr)
+			return;
+		
+		array<string> zones = new array<string>();
+		foreach (int entry : captures)
+		{
+			RBL_VirtualZone zone = zoneMgr.GetVirtualZoneByHandle(entry & 4095);
+			if (!zone)
+				continue;
+			
+			string zoneID = zone.GetZoneID();
+			zones.Insert(zoneID);
+			captureMgr.SetCaptureProgressLocal(zoneID, FromByte((entry >> 12) & 255, 100.0), (entry >> 20) & 15);
+		}
+		
+		// Zones no longer listed have finished or decayed
+		foreach (string previous : m_aCaptureZones)
+		{
+			if (zones.Find(previous) == -1)
+				captureMgr.SetCaptureProgressLocal(previous, 0, ERBLFactionKey.NONE);
+		}
+		m_aCaptureZones = zones;
+	}
+	
+	protected void ApplyQRFs(array<int> qrfs)
+	{
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		
+		array<int> handles = new array<int>();
+		for (int i = 0; i + 1 < qrfs.Count(); i += 2)
+		{
+			int header = qrfs[i];
+			int handle = header & 255;
+			vector position = UnpackPosition(qrfs[i + 1]);
+			handles.Insert(handle);
+			
+			RBL_QRFTrack track = m_mQRFTracks.Get(handle);
+			if (!track)
+			{
+				track = new RBL_QRFTrack(handle, position);
+				m_mQRFTracks.Set(handle, track);
+			}
+			else
+			{
+				track.AddSample(position, m_fSinceQRFSample);
+			}
+			
+			track.QRFType = (header >> 8) & 15;
+			track.TargetZoneID = "";
+			if (zoneMgr)
+			{
+				RBL_VirtualZone zone = zoneMgr.GetVirtualZoneByHandle(((header >> 12) & 4095) - 1);
+				if (zone)
+					track.TargetZoneID = zone.GetZoneID();
+			}
+		}
+		
+		for (int t = m_mQRFTracks.Count() - 1; t >= 0; t--)
+		{
+			if (handles.Find(m_mQRFTracks.GetKey(t)) == -1)
+				m_mQRFTracks.RemoveElement(t);
+		}
+		m_fSinceQRFSample = 0;
+	}
+	
+	void ReceiveSuspicion(int playerID, int sequence, int level)
+	{
+		if (sequence <= m_iLastSuspicionSequence)
+			return;
+		m_iLastSuspicionSequence = sequence;
+		
+		RBL_UndercoverSystem undercover = RBL_UndercoverSystem.GetInstance();
+		if (undercover)
+			undercover.SetSuspicionLevel(playerID, FromByte(level, 1.0));
+	}
+	
+	protected void UpdateClient(float timeSlice)
+	{
+		m_fSinceReceived += timeSlice;
+		
+		if (m_fSinceReceived < RBL_Config.TRANSIENT_STALE_TIME)
+			return;
+		
+		if (m_aCaptureZones.IsEmpty() && m_mQRFTracks.IsEmpty())
+			return;
+		
+		ApplyCaptures(new array<int>());
+		m_mQRFTracks.Clear();
+	}
+	
+	// ========================================================================
+	// GETTERS
+	// ========================================================================
+	
+	map<int, ref RBL_QRFTrack> GetQRFTracks() { return m_mQRFTracks; }
+	int GetPacketsSent() { return m_iPacketsSent; }
+	int GetPacketsReceived() { return m_iPacketsReceived; }
+	int GetPacketsSkipped() { return m_iPacketsSkipped; }
+	int GetLastSequence() { return Math.Max(m_iSequence, m_iLastReceived); }
+}
+
+// ============================================================================
+// DEBUG COMMANDS
+// ============================================================================
+class RBL_TransientChannelCommands
+{
+	static void PrintStats()
+	{
+		RBL_TransientChannel channel = RBL_TransientChannel.GetInstance();
+		PrintFormat("[RBL_Transient] Sent: %1, received: %2, out of order: %3, sequence: %4",
+			channel.GetPacketsSent(), channel.GetPacketsReceived(), channel.GetPacketsSkipped(), channel.GetLastSequence());
+		PrintFormat("[RBL_Transient] QRF tracks: %1", channel.GetQRFTracks().Count());
+	}
+	
+	// Round-trip a position through the 16-bit grid
+	static void TestQuantize(vector position)
+	{
+		vector restored = RBL_TransientChannel.UnpackPosition(RBL_TransientChannel.PackPosition(position));
+		PrintFormat("[RBL_Transient] %1 -> %2 (error %3 m)", position, restored,
+			vector.DistanceXZ(position, restored));
+	}
+}
@@ -20,6 +20,16 @@ class RBL_AutoSaveManager
 	protected bool m_bIsSaving;
 	protected int m_iAutoSaveCount;
 	protected float m_fLastSaveTime;
+	protected string m_sPendingReason;
+	
+	// State version of the last written autosave and of the one being
+	// collected; interval saves are skipped while nothing has changed
+	protected int m_iLastSavedVersion;
+	protected int m_iCollectingVersion;
+	protected int m_iSkippedCount;
+	
+	// Autosaves are collected over several frames, then written at once
+	protected ref RBL_SaveCollector m_Collector;
 	
 	// Callbacks
 	protected ref ScriptInvoker m_OnAutoSaveStart;
@@ -54,6 +64,11 @@ class RBL_AutoSaveManager
 		m_bIsSaving = false;
 		m_iAutoSaveCount = 0;
 		m_fLastSaveTime = 0;
+		m_sPendingReason = "";
+		m_iLastSavedVersion = -1;
+		m_iCollectingVersion = -1;
+		m_iSkippedCount = 0;
+		m_Collector = new RBL_SaveCollector();
 		
 		m_OnAutoSaveStart = new ScriptInvoker();
 		m_OnAutoSaveComplete = new ScriptInvoker();
@@ -69,58 +84,100 @@ class RBL_AutoSaveManager
 	
 	void Update(float timeSlice)
 	{
+		// Advance an in-progress collection before anything else
+		if (m_Collector.IsCollecting())
+		{
+			if (m_Collector.Step())
+				WriteCollectedSave();
+			return;
+		}
+		
 		if (!m_bAutoSaveEnabled || m_bIsSaving)
 			return;
 		
 		m_fTimeSinceLastSave += timeSlice;
 		
 		// Check if interval elapsed
-		if (m_fTimeSinceLastSave >= m_fAutoSaveInterval)
+		if (m_fTimeSinceLastSave < m_fAutoSaveInterval)
+			return;
+		
+		// Play time alone does not warrant a rewrite of an identical campaign
+		if (RBL_StateVersion.Get() == m_iLastSavedVersion)
 		{
-			TriggerAutoSave("Interval");
+			m_fTimeSinceLastSave = 0;
+			m_iSkippedCount++;
+			PrintFormat("[RBL_AutoSave] No state changes since last autosave, skipping (version %1)", m_iLastSavedVersion);
+			return;
 		}
+		
+		TriggerAutoSave("Interval");
 	}
 	
 	// ========================================================================
 	// AUTOSAVE TRIGGERS
 	// ========================================================================
 	
-	// Manual trigger
-	void TriggerAutoSave(string reason)
+	// Manual trigger. Immediate saves collect and write in this frame, for
+	// when there will not be further frames (game end)
+	void TriggerAutoSave(string reason, bool immediate = false)
 	{
-		if (m_bIsSaving)
+		if (m_bIsSaving && !immediate)
 		{
 			PrintFormat("[RBL_AutoSave] Already saving, skipping trigger: %1", reason);
 			return;
 		}
 		
-		PrintFormat("[RBL_AutoSave] Triggering autosave: %1", reason);
+		if (m_bIsSaving)
+		{
+			// No later frames will finish the running collection; start it
+			// over so this save reflects the state right now
+			PrintFormat("[RBL_AutoSave] Restarting in-progress save as immediate: %1", reason);
+			m_Collector.Cancel();
+		}
+		else
+		{
+			PrintFormat("[RBL_AutoSave] Triggering autosave: %1", reason);
+			
+			m_bIsSaving = true;
+			m_OnAutoSaveStart.Invoke(reason);
+		}
+		
+		// Collection is spread over the next frames; see Update()
+		m_sPendingReason = reason;
+		m_iCollectingVersion = RBL_StateVersion.Get();
+		if (!m_Collector.Begin(CreateSaveHeader()))
+		{
+			FailAutoSave("Failed to start save collection");
+			return;
+		}
 		
-		m_bIsSaving = true;
-		m_OnAutoSaveStart.Invoke(reason);
+		if (!immediate)
+			return;
 		
-		// Collect save data
-		RBL_SaveData saveData = CollectFullSaveData();
+		while (!m_Collector.Step())
+		{
+		}
+		WriteCollectedSave();
+	}
+	
+	// Serialize and write once collection has finished
+	protected void WriteCollectedSave()
+	{
+		RBL_SaveData saveData = m_Collector.TakeResult();
 		if (!saveData)
 		{
 			FailAutoSave("Failed to collect save data");
 			return;
 		}
 		
+		PrintFormat("[RBL_AutoSave] Collected save over %1 frames (%2)", m_Collector.GetLastFrameCount(), m_sPendingReason);
+		
 		// Get autosave filename
 		string filename = GetAutoSaveFilename();
 		
-		// Serialize
-		string json = RBL_SaveSerializer.SerializeToJson(saveData);
-		if (json.IsEmpty())
-		{
-			FailAutoSave("Serialization failed");
-			return;
-		}
-		
-		// Write to file
+		// Serialize straight to file
 		RBL_SaveFileManager fileMgr = RBL_SaveFileManager.GetInstance();
-		bool success = fileMgr.WriteToFile(filename, json);
+		bool success = fileMgr.WriteSaveData(filename, saveData);
 		
 		if (success)
 		{
@@ -132,14 +189,14 @@ class RBL_AutoSaveManager
 		}
 	}
 	
-	// Event-triggered saves
+	// Event-triggered saves. The journal already holds the change, so these
+	// only force it to disk instead of rewriting the whole campaign
 	void OnZoneCaptured(string zoneID)
 	{
 		if (!m_bSaveOnZoneCapture)
 			return;
 		
-		// Delay slightly to ensure zone state is updated
-		GetGame().GetCallqueue().CallLater(DelayedTrigger, 1000, false, "Zone captured: " + zoneID);
+		RBL_SaveJournal.GetInstance().Flush();
 	}
 	
 	void OnMissionCompleted(string missionID)
@@ -147,7 +204,7 @@ class RBL_AutoSaveManager
 		if (!m_bSaveOnMissionComplete)
 			return;
 		
-		GetGame().GetCallqueue().CallLater(DelayedTrigger, 1000, false, "Mission complete: " + missionID);
+		RBL_SaveJournal.GetInstance().Flush();
 	}
 	
 	void OnPlayerJoined(int playerId)
@@ -155,12 +212,7 @@ class RBL_AutoSaveManager
 		if (!m_bSaveOnPlayerJoin)
 			return;
 		
-		GetGame().GetCallqueue().CallLater(DelayedTrigger, 2000, false, "Player joined");
-	}
-	
-	protected void DelayedTrigger(string reason)
-	{
-		TriggerAutoSave(reason);
+		RBL_SaveJournal.GetInstance().Flush();
 	}
 	
 	// ========================================================================
@@ -172,10 +224,14 @@ class RBL_AutoSaveManager
 		m_bIsSaving = false;
 		m_fTimeSinceLastSave = 0;
 		m_iAutoSaveCount++;
+		m_iLastSavedVersion = m_iCollectingVersion;
 		m_fLastSaveTime = GetGame().GetWorld().GetWorldTime();
 		
 		PrintFormat("[RBL_AutoSave] AutoSave complete: %1", filename);
 		
+		// Every autosave is a journal compaction point
+		RBL_SaveJournal.GetInstance().OnSnapshotWritten(filename);
+		
 		m_OnAutoSaveComplete.Invoke(filename);
 		
 		// Show notification
@@ -209,38 +265,26 @@ class RBL_AutoSaveManager
 	// DATA COLLECTION
 	// ========================================================================
 	
-	protected RBL_SaveData CollectFullSaveData()
+	// Header only; the collector fills in the rest
+	protected RBL_SaveData CreateSaveHeader()
 	{
 		RBL_SaveData saveData = new RBL_SaveData();
 		
-		// Header
 		saveData.m_sMagic = RBL_SAVE_MAGIC;
 		saveData.m_iVersion = RBL_SAVE_VERSION;
 		saveData.m_sSaveTime = GetCurrentTimestamp();
 		saveData.m_sPlayerId = GetHostPlayerUID();
 		saveData.m_sWorldName = GetWorldName();
 		
-		// Campaign state
-		saveData.m_Campaign = RBL_CampaignPersistence.GetInstance().CollectCampaignState();
-		
-		// Zones
-		saveData.m_aZones = RBL_ZonePersistence.GetInstance().CollectAllZoneStates();
-		
-		// Economy
-		saveData.m_Economy = RBL_EconomyPersistence.GetInstance().CollectEconomyState();
-		
-		// Players
-		saveData.m_aPlayers = RBL_PlayerPersistence.GetInstance().CollectAllPlayerStates();
-		
-		// Commander AI
-		saveData.m_Commander = RBL_CampaignPersistence.GetInstance().CollectCommanderState();
-		
-		// Missions
-		saveData.m_aMissions = RBL_CampaignPersistence.GetInstance().CollectActiveMissions();
-		
 		return saveData;
 	}
 	
+	// Single-frame collection for saves the player asked for
+	protected RBL_SaveData CollectFullSaveData()
+	{
+		return m_Collector.CollectImmediate(CreateSaveHeader());
+	}
+	
 	// ========================================================================
 	// AUTOSAVE ROTATION
 	// ========================================================================
@@ -322,11 +366,7 @@ class RBL_AutoSaveManager
 		if (!saveData)
 			return false;
 		
-		string json = RBL_SaveSerializer.SerializeToJson(saveData);
-		if (json.IsEmpty())
-			return false;
-		
-		bool success = RBL_SaveFileManager.GetInstance().WriteQuicksave(json);
+		bool success = RBL_SaveFileManager.GetInstance().WriteQuicksaveData(saveData);
 		
 		if (success)
 		{
@@ -349,11 +389,7 @@ class RBL_AutoSaveManager
 			return false;
 		}
 		
-		string json = RBL_SaveFileManager.GetInstance().ReadQuicksave();
-		if (json.IsEmpty())
-			return false;
-		
-		RBL_SaveData saveData = RBL_SaveSerializer.DeserializeFromJson(json);
+		RBL_SaveData saveData = RBL_SaveFileManager.GetInstance().LoadQuicksave();
 		if (!saveData)
 			return false;
 		
@@ -444,6 +480,8 @@ class RBL_AutoSaveManager
 	bool IsSaving() { return m_bIsSaving; }
 	float GetTimeSinceLastSave() { return m_fTimeSinceLastSave; }
 	int GetAutoSaveCount() { return m_iAutoSaveCount; }
+	int GetSkippedCount() { return m_iSkippedCount; }
+	int GetLastSavedVersion() { return m_iLastSavedVersion; }
 	
 	// Event accessors
 	ScriptInvoker GetOnAutoSaveStart() { return m_OnAutoSaveStart; }
@@ -0,0 +1,911 @@
+// ============================================================================
+// PROJECT REBELLION - Binary Save Serializer
+// Compact versioned binary format for RBL_SaveData
+// Layout: header, string table, fixed-width record sections, string-list
+// sections, trailing checksum. All strings are stored once in the table and
+// referenced by index everywhere else
+// Object sections start with a presence field; a null section is written as
+// absent and read back as its defaults, as the JSON reader does. Null array
+// elements are skipped
+// ============================================================================
+
+class RBL_SaveStringTable
+{
+	protected ref map<string, int> m_mIndex;
+	protected ref array<string> m_aStrings;
+	
+	void RBL_SaveStringTable()
+	{
+		m_mIndex = new map<string, int>();
+		m_aStrings = new array<string>();
+	}
+	
+	int Intern(string value)
+	{
+		int index;
+		if (m_mIndex.Find(value, index))
+			return index;
+		
+		index = m_aStrings.Insert(value);
+		m_mIndex.Set(value, index);
+		return index;
+	}
+	
+	void InternAll(array<string> values)
+	{
+		if (!values)
+			return;
+		
+		for (int i = 0; i < values.Count(); i++)
+		{
+			Intern(values[i]);
+		}
+	}
+	
+	void Add(string value)
+	{
+		m_aStrings.Insert(value);
+	}
+	
+	string Get(int index)
+	{
+		if (index < 0 || index >= m_aStrings.Count())
+			return "";
+		return m_aStrings[index];
+	}
+	
+	int Count() { return m_aStrings.Count(); }
+}
+
+// ============================================================================
+// BINARY WRITER / READER - 4-byte fields with a running checksum
+// ============================================================================
+class RBL_BinarySaveWriter
+{
+	protected FileHandle m_File;
+	protected int m_iChecksum;
+	protected int m_iBytes;
+	
+	void RBL_BinarySaveWriter(FileHandle file)
+	{
+		m_File = file;
+		m_iChecksum = RBL_BinarySaveSerializer.CHECKSUM_SEED;
+		m_iBytes = 0;
+	}
+	
+	void WriteInt(int value)
+	{
+		m_File.Write(value, 4);
+		m_iBytes += 4;
+		m_iChecksum = RBL_BinarySaveSerializer.FoldChecksum(m_iChecksum, value);
+	}
+	
+	void WriteFloat(float value)
+	{
+		m_File.Write(value, 4);
+		m_iBytes += 4;
+		m_iChecksum = RBL_BinarySaveSerializer.FoldChecksum(m_iChecksum, RBL_BinarySaveSerializer.QuantizeForChecksum(value));
+	}
+	
+	void WriteVector(vector value)
+	{
+		WriteFloat(value[0]);
+		WriteFloat(value[1]);
+		WriteFloat(value[2]);
+	}
+	
+	void WriteString(string value)
+	{
+		int length = value.Length();
+		WriteInt(length);
+		if (length == 0)
+			return;
+		
+		m_File.Write(value, length);
+		m_iBytes += length;
+		m_iChecksum = RBL_BinarySaveSerializer.FoldChecksum(m_iChecksum, value.Hash());
+	}
+	
+	// Checksum itself is not folded
+	void WriteChecksum()
+	{
+		int checksum = m_iChecksum;
+		m_File.Write(checksum, 4);
+		m_iBytes += 4;
+	}
+	
+	int GetBytesWritten() { return m_iBytes; }
+}
+
+class RBL_BinarySaveReader
+{
+	protected FileHandle m_File;
+	protected int m_iChecksum;
+	protected bool m_bFailed;
+	
+	void RBL_BinarySaveReader(FileHandle file)
+	{
+		m_File = file;
+		m_iChecksum = RBL_BinarySaveSerializer.CHECKSUM_SEED;
+		m_bFailed = false;
+	}
+	
+	int ReadInt()
+	{
+		int value = 0;
+		if (m_bFailed || m_File.Read(value, 4) < 4)
+		{
+			m_bFailed = true;
+			return 0;
+		}
+		
+		m_iChecksum = RBL_BinarySaveSerializer.FoldChecksum(m_iChecksum, value);
+		return value;
+	}
+	
+	float ReadFloat()
+	{
+		float value = 0;
+		if (m_bFailed || m_File.Read(value, 4) < 4)
+		{
+			m_bFailed = true;
+			return 0;
+		}
+		
+		m_iChecksum = RBL_BinarySaveSerializer.FoldChecksum(m_iChecksum, RBL_BinarySaveSerializer.QuantizeForChecksum(value));
+		return value;
+	}
+	
+	vector ReadVector()
+	{
+		float x = ReadFloat();
+		float y = ReadFloat();
+		float z = ReadFloat();
+		return Vector(x, y, z);
+	}
+	
+	string ReadString()
+	{
+		int length = ReadInt();
+		if (length <= 0 || m_bFailed)
+			return "";
+		
+		string value;
+		if (m_File.Read(value, length) < length)
+		{
+			m_bFailed = true;
+			return "";
+		}
+		
+		m_iChecksum = RBL_BinarySaveSerializer.FoldChecksum(m_iChecksum, value.Hash());
+		return value;
+	}
+	
+	// True if the stored checksum matches everything read so far
+	bool VerifyChecksum()
+	{
+		int expected = m_iChecksum;
+		int stored = 0;
+		if (m_bFailed || m_File.Read(stored, 4) < 4)
+			return false;
+		
+		return stored == expected;
+	}
+	
+	bool HasFailed() { return m_bFailed; }
+}
+
+// ============================================================================
+// BINARY SAVE SERIALIZER
+// ============================================================================
+class RBL_BinarySaveSerializer
+{
+	// "RBLB" little-endian
+	static const int BINARY_MAGIC = 0x424C4252;
+	static const int FORMAT_VERSION = 1;
+	static const int CHECKSUM_SEED = 0x2B5F3C1D;
+	protected static const int CHECKSUM_PRIME = 16777619;
+	
+	// Record flag bits
+	protected static const int FLAG_UNDER_ATTACK = 1;
+	protected static const int FLAG_CONTESTED = 2;
+	protected static const int FLAG_DESTROYED = 4;
+	protected static const int FLAG_DEPLOYED = 1;
+	protected static const int FLAG_ACTIVE = 1;
+	protected static const int FLAG_COMPLETED = 2;
+	protected static const int FLAG_FAILED = 4;
+	
+	static int FoldChecksum(int checksum, int value)
+	{
+		return (checksum ^ value) * CHECKSUM_PRIME;
+	}
+	
+	static int QuantizeForChecksum(float value)
+	{
+		return Math.Round(value * 16);
+	}
+	
+	// ========================================================================
+	// WRITE
+	// ========================================================================
+	
+	// Returns bytes written, or -1 on failure
+	static int WriteToFile(RBL_SaveData saveData, FileHandle file)
+	{
+		if (!saveData || !file)
+			return -1;
+		
+		RBL_SaveStringTable table = new RBL_SaveStringTable();
+		CollectStrings(saveData, table);
+		
+		RBL_BinarySaveWriter writer = new RBL_BinarySaveWriter(file);
+		writer.WriteInt(BINARY_MAGIC);
+		writer.WriteInt(FORMAT_VERSION);
+		writer.WriteInt(saveData.m_iVersion);
+		
+		// String table
+		writer.WriteInt(table.Count());
+		for (int i = 0; i < table.Count(); i++)
+		{
+			writer.WriteString(table.Get(i));
+		}
+		
+		// Header
+		writer.WriteInt(table.Intern(saveData.m_sMagic));
+		writer.WriteInt(table.Intern(saveData.m_sSaveTime));
+		writer.WriteInt(table.Intern(saveData.m_sPlayerId));
+		writer.WriteInt(table.Intern(saveData.m_sWorldName));
+		
+		if (WritePresence(writer, saveData.m_Campaign))
+			WriteCampaign(writer, table, saveData.m_Campaign);
+		WriteZones(writer, table, saveData.m_aZones);
+		if (WritePresence(writer, saveData.m_Economy))
+			WriteEconomy(writer, table, saveData.m_Economy);
+		WritePlayers(writer, table, saveData.m_aPlayers);
+		if (WritePresence(writer, saveData.m_Commander))
+			WriteCommander(writer, table, saveData.m_Commander);
+		WriteMissions(writer, table, saveData.m_aMissions);
+		
+		writer.WriteChecksum();
+		return writer.GetBytesWritten();
+	}
+	
+	protected static void CollectStrings(RBL_SaveData saveData, RBL_SaveStringTable table)
+	{
+		table.Intern(saveData.m_sMagic);
+		table.Intern(saveData.m_sSaveTime);
+		table.Intern(saveData.m_sPlayerId);
+		table.Intern(saveData.m_sWorldName);
+		
+		RBL_CampaignSaveData campaign = saveData.m_Campaign;
+		if (campaign)
+		{
+			table.Intern(campaign.m_sStartDate);
+			table.Intern(campaign.m_sLastPlayDate);
+		}
+		
+		if (saveData.m_aZones)
+		{
+			foreach (RBL_ZoneSaveData zone : saveData.m_aZones)
+			{
+				if (!zone)
+					continue;
+				
+				table.Intern(zone.m_sZoneID);
+				table.Intern(zone.m_sZoneName);
+				table.InternAll(zone.m_aGarrisonUnitTypes);
+			}
+		}
+		
+		RBL_EconomySaveData economy = saveData.m_Economy;
+		if (economy)
+		{
+			if (economy.m_aArsenalItems)
+			{
+				foreach (RBL_ArsenalItemSave item : economy.m_aArsenalItems)
+				{
+					if (item)
+						table.Intern(item.m_sItemID);
+				}
+			}
+			table.InternAll(economy.m_aUnlockedItems);
+			if (economy.m_aVehiclePool)
+			{
+				foreach (RBL_VehicleSave vehicle : economy.m_aVehiclePool)
+				{
+					if (!vehicle)
+						continue;
+					
+					table.Intern(vehicle.m_sVehicleID);
+					table.Intern(vehicle.m_sVehicleType);
+				}
+			}
+		}
+		
+		if (saveData.m_aPlayers)
+		{
+			foreach (RBL_PlayerSaveData player : saveData.m_aPlayers)
+			{
+				if (!player)
+					continue;
+				
+				table.Intern(player.m_sPlayerUID);
+				table.Intern(player.m_sPlayerName);
+				table.InternAll(player.m_aUnlocks);
+				table.InternAll(player.m_aAchievements);
+				table.InternAll(player.m_aInventoryItems);
+			}
+		}
+		
+		RBL_CommanderSaveData commander = saveData.m_Commander;
+		if (commander)
+		{
+			table.Intern(commander.m_sHighestThreatZone);
+			if (commander.m_aActiveOperations)
+			{
+				foreach (RBL_OperationSave op : commander.m_aActiveOperations)
+				{
+					if (!op)
+						continue;
+					
+					table.Intern(op.m_sOperationID);
+					table.Intern(op.m_sTargetZone);
+				}
+			}
+			table.InternAll(commander.m_aKnownPlayerPositions);
+			table.InternAll(commander.m_aRecentlyAttackedZones);
+		}
+		
+		if (saveData.m_aMissions)
+		{
+			foreach (RBL_MissionSaveData mission : saveData.m_aMissions)
+			{
+				if (!mission)
+					continue;
+				
+				table.Intern(mission.m_sMissionID);
+				table.Intern(mission.m_sMissionType);
+				table.Intern(mission.m_sMissionName);
+				table.Intern(mission.m_sTargetZone);
+				table.InternAll(mission.m_aItemRewards);
+			}
+		}
+	}
+	
+	// Presence field of an object section; true if the section follows
+	protected static bool WritePresence(RBL_BinarySaveWriter writer, Managed section)
+	{
+		if (!section)
+		{
+			writer.WriteInt(0);
+			return false;
+		}
+		
+		writer.WriteInt(1);
+		return true;
+	}
+	
+	protected static void WriteStringList(RBL_BinarySaveWriter writer, RBL_SaveStringTable table, array<string> values)
+	{
+		if (!values)
+		{
+			writer.WriteInt(0);
+			return;
+		}
+		
+		writer.WriteInt(values.Count());
+		for (int i = 0; i < values.Count(); i++)
+		{
+			writer.WriteInt(table.Intern(values[i]));
+		}
+	}
+	
+	protected static void WriteCampaign(RBL_BinarySaveWriter writer, RBL_SaveStringTable table, RBL_CampaignSaveData campaign)
+	{
+		writer.WriteInt(campaign.m_iWarLevel);
+		writer.WriteInt(campaign.m_iAggression);
+		writer.WriteInt(campaign.m_iCivilianSupport);
+		writer.WriteFloat(campaign.m_fTotalPlayTime);
+		writer.WriteInt(campaign.m_iGameDays);
+		writer.WriteFloat(campaign.m_fCurrentDayTime);
+		writer.WriteInt(campaign.m_iAlertState);
+		writer.WriteFloat(campaign.m_fAlertDecayTimer);
+		writer.WriteInt(campaign.m_iZonesCaptured);
+		writer.WriteInt(campaign.m_iZonesLost);
+		writer.WriteInt(campaign.m_iEnemiesKilled);
+		writer.WriteInt(campaign.m_iFriendliesLost);
+		writer.WriteInt(table.Intern(campaign.m_sStartDate));
+		writer.WriteInt(table.Intern(campaign.m_sLastPlayDate));
+	}
+	
+	protected static void WriteZones(RBL_BinarySaveWriter writer, RBL_SaveStringTable table, array<ref RBL_ZoneSaveData> zones)
+	{
+		array<RBL_ZoneSaveData> present = new array<RBL_ZoneSaveData>();
+		if (zones)
+		{
+			foreach (RBL_ZoneSaveData entry : zones)
+			{
+				if (entry)
+					present.Insert(entry);
+			}
+		}
+		writer.WriteInt(present.Count());
+		
+		// Fixed-width records
+		foreach (RBL_ZoneSaveData zone : present)
+		{
+			int flags = 0;
+			if (zone.m_bIsUnderAttack)
+				flags |= FLAG_UNDER_ATTACK;
+			if (zone.m_bIsContested)
+				flags |= FLAG_CONTESTED;
+			if (zone.m_bIsDestroyed)
+				flags |= FLAG_DESTROYED;
+			
+			writer.WriteInt(table.Intern(zone.m_sZoneID));
+			writer.WriteInt(table.Intern(zone.m_sZoneName));
+			writer.WriteInt(zone.m_iZoneType);
+			writer.WriteVector(zone.m_vPosition);
+			writer.WriteInt(zone.m_iOwnerFaction);
+			writer.WriteInt(zone.m_iPreviousOwner);
+			writer.WriteInt(zone.m_iGarrisonStrength);
+			writer.WriteInt(zone.m_iMaxGarrison);
+			writer.WriteInt(zone.m_iSupportLevel);
+			writer.WriteInt(zone.m_iSupportTrend);
+			writer.WriteFloat(zone.m_fCaptureProgress);
+			writer.WriteInt(zone.m_iCapturingFaction);
+			writer.WriteInt(zone.m_iResourceOutput);
+			writer.WriteFloat(zone.m_fResourceTimer);
+			writer.WriteInt(flags);
+			writer.WriteFloat(zone.m_fLastCaptureTime);
+			writer.WriteFloat(zone.m_fLastAttackTime);
+		}
+		
+		// Variable-length lists
+		foreach (RBL_ZoneSaveData zone : present)
+		{
+			WriteStringList(writer, table, zone.m_aGarrisonUnitTypes);
+		}
+	}
+	
+	protected static void WriteEconomy(RBL_BinarySaveWriter writer, RBL_SaveStringTable table, RBL_EconomySaveData economy)
+	{
+		writer.WriteInt(economy.m_iFIAMoney);
+		writer.WriteInt(economy.m_iFIAHumanResources);
+		writer.WriteInt(economy.m_iFIAFuel);
+		writer.WriteInt(economy.m_iFIAAmmo);
+		writer.WriteInt(economy.m_iMoneyPerMinute);
+		writer.WriteInt(economy.m_iHRPerMinute);
+		writer.WriteInt(economy.m_iTotalMoneyEarned);
+		writer.WriteInt(economy.m_iTotalMoneySpent);
+		writer.WriteInt(economy.m_iTotalItemsBought);
+		writer.WriteInt(economy.m_iTotalItemsSold);
+		
+		array<RBL_ArsenalItemSave> items = new array<RBL_ArsenalItemSave>();
+		if (economy.m_aArsenalItems)
+		{
+			foreach (RBL_ArsenalItemSave entry : economy.m_aArsenalItems)
+			{
+				if (entry)
+					items.Insert(entry);
+			}
+		}
+		writer.WriteInt(items.Count());
+		foreach (RBL_ArsenalItemSave item : items)
+		{
+			writer.WriteInt(table.Intern(item.m_sItemID));
+			writer.WriteInt(item.m_iQuantity);
+		}
+		
+		WriteStringList(writer, table, economy.m_aUnlockedItems);
+		
+		array<RBL_VehicleSave> vehicles = new array<RBL_VehicleSave>();
+		if (economy.m_aVehiclePool)
+		{
+			foreach (RBL_VehicleSave pooled : economy.m_aVehiclePool)
+			{
+				if (pooled)
+					vehicles.Insert(pooled);
+			}
+		}
+		writer.WriteInt(vehicles.Count());
+		foreach (RBL_VehicleSave vehicle : vehicles)
+		{
+			int flags = 0;
+			if (vehicle.m_bIsDeployed)
+				flags |= FLAG_DEPLOYED;
+			
+			writer.WriteInt(table.Intern(vehicle.m_sVehicleID));
+			writer.WriteInt(table.Intern(vehicle.m_sVehicleType));
+			writer.WriteFloat(vehicle.m_fFuel);
+			writer.WriteFloat(vehicle.m_fHealth);
+			writer.WriteInt(flags);
+			writer.WriteVector(vehicle.m_vPosition);
+		}
+	}
+	
+	protected static void WritePlayers(RBL_BinarySaveWriter writer, RBL_SaveStringTable table, array<ref RBL_PlayerSaveData> players)
+	{
+		array<RBL_PlayerSaveData> present = new array<RBL_PlayerSaveData>();
+		if (players)
+		{
+			foreach (RBL_PlayerSaveData entry : players)
+			{
+				if (entry)
+					present.Insert(entry);
+			}
+		}
+		writer.WriteInt(present.Count());
+		
+		foreach (RBL_PlayerSaveData player : present)
+		{
+			writer.WriteInt(table.Intern(player.m_sPlayerUID));
+			writer.WriteInt(table.Intern(player.m_sPlayerName));
+			writer.WriteInt(player.m_iMoney);
+			writer.WriteInt(player.m_iHumanResources);
+			writer.WriteInt(player.m_iKills);
+			writer.WriteInt(player.m_iDeaths);
+			writer.WriteInt(player.m_iZonesCaptured);
+			writer.WriteInt(player.m_iMissionsCompleted);
+			writer.WriteFloat(player.m_fPlayTime);
+			writer.WriteInt(player.m_iRank);
+			writer.WriteInt(player.m_iExperience);
+			writer.WriteVector(player.m_vLastPosition);
+			writer.WriteFloat(player.m_fLastDirection);
+			writer.WriteInt(player.m_iCoverStatus);
+			writer.WriteFloat(player.m_fSuspicionLevel);
+		}
+		
+		foreach (RBL_PlayerSaveData player : present)
+		{
+			WriteStringList(writer, table, player.m_aUnlocks);
+			WriteStringList(writer, table, player.m_aAchievements);
+			WriteStringList(writer, table, player.m_aInventoryItems);
+		}
+	}
+	
+	protected static void WriteCommander(RBL_BinarySaveWriter writer, RBL_SaveStringTable table, RBL_CommanderSaveData commander)
+	{
+		writer.WriteInt(commander.m_iCommanderResources);
+		writer.WriteInt(commander.m_iReinforcementPool);
+		writer.WriteInt(commander.m_iThreatLevel);
+		writer.WriteInt(table.Intern(commander.m_sHighestThreatZone));
+		writer.WriteFloat(commander.m_fQRFCooldown);
+		writer.WriteFloat(commander.m_fPatrolCooldown);
+		writer.WriteFloat(commander.m_fOffensiveCooldown);
+		
+		array<RBL_OperationSave> operations = new array<RBL_OperationSave>();
+		if (commander.m_aActiveOperations)
+		{
+			foreach (RBL_OperationSave entry : commander.m_aActiveOperations)
+			{
+				if (entry)
+					operations.Insert(entry);
+			}
+		}
+		writer.WriteInt(operations.Count());
+		foreach (RBL_OperationSave op : operations)
+		{
+			writer.WriteInt(table.Intern(op.m_sOperationID));
+			writer.WriteInt(op.m_iOperationType);
+			writer.WriteInt(table.Intern(op.m_sTargetZone));
+			writer.WriteInt(op.m_iAssignedUnits);
+			writer.WriteFloat(op.m_fStartTime);
+			writer.WriteFloat(op.m_fProgress);
+		}
+		
+		WriteStringList(writer, table, commander.m_aKnownPlayerPositions);
+		WriteStringList(writer, table, commander.m_aRecentlyAttackedZones);
+	}
+	
+	protected static void WriteMissions(RBL_BinarySaveWriter writer, RBL_SaveStringTable table, array<ref RBL_MissionSaveData> missions)
+	{
+		array<RBL_MissionSaveData> present = new array<RBL_MissionSaveData>();
+		if (missions)
+		{
+			foreach (RBL_MissionSaveData entry : missions)
+			{
+				if (entry)
+					present.Insert(entry);
+			}
+		}
+		writer.WriteInt(present.Count());
+		
+		foreach (RBL_MissionSaveData mission : present)
+		{
+			int flags = 0;
+			if (mission.m_bIsActive)
+				flags |= FLAG_ACTIVE;
+			if (mission.m_bIsCompleted)
+				flags |= FLAG_COMPLETED;
+			if (mission.m_bIsFailed)
+				flags |= FLAG_FAILED;
+			
+			writer.WriteInt(table.Intern(mission.m_sMissionID));
+			writer.WriteInt(table.Intern(mission.m_sMissionType));
+			writer.WriteInt(table.Intern(mission.m_sMissionName));
+			writer.WriteInt(table.Intern(mission.m_sTargetZone));
+			writer.WriteVector(mission.m_vTargetPosition);
+			writer.WriteFloat(mission.m_fProgress);
+			writer.WriteInt(mission.m_iObjectivesCompleted);
+			writer.WriteInt(mission.m_iTotalObjectives);
+			writer.WriteFloat(mission.m_fTimeLimit);
+			writer.WriteFloat(mission.m_fTimeRemaining);
+			writer.WriteFloat(mission.m_fStartTime);
+			writer.WriteInt(mission.m_iMoneyReward);
+			writer.WriteInt(mission.m_iHRReward);
+			writer.WriteInt(flags);
+		}
+		
+		foreach (RBL_MissionSaveData mission : present)
+		{
+			WriteStringList(writer, table, mission.m_aItemRewards);
+		}
+	}
+	
+	// ========================================================================
+	// READ
+	// ========================================================================
+	
+	static RBL_SaveData ReadFromFile(FileHandle file)
+	{
+		if (!file)
+			return null;
+		
+		RBL_BinarySaveReader reader = new RBL_BinarySaveReader(file);
+		if (reader.ReadInt() != BINARY_MAGIC)
+		{
+			PrintFormat("[RBL_BinarySave] Not a binary save file");
+			return null;
+		}
+		
+		int formatVersion = reader.ReadInt();
+		if (formatVersion > FORMAT_VERSION)
+		{
+			PrintFormat("[RBL_BinarySave] Unsupported format version %1", formatVersion);
+			return null;
+		}
+		
+		RBL_SaveData saveData = new RBL_SaveData();
+		saveData.m_iVersion = reader.ReadInt();
+		
+		// String table
+		RBL_SaveStringTable table = new RBL_SaveStringTable();
+		int stringCount = reader.ReadInt();
+		for (int i = 0; i < stringCount && !reader.HasFailed(); i++)
+		{
+			table.Add(reader.ReadString());
+		}
+		
+		// Header
+		saveData.m_sMagic = table.Get(reader.ReadInt());
+		saveData.m_sSaveTime = table.Get(reader.ReadInt());
+		saveData.m_sPlayerId = table.Get(reader.ReadInt());
+		saveData.m_sWorldName = table.Get(reader.ReadInt());
+		
+		// Absent sections keep their defaults
+		if (reader.ReadInt() != 0)
+			ReadCampaign(reader, table, saveData.m_Campaign);
+		ReadZones(reader, table, saveData.m_aZones);
+		if (reader.ReadInt() != 0)
+			ReadEconomy(reader, table, saveData.m_Economy);
+		ReadPlayers(reader, table, saveData.m_aPlayers);
+		if (reader.ReadInt() != 0)
+			ReadCommander(reader, table, saveData.m_Commander);
+		ReadMissions(reader, table, saveData.m_aMissions);
+		
+		if (!reader.VerifyChecksum())
+		{
+			PrintFormat("[RBL_BinarySave] Checksum mismatch or truncated file");
+			return null;
+		}
+		
+		if (!saveData.IsValid())
+		{
+			PrintFormat("[RBL_BinarySave] Invalid save file header");
+			return null;
+		}
+		
+		return saveData;
+	}
+	
+	protected static void ReadStringList(RBL_BinarySaveReader reader, RBL_SaveStringTable table, array<string> values)
+	{
+		values.Clear();
+		int count = reader.ReadInt();
+		for (int i = 0; i < count && !reader.HasFailed(); i++)
+		{
+			values.Insert(table.Get(reader.ReadInt()));
+		}
+	}
+	
+	protected static void ReadCampaign(RBL_BinarySaveReader reader, RBL_SaveStringTable table, RBL_CampaignSaveData campaign)
+	{
+		campaign.m_iWarLevel = reader.ReadInt();
+		campaign.m_iAggression = reader.ReadInt();
+		campaign.m_iCivilianSupport = reader.ReadInt();
+		campaign.m_fTotalPlayTime = reader.ReadFloat();
+		campaign.m_iGameDays = reader.ReadInt();
+		campaign.m_fCurrentDayTime = reader.ReadFloat();
+		campaign.m_iAlertState = reader.ReadInt();
+		campaign.m_fAlertDecayTimer = reader.ReadFloat();
+		campaign.m_iZonesCaptured = reader.ReadInt();
+		campaign.m_iZonesLost = reader.ReadInt();
+		campaign.m_iEnemiesKilled = reader.ReadInt();
+		campaign.m_iFriendliesLost = reader.ReadInt();
+		campaign.m_sStartDate = table.Get(reader.ReadInt());
+		campaign.m_sLastPlayDate = table.Get(reader.ReadInt());
+	}
+	
+	protected static void ReadZones(RBL_BinarySaveReader reader, RBL_SaveStringTable table, array<ref RBL_ZoneSaveData> zones)
+	{
+		zones.Clear();
+		int count = reader.ReadInt();
+		
+		for (int i = 0; i < count && !reader.HasFailed(); i++)
+		{
+			RBL_ZoneSaveData zone = new RBL_ZoneSaveData();
+			zone.m_sZoneID = table.Get(reader.ReadInt());
+			zone.m_sZoneName = table.Get(reader.ReadInt());
+			zone.m_iZoneType = reader.ReadInt();
+			zone.m_vPosition = reader.ReadVector();
+			zone.m_iOwnerFaction = reader.ReadInt();
+			zone.m_iPreviousOwner = reader.ReadInt();
+			zone.m_iGarrisonStrength = reader.ReadInt();
+			zone.m_iMaxGarrison = reader.ReadInt();
+			zone.m_iSupportLevel = reader.ReadInt();
+			zone.m_iSupportTrend = reader.ReadInt();
+			zone.m_fCaptureProgress = reader.ReadFloat();
+			zone.m_iCapturingFaction = reader.ReadInt();
+			zone.m_iResourceOutput = reader.ReadInt();
+			zone.m_fResourceTimer = reader.ReadFloat();
+			int flags = reader.ReadInt();
+			zone.m_bIsUnderAttack = (flags & FLAG_UNDER_ATTACK) != 0;
+			zone.m_bIsContested = (flags & FLAG_CONTESTED) != 0;
+			zone.m_bIsDestroyed = (flags & FLAG_DESTROYED) != 0;
+			zone.m_fLastCaptureTime = reader.ReadFloat();
+			zone.m_fLastAttackTime = reader.ReadFloat();
+			zones.Insert(zone);
+		}
+		
+		foreach (RBL_ZoneSaveData zone : zones)
+		{
+			ReadStringList(reader, table, zone.m_aGarrisonUnitTypes);
+		}
+	}
+	
+	protected static void ReadEconomy(RBL_BinarySaveReader reader, RBL_SaveStringTable table, RBL_EconomySaveData economy)
+	{
+		economy.m_iFIAMoney = reader.ReadInt();
+		economy.m_iFIAHumanResources = reader.ReadInt();
+		economy.m_iFIAFuel = reader.ReadInt();
+		economy.m_iFIAAmmo = reader.ReadInt();
+		economy.m_iMoneyPerMinute = reader.ReadInt();
+		economy.m_iHRPerMinute = reader.ReadInt();
+		economy.m_iTotalMoneyEarned = reader.ReadInt();
+		economy.m_iTotalMoneySpent = reader.ReadInt();
+		economy.m_iTotalItemsBought = reader.ReadInt();
+		economy.m_iTotalItemsSold = reader.ReadInt();
+		
+		economy.m_aArsenalItems.Clear();
+		int itemCount = reader.ReadInt();
+		for (int i = 0; i < itemCount && !reader.HasFailed(); i++)
+		{
+			string itemID = table.Get(reader.ReadInt());
+			int quantity = reader.ReadInt();
+			economy.m_aArsenalItems.Insert(new RBL_ArsenalItemSave(itemID, quantity));
+		}
+		
+		ReadStringList(reader, table, economy.m_aUnlockedItems);
+		
+		economy.m_aVehiclePool.Clear();
+		int vehicleCount = reader.ReadInt();
+		for (int i = 0; i < vehicleCount && !reader.HasFailed(); i++)
+		{
+			RBL_VehicleSave vehicle = new RBL_VehicleSave();
+			vehicle.m_sVehicleID = table.Get(reader.ReadInt());
+			vehicle.m_sVehicleType = table.Get(reader.ReadInt());
+			vehicle.m_fFuel = reader.ReadFloat();
+			vehicle.m_fHealth = reader.ReadFloat();
+			vehicle.m_bIsDeployed = (reader.ReadInt() & FLAG_DEPLOYED) != 0;
+			vehicle.m_vPosition = reader.ReadVector();
+			economy.m_aVehiclePool.Insert(vehicle);
+		}
+	}
+	
+	protected static void ReadPlayers(RBL_BinarySaveReader reader, RBL_SaveStringTable table, array<ref RBL_PlayerSaveData> players)
+	{
+		players.Clear();
+		int count = reader.ReadInt();
+		
+		for (int i = 0; i < count && !reader.HasFailed(); i++)
+		{
+			RBL_PlayerSaveData player = new RBL_PlayerSaveData();
+			player.m_sPlayerUID = table.Get(reader.ReadInt());
+			player.m_sPlayerName = table.Get(reader.ReadInt());
+			player.m_iMoney = reader.ReadInt();
+			player.m_iHumanResources = reader.ReadInt();
+			player.m_iKills = reader.ReadInt();
+			player.m_iDeaths = reader.ReadInt();
+			player.m_iZonesCaptured = reader.ReadInt();
+			player.m_iMissionsCompleted = reader.ReadInt();
+			player.m_fPlayTime = reader.ReadFloat();
+			player.m_iRank = reader.ReadInt();
+			player.m_iExperience = reader.ReadInt();
+			player.m_vLastPosition = reader.ReadVector();
+			player.m_fLastDirection = reader.ReadFloat();
+			player.m_iCoverStatus = reader.ReadInt();
+			player.m_fSuspicionLevel = reader.ReadFloat();
+			players.Insert(player);
+		}
+		
+		foreach (RBL_PlayerSaveData player : players)
+		{
+			ReadStringList(reader, table, player.m_aUnlocks);
+			ReadStringList(reader, table, player.m_aAchievements);
+			ReadStringList(reader, table, player.m_aInventoryItems);
+		}
+	}
+	
+	protected static void ReadCommander(RBL_BinarySaveReader reader, RBL_SaveStringTable table, RBL_CommanderSaveData commander)
+	{
+		commander.m_iCommanderResources = reader.ReadInt();
+		commander.m_iReinforcementPool = reader.ReadInt();
+		commander.m_iThreatLevel = reader.ReadInt();
+		commander.m_sHighestThreatZone = table.Get(reader.ReadInt());
+		commander.m_fQRFCooldown = reader.ReadFloat();
+		commander.m_fPatrolCooldown = reader.ReadFloat();
+		commander.m_fOffensiveCooldown = reader.ReadFloat();
+		
+		commander.m_aActiveOperations.Clear();
+		int count = reader.ReadInt();
+		for (int i = 0; i < count && !reader.HasFailed(); i++)
+		{
+			RBL_OperationSave op = new RBL_OperationSave();
+			op.m_sOperationID = table.Get(reader.ReadInt());
+			op.m_iOperationType = reader.ReadInt();
+			op.m_sTargetZone = table.Get(reader.ReadInt());
+			op.m_iAssignedUnits = reader.ReadInt();
+			op.m_fStartTime = reader.ReadFloat();
+			op.m_fProgress = reader.ReadFloat();
+			commander.m_aActiveOperations.Insert(op);
+		}
+		
+		ReadStringList(reader, table, commander.m_aKnownPlayerPositions);
+		ReadStringList(reader, table, commander.m_aRecentlyAttackedZones);
+	}
+	
+	protected static void ReadMissions(RBL_BinarySaveReader reader, RBL_SaveStringTable table, array<ref RBL_MissionSaveData> missions)
+	{
+		missions.Clear();
+		int count = reader.ReadInt();
+		
+		for (int i = 0; i < count && !reader.HasFailed(); i++)
+		{
+			RBL_MissionSaveData mission = new RBL_MissionSaveData();
+			mission.m_sMissionID = table.Get(reader.ReadInt());
+			mission.m_sMissionType = table.Get(reader.ReadInt());
+			mission.m_sMissionName = table.Get(reader.ReadInt());
+			mission.m_sTargetZone = table.Get(reader.ReadInt());
+			mission.m_vTargetPosition = reader.ReadVector();
+			mission.m_fProgress = reader.ReadFloat();
+			mission.m_iObjectivesCompleted = reader.ReadInt();
+			mission.m_iTotalObjectives = reader.ReadInt();
+			mission.m_fTimeLimit = reader.ReadFloat();
+			mission.m_fTimeRemaining = reader.ReadFloat();
+			mission.m_fStartTime = reader.ReadFloat();
+			mission.m_iMoneyReward = reader.ReadInt();
+			mission.m_iHRReward = reader.ReadInt();
+			int flags = reader.ReadInt();
+			mission.m_bIsActive = (flags & FLAG_ACTIVE) != 0;
+			mission.m_bIsCompleted = (flags & FLAG_COMPLETED) != 0;
+			mission.m_bIsFailed = (flags & FLAG_FAILED) != 0;
+			missions.Insert(mission);
+		}
+		
+		foreach (RBL_MissionSaveData mission : missions)
+		{
+			ReadStringList(reader, table, mission.m_aItemRewards);
+		}
+	}
+}
@@ -163,18 +163,7 @@ class RBL_PersistenceManager
 	
 	protected string ReadFromFile(string path)
 	{
-		FileHandle file = FileIO.OpenFile(path, FileMode.READ);
-		if (!file)
-			return "";
-		
-		string content = "";
-		string line;
-		while (file.ReadLine(line) >= 0)
-		{
-			content += line;
-		}
-		file.Close();
-		return content;
+		return RBL_FileReader.ReadAll(path);
 	}
 	
 	protected bool DeserializeFromJSON(string jsonData)
@@ -247,10 +236,7 @@ class RBL_PersistenceManager
 		
 		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
 		if (econMgr)
-		{
-			econMgr.SetMoney(m_CurrentSaveData.m_Economy.m_iFIAMoney);
-			econMgr.SetHR(m_CurrentSaveData.m_Economy.m_iFIAHumanResources);
-		}
+			econMgr.SetBalance(m_CurrentSaveData.m_Economy.m_iFIAMoney, m_CurrentSaveData.m_Economy.m_iFIAHumanResources);
 	}
 	
 	void Update(float timeSlice)
@@ -69,20 +69,14 @@ class RBL_EconomyPersistence
 		if (!econMgr)
 			return;
 		
-		// Get all items in arsenal
-		array<string> itemIDs = econMgr.GetArsenalItemIDs();
-		if (!itemIDs)
-			return;
+		// Stocked items and counts in one pass
+		array<string> itemIDs = new array<string>();
+		array<int> quantities = new array<int>();
+		econMgr.ExportArsenal(itemIDs, quantities);
 		
 		for (int i = 0; i < itemIDs.Count(); i++)
 		{
-			string itemID = itemIDs[i];
-			int quantity = econMgr.GetArsenalItemQuantity(itemID);
-			
-			if (quantity > 0)
-			{
-				outItems.Insert(new RBL_ArsenalItemSave(itemID, quantity));
-			}
+			outItems.Insert(new RBL_ArsenalItemSave(itemIDs[i], quantities[i]));
 		}
 	}
 	
@@ -152,8 +146,9 @@ class RBL_EconomyPersistence
 	// RESTORE ECONOMY DATA
 	// ========================================================================
 	
-	// Restore full economy state
-	bool RestoreEconomyState(RBL_EconomySaveData data)
+	// Restore full economy state. The restorer passes restoreVehicles = false
+	// and respawns the pool itself, a few vehicles per frame
+	bool RestoreEconomyState(RBL_EconomySaveData data, bool restoreVehicles = true)
 	{
 		if (!data)
 		{
@@ -169,8 +164,7 @@ class RBL_EconomyPersistence
 		}
 		
 		// Restore FIA resources
-		econMgr.SetMoney(data.m_iFIAMoney);
-		econMgr.SetHR(data.m_iFIAHumanResources);
+		econMgr.SetBalance(data.m_iFIAMoney, data.m_iFIAHumanResources);
 		econMgr.SetFuel(data.m_iFIAFuel);
 		econMgr.SetAmmo(data.m_iFIAAmmo);
 		
@@ -185,7 +179,8 @@ class RBL_EconomyPersistence
 		RestoreUnlockedItems(econMgr, data.m_aUnlockedItems);
 		
 		// Restore vehicles
-		RestoreVehiclePool(data.m_aVehiclePool);
+		if (restoreVehicles)
+			RestoreVehiclePool(data.m_aVehiclePool);
 		
 		// Restore trade history
 		econMgr.SetTradeHistory(
@@ -207,18 +202,20 @@ class RBL_EconomyPersistence
 		if (!econMgr || !items)
 			return;
 		
-		// Clear existing arsenal
-		econMgr.ClearArsenal();
-		
-		// Add all items
+		array<string> itemIDs = new array<string>();
+		array<int> quantities = new array<int>();
 		for (int i = 0; i < items.Count(); i++)
 		{
 			RBL_ArsenalItemSave item = items[i];
 			if (item && item.m_iQuantity > 0)
 			{
-				econMgr.AddToArsenal(item.m_sItemID, item.m_iQuantity);
+				itemIDs.Insert(item.m_sItemID);
+				quantities.Insert(item.m_iQuantity);
 			}
 		}
+		
+		// Replaces the existing arsenal
+		econMgr.ImportArsenal(itemIDs, quantities);
 	}
 	
 	// Restore unlocked items
@@ -227,14 +224,8 @@ class RBL_EconomyPersistence
 		if (!econMgr || !unlocks)
 			return;
 		
-		// Clear existing unlocks
-		econMgr.ClearUnlocks();
-		
-		// Add all unlocks
-		for (int i = 0; i < unlocks.Count(); i++)
-		{
-			econMgr.UnlockItem(unlocks[i]);
-		}
+		// Replaces the existing unlocks
+		econMgr.ImportUnlocks(unlocks);
 	}
 	
 	// Restore vehicle pool
@@ -243,28 +234,41 @@ class RBL_EconomyPersistence
 		if (!vehicles)
 			return;
 		
-		RBL_VehicleManager vehMgr = RBL_VehicleManager.GetInstance();
-		if (!vehMgr)
-			return;
-		
-		// Clear existing vehicles
-		vehMgr.DespawnAllVehicles();
+		ClearVehiclePool();
 		
 		// Spawn saved vehicles
 		for (int i = 0; i < vehicles.Count(); i++)
 		{
-			RBL_VehicleSave vehSave = vehicles[i];
-			if (!vehSave)
-				continue;
-			
-			// Only restore deployed vehicles
-			if (vehSave.m_bIsDeployed && vehSave.m_vPosition != vector.Zero)
-			{
-				vehMgr.SpawnVehicle(vehSave.m_sVehicleType, vehSave.m_vPosition, vehSave.m_fFuel, vehSave.m_fHealth);
-			}
+			RestoreVehicle(vehicles[i]);
 		}
 	}
 	
+	// Despawn every vehicle before the saved pool is respawned
+	void ClearVehiclePool()
+	{
+		RBL_VehicleManager vehMgr = RBL_VehicleManager.GetInstance();
+		if (vehMgr)
+			vehMgr.DespawnAllVehicles();
+	}
+	
+	// Respawn a single saved vehicle. Returns true if one was spawned
+	bool RestoreVehicle(RBL_VehicleSave vehSave)
+	{
+		if (!vehSave)
+			return false;
+		
+		RBL_VehicleManager vehMgr = RBL_VehicleManager.GetInstance();
+		if (!vehMgr)
+			return false;
+		
+		// Only restore deployed vehicles
+		if (!vehSave.m_bIsDeployed || vehSave.m_vPosition == vector.Zero)
+			return false;
+		
+		vehMgr.SpawnVehicle(vehSave.m_sVehicleType, vehSave.m_vPosition, vehSave.m_fFuel, vehSave.m_fHealth);
+		return true;
+	}
+	
 	// ========================================================================
 	// VALIDATION
 	// ========================================================================
@@ -475,6 +479,7 @@ class RBL_VehicleManager
 		m_mVehiclesByID.Set(vehicleID, vehicle);
 		m_mVehicleIDs.Set(vehicle, vehicleID);
 		m_mVehicleTypes.Set(vehicleID, vehicleType);
+		RBL_StateVersion.Bump();
 		
 		PrintFormat("[RBL_VehicleMgr] Registered vehicle: %1 (%2)", vehicleID, vehicleType);
 	}
@@ -487,6 +492,7 @@ class RBL_VehicleManager
 			m_mVehiclesByID.Remove(vehicleID);
 			m_mVehicleIDs.Remove(vehicle);
 			m_mVehicleTypes.Remove(vehicleID);
+			RBL_StateVersion.Bump();
 		}
 	}
 	
@@ -0,0 +1,163 @@
+// ============================================================================
+// PROJECT REBELLION - File Reader
+// Reads whole text files in fixed-size blocks sized from the file length
+// Blocks are merged pairwise, so a read costs O(n log n) string work instead
+// of the O(n^2) of appending line by line, and newlines are kept intact
+// ============================================================================
+
+class RBL_FileReader
+{
+	// Bytes requested per Read call
+	protected static const int BLOCK_SIZE = 65536;
+	
+	// Whole file as a string, or "" if it is missing or unreadable
+	static string ReadAll(string path)
+	{
+		if (!FileIO.FileExists(path))
+			return "";
+		
+		FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+		if (!file)
+			return "";
+		
+		string content = ReadHandle(file);
+		file.Close();
+		return content;
+	}
+	
+	// Read the remainder of an open file
+	static string ReadHandle(FileHandle file)
+	{
+		int remaining = file.GetLength() - file.GetPos();
+		if (remaining <= 0)
+			return "";
+		
+		array<string> blocks = new array<string>();
+		while (remaining > 0)
+		{
+			int size = Math.Min(remaining, BLOCK_SIZE);
+			string block;
+			int read = file.Read(block, size);
+			if (read <= 0)
+				break;
+			
+			blocks.Insert(block);
+			remaining -= read;
+		}
+		
+		return Join(blocks);
+	}
+	
+	// Copy a file through a single bulk read
+	static bool Copy(string sourcePath, string destPath)
+	{
+		if (!FileIO.FileExists(sourcePath))
+			return false;
+		
+		string content = ReadAll(sourcePath);
+		
+		FileHandle destFile = FileIO.OpenFile(destPath, FileMode.WRITE);
+		if (!destFile)
+			return false;
+		
+		destFile.Write(content);
+		destFile.Close();
+		return true;
+	}
+	
+	// Merge neighbouring blocks until one remains
+	static string Join(array<string> blocks)
+	{
+		if (blocks.IsEmpty())
+			return "";
+		
+		while (blocks.Count() > 1)
+		{
+			array<string> merged = new array<string>();
+			for (int i = 0; i < blocks.Count(); i += 2)
+			{
+				if (i + 1 < blocks.Count())
+					merged.Insert(blocks[i] + blocks[i + 1]);
+				else
+					merged.Insert(blocks[i]);
+			}
+			blocks = merged;
+		}
+		
+		return blocks[0];
+	}
+}
+
+// ============================================================================
+// DEBUG COMMANDS
+// ============================================================================
+class RBL_FileReaderCommands
+{
+	protected static const string BENCHMARK_PATH = "$profile:Rebellion/saves/read_benchmark.tmp";
+	
+	// Compare line-by-line concatenation against the bulk reader on 100 KB
+	// and 1 MB files
+	static void Benchmark()
+	{
+		BenchmarkSize(100 * 1024);
+		BenchmarkSize(1024 * 1024);
+		
+		if (FileIO.FileExists(BENCHMARK_PATH))
+			FileIO.DeleteFile(BENCHMARK_PATH);
+	}
+	
+	protected static void BenchmarkSize(int bytes)
+	{
+		if (!WriteBenchmarkFile(bytes))
+		{
+			PrintFormat("[RBL_FileReader] Could not write benchmark file");
+			return;
+		}
+		
+		int start = System.GetTickCount();
+		string lineContent = ReadByLines(BENCHMARK_PATH);
+		int lineMs = System.GetTickCount() - start;
+		
+		start = System.GetTickCount();
+		string bulkContent = RBL_FileReader.ReadAll(BENCHMARK_PATH);
+		int bulkMs = System.GetTickCount() - start;
+		
+		PrintFormat("[RBL_FileReader] %1 KB: lines %2 ms (%3 chars), bulk %4 ms (%5 chars)",
+			bytes / 1024, lineMs, lineContent.Length(), bulkMs, bulkContent.Length());
+	}
+	
+	// The previous read path, kept here only for comparison
+	protected static string ReadByLines(string path)
+	{
+		FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+		if (!file)
+			return "";
+		
+		string content = "";
+		string line;
+		while (file.ReadLine(line) >= 0)
+		{
+			content += line;
+		}
+		file.Close();
+		return content;
+	}
+	
+	// Lines of save-like JSON, roughly the given size
+	protected static bool WriteBenchmarkFile(int bytes)
+	{
+		FileHandle file = FileIO.OpenFile(BENCHMARK_PATH, FileMode.WRITE);
+		if (!file)
+			return false;
+		
+		string line = "{\"zoneID\":\"zone_benchmark\",\"owner\":2,\"garrison\":12,\"support\":45,\"progress\":0.5}";
+		int written = 0;
+		while (written < bytes)
+		{
+			file.WriteLine(line);
+			written += line.Length() + 1;
+		}
+		file.Close();
+		return true;
+	}
+}
@@ -0,0 +1,369 @@
+// ============================================================================
+// PROJECT REBELLION - JSON Writer
+// Streaming JSON writer with a chunked output buffer
+// Appends go into a small working chunk; full chunks are written straight to
+// an attached FileHandle, or kept for a single merge in ToString()
+// Chunks are cut at fixed CHUNK_SIZE boundaries and folded into a running
+// checksum as they go out, so ContentChecksum() over the finished text gives
+// the same value without the writer keeping the document
+// ============================================================================
+
+class RBL_JsonWriter
+{
+	// Working chunk is flushed once it reaches this many characters, which
+	// keeps every append O(chunk) instead of O(document)
+	protected const int CHUNK_SIZE = 4096;
+	
+	protected FileHandle m_File;
+	protected ref array<string> m_aChunks;
+	protected string m_sChunk;
+	protected int m_iChunkLength;
+	protected int m_iTotalLength;
+	protected int m_iChecksum;
+	
+	// One entry per open container: true once it holds at least one value
+	protected ref array<bool> m_aHasItems;
+	protected bool m_bAfterKey;
+	
+	void RBL_JsonWriter()
+	{
+		m_aChunks = new array<string>();
+		m_aHasItems = new array<bool>();
+		Reset();
+	}
+	
+	// Stream output to a file. Call Finish() before closing the handle
+	void Attach(FileHandle file)
+	{
+		m_File = file;
+	}
+	
+	// Clear all state so the writer can be reused for another document
+	void Reset()
+	{
+		m_File = null;
+		m_aChunks.Clear();
+		m_aHasItems.Clear();
+		m_sChunk = "";
+		m_iChunkLength = 0;
+		m_iTotalLength = 0;
+		m_iChecksum = RBL_BinarySaveSerializer.CHECKSUM_SEED;
+		m_bAfterKey = false;
+	}
+	
+	// ========================================================================
+	// STRUCTURE
+	// ========================================================================
+	
+	void BeginObject()
+	{
+		BeforeValue();
+		Append("{", 1);
+		m_aHasItems.Insert(false);
+	}
+	
+	void EndObject()
+	{
+		PopContainer();
+		Append("}", 1);
+	}
+	
+	void BeginArray()
+	{
+		BeforeValue();
+		Append("[", 1);
+		m_aHasItems.Insert(false);
+	}
+	
+	void EndArray()
+	{
+		PopContainer();
+		Append("]", 1);
+	}
+	
+	void Key(string name)
+	{
+		BeforeValue();
+		string token = "\"" + Escape(name) + "\":";
+		Append(token, token.Length());
+		m_bAfterKey = true;
+	}
+	
+	// ========================================================================
+	// VALUES
+	// ========================================================================
+	
+	void Int(int value)
+	{
+		BeforeValue();
+		string token = value.ToString();
+		Append(token, token.Length());
+	}
+	
+	void Float(float value)
+	{
+		BeforeValue();
+		string token = value.ToString();
+		Append(token, token.Length());
+	}
+	
+	void Bool(bool value)
+	{
+		BeforeValue();
+		if (value)
+			Append("true", 4);
+		else
+			Append("false", 5);
+	}
+	
+	void String(string value)
+	{
+		BeforeValue();
+		string token = "\"" + Escape(value) + "\"";
+		Append(token, token.Length());
+	}
+	
+	void Null()
+	{
+		BeforeValue();
+		Append("null", 4);
+	}
+	
+	// Vectors are written as a three-element array
+	void VectorValue(vector value)
+	{
+		BeforeValue();
+		string token = "[" + value[0].ToString() + "," + value[1].ToString() + "," + value[2].ToString() + "]";
+		Append(token, token.Length());
+	}
+	
+	void StringArray(array<string> values)
+	{
+		BeginArray();
+		if (values)
+		{
+			for (int i = 0; i < values.Count(); i++)
+			{
+				String(values[i]);
+			}
+		}
+		EndArray();
+	}
+	
+	// ========================================================================
+	// KEYED SHORTHANDS
+	// ========================================================================
+	
+	void IntField(string name, int value)
+	{
+		Key(name);
+		Int(value);
+	}
+	
+	void FloatField(string name, float value)
+	{
+		Key(name);
+		Float(value);
+	}
+	
+	void BoolField(string name, bool value)
+	{
+		Key(name);
+		Bool(value);
+	}
+	
+	void StringField(string name, string value)
+	{
+		Key(name);
+		String(value);
+	}
+	
+	void VectorField(string name, vector value)
+	{
+		Key(name);
+		VectorValue(value);
+	}
+	
+	void StringArrayField(string name, array<string> values)
+	{
+		Key(name);
+		StringArray(values);
+	}
+	
+	// ========================================================================
+	// OUTPUT
+	// ========================================================================
+	
+	// Write any buffered output to the attached file
+	void Finish()
+	{
+		if (m_File && m_iChunkLength > 0)
+		{
+			m_File.Write(m_sChunk);
+			m_iChecksum = RBL_BinarySaveSerializer.FoldChecksum(m_iChecksum, m_sChunk.Hash());
+			m_sChunk = "";
+			m_iChunkLength = 0;
+		}
+	}
+	
+	// Whole document as a string (only meaningful when no file is attached).
+	// Chunks are merged pairwise so the join stays O(n log n)
+	string ToString()
+	{
+		if (m_aChunks.IsEmpty())
+			return m_sChunk;
+		
+		array<string> parts = new array<string>();
+		parts.Copy(m_aChunks);
+		if (m_iChunkLength > 0)
+			parts.Insert(m_sChunk);
+		
+		while (parts.Count() > 1)
+		{
+			array<string> merged = new array<string>();
+			for (int i = 0; i < parts.Count(); i += 2)
+			{
+				if (i + 1 < parts.Count())
+					merged.Insert(parts[i] + parts[i + 1]);
+				else
+					merged.Insert(parts[i]);
+			}
+			parts = merged;
+		}
+		
+		return parts[0];
+	}
+	
+	int GetLength() { return m_iTotalLength; }
+	
+	// Checksum of everything written so far; equals ContentChecksum() of
+	// the output
+	int GetChecksum()
+	{
+		if (m_iChunkLength > 0)
+			return RBL_BinarySaveSerializer.FoldChecksum(m_iChecksum, m_sChunk.Hash());
+		return m_iChecksum;
+	}
+	
+	// Hash of each CHUNK_SIZE slice of the text, folded in order
+	static int ContentChecksum(string content)
+	{
+		int checksum = RBL_BinarySaveSerializer.CHECKSUM_SEED;
+		int length = content.Length();
+		for (int pos = 0; pos < length; pos += CHUNK_SIZE)
+		{
+			string slice = content.Substring(pos, Math.Min(CHUNK_SIZE, length - pos));
+			checksum = RBL_BinarySaveSerializer.FoldChecksum(checksum, slice.Hash());
+		}
+		return checksum;
+	}
+	
+	// ========================================================================
+	// ESCAPING
+	// ========================================================================
+	
+	protected static const string HEX_DIGITS = "0123456789abcdef";
+	
+	// Quotes, backslashes and every control character below 0x20; the
+	// common ones get their short form, the rest \u00XX
+	static string Escape(string value)
+	{
+		// Fast path: nothing to escape
+		int length = value.Length();
+		int first = 0;
+		while (first < length && !NeedsEscape(value.Get(first)))
+		{
+			first++;
+		}
+		if (first == length)
+			return value;
+		
+		string escaped = value.Substring(0, first);
+		for (int i = first; i < length; i++)
+		{
+			string c = value.Get(i);
+			if (c == "\"")
+				escaped += "\\\"";
+			else if (c == "\\")
+				escaped += "\\\\";
+			else if (c == "\n")
+				escaped += "\\n";
+			else if (c == "\r")
+				escaped += "\\r";
+			else if (c == "\t")
+				escaped += "\\t";
+			else if (IsControl(c))
+				escaped += "\\u00" + HEX_DIGITS.Get(c.ToAscii() / 16) + HEX_DIGITS.Get(c.ToAscii() % 16);
+			else
+				escaped += c;
+		}
+		return escaped;
+	}
+	
+	protected static bool NeedsEscape(string c)
+	{
+		return c == "\"" || c == "\\" || IsControl(c);
+	}
+	
+	// Bytes of multi-byte UTF-8 characters may read as negative
+	protected static bool IsControl(string c)
+	{
+		int code = c.ToAscii();
+		return code >= 0 && code < 0x20;
+	}
+	
+	// ========================================================================
+	// INTERNALS
+	// ========================================================================
+	
+	protected void BeforeValue()
+	{
+		// A value directly after its key never takes a separator
+		if (m_bAfterKey)
+		{
+			m_bAfterKey = false;
+			return;
+		}
+		
+		int depth = m_aHasItems.Count();
+		if (depth == 0)
+			return;
+		
+		if (m_aHasItems[depth - 1])
+			Append(",", 1);
+		else
+			m_aHasItems[depth - 1] = true;
+	}
+	
+	protected void PopContainer()
+	{
+		int depth = m_aHasItems.Count();
+		if (depth > 0)
+			m_aHasItems.Remove(depth - 1);
+		m_bAfterKey = false;
+	}
+	
+	protected void Append(string token, int length)
+	{
+		m_sChunk += token;
+		m_iChunkLength += length;
+		m_iTotalLength += length;
+		
+		// A long token can fill more than one chunk
+		while (m_iChunkLength >= CHUNK_SIZE)
+		{
+			string full = m_sChunk;
+			if (m_iChunkLength > CHUNK_SIZE)
+				full = m_sChunk.Substring(0, CHUNK_SIZE);
+			
+			if (m_File)
+				m_File.Write(full);
+			else
+				m_aChunks.Insert(full);
+			m_iChecksum = RBL_BinarySaveSerializer.FoldChecksum(m_iChecksum, full.Hash());
+			
+			m_iChunkLength -= CHUNK_SIZE;
+			m_sChunk = m_sChunk.Substring(CHUNK_SIZE, m_iChunkLength);
+		}
+	}
+}
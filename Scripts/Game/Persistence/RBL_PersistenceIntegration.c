@@ -17,6 +17,7 @@ class RBL_PersistenceIntegration
 	protected ref RBL_SaveSlotManager m_SlotManager;
 	protected ref RBL_SaveRestorer m_Restorer;
 	protected ref RBL_AutoSaveManager m_AutoSaveManager;
+	protected ref RBL_SaveJournal m_Journal;
 	
 	// ========================================================================
 	// SINGLETON
@@ -52,6 +53,8 @@ class RBL_PersistenceIntegration
 		m_SlotManager = RBL_SaveSlotManager.GetInstance();
 		m_Restorer = RBL_SaveRestorer.GetInstance();
 		m_AutoSaveManager = RBL_AutoSaveManager.GetInstance();
+		m_Journal = RBL_SaveJournal.GetInstance();
+		m_Journal.Initialize();
 		
 		// Register event callbacks
 		RegisterEventCallbacks();
@@ -81,6 +84,10 @@ class RBL_PersistenceIntegration
 		// Update autosave timer
 		if (m_AutoSaveManager)
 			m_AutoSaveManager.Update(timeSlice);
+		
+		// Append journal entries
+		if (m_Journal)
+			m_Journal.Update(timeSlice);
 	}
 	
 	// ========================================================================
@@ -156,6 +163,13 @@ class RBL_PersistenceIntegration
 	{
 		int lastSlot = m_SlotManager.GetLastUsedSlot();
 		
+		// A journal means the last session may have ended without a save
+		if (m_Journal.HasRecoverableJournal())
+		{
+			PrintFormat("[RBL_Persistence] Continuing from journal");
+			return RecoverFromJournal();
+		}
+		
 		if (lastSlot < 0)
 		{
 			// Try autosave
@@ -202,12 +216,31 @@ class RBL_PersistenceIntegration
 	
 	protected void DelayedContinue()
 	{
+		if (m_Journal.HasRecoverableJournal())
+		{
+			RecoverFromJournal();
+			return;
+		}
+		
 		if (m_FileManager.AutosaveExists())
 		{
 			m_Restorer.StartRestoreFromFile("autosave");
 		}
 	}
 	
+	// Base snapshot plus every journal entry written after it
+	protected bool RecoverFromJournal()
+	{
+		RBL_SaveData saveData = m_Journal.LoadRecoveryData();
+		if (!saveData)
+		{
+			PrintFormat("[RBL_Persistence] Journal recovery failed");
+			return false;
+		}
+		
+		return m_Restorer.StartRestore(saveData);
+	}
+	
 	// ========================================================================
 	// DATA COLLECTION
 	// ========================================================================
@@ -223,25 +256,9 @@ class RBL_PersistenceIntegration
 		saveData.m_sPlayerId = GetHostPlayerUID();
 		saveData.m_sWorldName = GetWorldName();
 		
-		// Campaign
-		saveData.m_Campaign = RBL_CampaignPersistence.GetInstance().CollectCampaignState();
-		
-		// Zones
-		saveData.m_aZones = RBL_ZonePersistence.GetInstance().CollectAllZoneStates();
-		
-		// Economy
-		saveData.m_Economy = RBL_EconomyPersistence.GetInstance().CollectEconomyState();
-		
-		// Players
-		saveData.m_aPlayers = RBL_PlayerPersistence.GetInstance().CollectAllPlayerStates();
-		
-		// Commander
-		saveData.m_Commander = RBL_CampaignPersistence.GetInstance().CollectCommanderState();
-		
-		// Missions
-		saveData.m_aMissions = RBL_CampaignPersistence.GetInstance().CollectActiveMissions();
-		
-		return saveData;
+		// Slot saves are player-initiated, so collect in one frame
+		RBL_SaveCollector collector = new RBL_SaveCollector();
+		return collector.CollectImmediate(saveData);
 	}
 	
 	// ========================================================================
@@ -347,6 +364,7 @@ class RBL_PersistenceIntegration
 	RBL_SaveSlotManager GetSlotManager() { return m_SlotManager; }
 	RBL_SaveFileManager GetFileManager() { return m_FileManager; }
 	RBL_AutoSaveManager GetAutoSaveManager() { return m_AutoSaveManager; }
+	RBL_SaveJournal GetJournal() { return m_Journal; }
 }
 
 // ============================================================================
@@ -406,6 +424,14 @@ class RBL_SaveCommands
 		RBL_AutoSaveManager.GetInstance().SetAutoSaveInterval(seconds);
 		PrintFormat("[RBL] AutoSave interval: %1 seconds", seconds);
 	}
+	
+	// codec: 0 = none, 1 = LZ. Applies to JSON saves
+	static void SetCompression(int codec, int level)
+	{
+		RBL_SaveFileManager fileMgr = RBL_SaveFileManager.GetInstance();
+		fileMgr.SetCodec(codec, level);
+		PrintFormat("[RBL] Save compression: %1 level %2", typename.EnumToString(ERBLSaveCodec, fileMgr.GetCodec()), fileMgr.GetCodecLevel());
+	}
 }
 
 // ============================================================================
@@ -431,7 +457,7 @@ class RBL_GameModePersistence
 	{
 		// Trigger final save on game end
 		RBL_AutoSaveManager autoSave = RBL_AutoSaveManager.GetInstance();
-		autoSave.TriggerAutoSave("Game End");
+		autoSave.TriggerAutoSave("Game End", true);
 	}
 }
 
@@ -206,29 +206,34 @@ class RBL_PlayerPersistence
 		
 		for (int i = 0; i < playerStates.Count(); i++)
 		{
-			RBL_PlayerSaveData playerData = playerStates[i];
-			if (!playerData)
-				continue;
-			
-			// Find player by UID
-			int playerId = FindPlayerByUID(playerData.m_sPlayerUID);
-			
-			if (playerId >= 0)
-			{
-				if (RestorePlayerState(playerId, playerData))
-					restoredCount++;
-			}
-			else
-			{
-				// Player not connected - store for later restoration
-				StoreOfflinePlayerData(playerData);
-			}
+			if (RestorePlayerEntry(playerStates[i]))
+				restoredCount++;
 		}
 		
 		PrintFormat("[RBL_PlayerPersistence] Restored %1 player states", restoredCount);
 		return restoredCount;
 	}
 	
+	// Restore one saved player if connected, otherwise keep the data for
+	// when they join. True only if the state was applied now
+	bool RestorePlayerEntry(RBL_PlayerSaveData playerData)
+	{
+		if (!playerData)
+			return false;
+		
+		// Find player by UID
+		int playerId = FindPlayerByUID(playerData.m_sPlayerUID);
+		
+		if (playerId < 0)
+		{
+			// Player not connected - store for later restoration
+			StoreOfflinePlayerData(playerData);
+			return false;
+		}
+		
+		return RestorePlayerState(playerId, playerData);
+	}
+	
 	// Restore single player's state
 	bool RestorePlayerState(int playerId, RBL_PlayerSaveData data)
 	{
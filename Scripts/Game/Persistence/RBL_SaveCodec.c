@@ -0,0 +1,260 @@
+// ============================================================================
+// PROJECT REBELLION - Save Codec
+// Optional compression between the JSON serializer and the file layer
+// LZ: greedy LZ77 with hash chains over 4-character keys. Output stays
+// printable text so it can go through the same string file path:
+//   "~~"            literal '~'
+//   "~" OOO L       back-reference, OOO = distance and L = length - MIN_MATCH,
+//                   both in the 64-symbol alphabet below
+// Encoded files start with a one-line header naming codec, level, raw length
+// and a hash of the raw text
+// ============================================================================
+
+class RBL_SaveCodec
+{
+	protected static const string HEADER_TAG = "RBLZ";
+	protected static const string SEPARATOR = "|";
+	protected static const string ESCAPE = "~";
+	protected static const string ALPHABET = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz+/";
+	
+	protected static const int KEY_LENGTH = 4;
+	// A reference costs 5 characters, so anything shorter is not worth it
+	protected static const int MIN_MATCH = 6;
+	protected static const int MAX_MATCH = MIN_MATCH + 63;
+	protected static const int MAX_DISTANCE = 262143;
+	
+	static const int MIN_LEVEL = 1;
+	static const int MAX_LEVEL = 9;
+	
+	// ========================================================================
+	// PUBLIC API
+	// ========================================================================
+	
+	// Header plus encoded payload. NONE returns the input unchanged
+	static string Encode(string raw, ERBLSaveCodec codec, int level)
+	{
+		if (codec == ERBLSaveCodec.NONE)
+			return raw;
+		
+		level = Math.Clamp(level, MIN_LEVEL, MAX_LEVEL);
+		int codecValue = codec;
+		
+		string header = HEADER_TAG + SEPARATOR + codecValue.ToString() + SEPARATOR + level.ToString();
+		header += SEPARATOR + raw.Length().ToString() + SEPARATOR + raw.Hash().ToString() + "\n";
+		return header + CompressLZ(raw, level);
+	}
+	
+	static bool IsEncoded(string content)
+	{
+		return content.IndexOf(HEADER_TAG + SEPARATOR) == 0;
+	}
+	
+	// Raw text, or "" if the header is unknown or the result fails the
+	// length and hash check
+	static string Decode(string content)
+	{
+		if (!IsEncoded(content))
+			return content;
+		
+		int headerEnd = content.IndexOf("\n");
+		if (headerEnd < 0)
+			return "";
+		
+		array<string> fields = new array<string>();
+		content.Substring(0, headerEnd).Split(SEPARATOR, fields, false);
+		if (fields.Count() != 5)
+			return "";
+		
+		ERBLSaveCodec codec = fields[1].ToInt();
+		int rawLength = fields[3].ToInt();
+		int rawHash = fields[4].ToInt();
+		string payload = content.Substring(headerEnd + 1, content.Length() - headerEnd - 1);
+		
+		string raw;
+		if (codec == ERBLSaveCodec.LZ)
+			raw = DecompressLZ(payload);
+		else
+			return "";
+		
+		if (raw.Length() != rawLength || raw.Hash() != rawHash)
+		{
+			PrintFormat("[RBL_SaveCodec] Decoded data failed verification");
+			return "";
+		}
+		return raw;
+	}
+	
+	// ========================================================================
+	// LZ
+	// ========================================================================
+	
+	protected static string CompressLZ(string input, int level)
+	{
+		int length = input.Length();
+		int maxChain = level * 4;
+		
+		// Most recent position of each key, and for every position the
+		// previous position that shared its key
+		map<string, int> head = new map<string, int>();
+		array<int> previous = new array<int>();
+		previous.Resize(length);
+		
+		array<string> output = new array<string>();
+		int literalStart = 0;
+		int pos = 0;
+		
+		while (pos < length)
+		{
+			int bestLength = 0;
+			int bestDistance = 0;
+			
+			if (pos + KEY_LENGTH <= length)
+			{
+				string key = input.Substring(pos, KEY_LENGTH);
+				int candidate = -1;
+				if (!head.Find(key, candidate))
+					candidate = -1;
+				
+				int steps = 0;
+				while (candidate >= 0 && steps < maxChain && pos - candidate <= MAX_DISTANCE)
+				{
+					int matchLength = MatchLength(input, candidate, pos, length);
+					if (matchLength > bestLength)
+					{
+						bestLength = matchLength;
+						bestDistance = pos - candidate;
+						if (matchLength >= MAX_MATCH)
+							break;
+					}
+					candidate = previous[candidate];
+					steps++;
+				}
+				
+				previous[pos] = -1;
+				if (head.Contains(key))
+					previous[pos] = head.Get(key);
+				head.Set(key, pos);
+			}
+			
+			if (bestLength < MIN_MATCH)
+			{
+				pos++;
+				continue;
+			}
+			
+			EmitLiterals(input, literalStart, pos, output);
+			output.Insert(ESCAPE + EncodeNumber(bestDistance, 3) + EncodeNumber(bestLength - MIN_MATCH, 1));
+			
+			// Index the positions covered by the match so later data can
+			// refer into it
+			int matchEnd = pos + bestLength;
+			for (int i = pos + 1; i < matchEnd && i + KEY_LENGTH <= length; i++)
+			{
+				string coveredKey = input.Substring(i, KEY_LENGTH);
+				previous[i] = -1;
+				if (head.Contains(coveredKey))
+					previous[i] = head.Get(coveredKey);
+				head.Set(coveredKey, i);
+			}
+			
+			pos = matchEnd;
+			literalStart = pos;
+		}
+		
+		EmitLiterals(input, literalStart, length, output);
+		return RBL_FileReader.Join(output);
+	}
+	
+	protected static int MatchLength(string input, int from, int to, int length)
+	{
+		int limit = Math.Min(MAX_MATCH, length - to);
+		int matched = 0;
+		while (matched < limit && input.Get(from + matched) == input.Get(to + matched))
+		{
+			matched++;
+		}
+		return matched;
+	}
+	
+	// Copy input[start, end) escaping the escape character
+	protected static void EmitLiterals(string input, int start, int end, array<string> output)
+	{
+		if (end <= start)
+			return;
+		
+		string literal = input.Substring(start, end - start);
+		if (literal.IndexOf(ESCAPE) != -1)
+			literal.Replace(ESCAPE, ESCAPE + ESCAPE);
+		output.Insert(literal);
+	}
+	
+	protected static string DecompressLZ(string payload)
+	{
+		// One entry per output character so references can copy from
+		// anywhere behind the cursor, including overlapping runs
+		array<string> output = new array<string>();
+		int length = payload.Length();
+		int pos = 0;
+		
+		while (pos < length)
+		{
+			string c = payload.Get(pos);
+			if (c != ESCAPE)
+			{
+				output.Insert(c);
+				pos++;
+				continue;
+			}
+			
+			if (pos + 1 < length && payload.Get(pos + 1) == ESCAPE)
+			{
+				output.Insert(ESCAPE);
+				pos += 2;
+				continue;
+			}
+			
+			if (pos + 5 > length)
+				return "";
+			
+			int distance = DecodeNumber(payload.Substring(pos + 1, 3));
+			int matchLength = DecodeNumber(payload.Substring(pos + 4, 1)) + MIN_MATCH;
+			int from = output.Count() - distance;
+			if (distance <= 0 || from < 0)
+				return "";
+			
+			for (int i = 0; i < matchLength; i++)
+			{
+				output.Insert(output[from + i]);
+			}
+			pos += 5;
+		}
+		
+		return RBL_FileReader.Join(output);
+	}
+	
+	// ========================================================================
+	// NUMBERS
+	// ========================================================================
+	
+	// Fixed-width base-64, most significant digit first
+	protected static string EncodeNumber(int value, int width)
+	{
+		string digits = "";
+		for (int i = 0; i < width; i++)
+		{
+			digits = ALPHABET.Get(value & 63) + digits;
+			value = value >> 6;
+		}
+		return digits;
+	}
+	
+	protected static int DecodeNumber(string digits)
+	{
+		int value = 0;
+		for (int i = 0; i < digits.Length(); i++)
+		{
+			value = (value << 6) | ALPHABET.IndexOf(digits.Get(i));
+		}
+		return value;
+	}
+}
@@ -0,0 +1,270 @@
+// ============================================================================
+// PROJECT REBELLION - Save Collector
+// Gathers a full RBL_SaveData over several frames within a per-frame budget
+// Zones and players are collected incrementally; small global state and any
+// zone that changed mid-collection are gathered in the final frame so the
+// snapshot cannot tear
+// ============================================================================
+
+class RBL_SaveCollector
+{
+	// Stages, in order
+	protected const int STAGE_IDLE = 0;
+	protected const int STAGE_ZONES = 1;
+	protected const int STAGE_PLAYERS = 2;
+	protected const int STAGE_FINALIZE = 3;
+	protected const int STAGE_DONE = 4;
+	
+	// Milliseconds of collection work allowed per frame. At least one unit
+	// of work always runs so collection cannot stall
+	protected const int FRAME_BUDGET_MS = 2;
+	
+	protected int m_iStage;
+	protected ref RBL_SaveData m_SaveData;
+	protected ref array<string> m_aZoneIDs;
+	protected ref array<int> m_aPlayerIDs;
+	protected int m_iCursor;
+	
+	// Zones collected this pass that changed owner afterwards
+	protected ref array<string> m_aDirtyZones;
+	protected ref array<string> m_aCollectedZones;
+	
+	protected int m_iFramesUsed;
+	protected int m_iLastFrameCount;
+	
+	void RBL_SaveCollector()
+	{
+		m_iStage = STAGE_IDLE;
+		m_aZoneIDs = new array<string>();
+		m_aPlayerIDs = new array<int>();
+		m_aDirtyZones = new array<string>();
+		m_aCollectedZones = new array<string>();
+		m_iCursor = 0;
+		m_iFramesUsed = 0;
+		m_iLastFrameCount = 0;
+	}
+	
+	// ========================================================================
+	// CONTROL
+	// ========================================================================
+	
+	// Start collecting into saveData, which should already carry its header
+	bool Begin(RBL_SaveData saveData)
+	{
+		if (IsCollecting() || !saveData)
+			return false;
+		
+		m_SaveData = saveData;
+		m_SaveData.m_aZones = new array<ref RBL_ZoneSaveData>();
+		m_SaveData.m_aPlayers = new array<ref RBL_PlayerSaveData>();
+		
+		m_aZoneIDs.Clear();
+		m_aPlayerIDs.Clear();
+		m_aDirtyZones.Clear();
+		m_aCollectedZones.Clear();
+		m_iCursor = 0;
+		m_iFramesUsed = 0;
+		
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (zoneMgr)
+		{
+			zoneMgr.GetAllZoneIDs(m_aZoneIDs);
+			zoneMgr.GetOnZoneOwnershipChanged().Insert(OnZoneOwnershipChanged);
+		}
+		
+		PlayerManager pm = GetGame().GetPlayerManager();
+		if (pm)
+			pm.GetPlayers(m_aPlayerIDs);
+		
+		m_iStage = STAGE_ZONES;
+		return true;
+	}
+	
+	// Drop an in-progress collection
+	void Cancel()
+	{
+		if (m_iStage == STAGE_IDLE)
+			return;
+		
+		StopListening();
+		m_SaveData = null;
+		m_iStage = STAGE_IDLE;
+	}
+	
+	// Run one frame's worth of collection. Returns true once the snapshot
+	// is complete and can be taken with TakeResult()
+	bool Step()
+	{
+		if (m_iStage == STAGE_IDLE)
+			return false;
+		if (m_iStage == STAGE_DONE)
+			return true;
+		
+		m_iFramesUsed++;
+		int startTick = System.GetTickCount();
+		
+		while (m_iStage != STAGE_DONE)
+		{
+			StepStage();
+			
+			// Finalize always completes inside the frame it starts in
+			if (m_iStage == STAGE_FINALIZE)
+			{
+				Finalize();
+				break;
+			}
+			
+			if (System.GetTickCount() - startTick >= FRAME_BUDGET_MS)
+				break;
+		}
+		
+		return m_iStage == STAGE_DONE;
+	}
+	
+	// Collect everything in the current frame (manual saves)
+	RBL_SaveData CollectImmediate(RBL_SaveData saveData)
+	{
+		if (!Begin(saveData))
+			return null;
+		
+		while (!Step())
+		{
+		}
+		
+		return TakeResult();
+	}
+	
+	RBL_SaveData TakeResult()
+	{
+		if (m_iStage != STAGE_DONE)
+			return null;
+		
+		RBL_SaveData result = m_SaveData;
+		m_SaveData = null;
+		m_iLastFrameCount = m_iFramesUsed;
+		m_iStage = STAGE_IDLE;
+		return result;
+	}
+	
+	// ========================================================================
+	// STAGES
+	// ========================================================================
+	
+	// Collect a single zone or player and advance the stage when exhausted
+	protected void StepStage()
+	{
+		if (m_iStage == STAGE_ZONES)
+		{
+			if (m_iCursor >= m_aZoneIDs.Count())
+			{
+				m_iCursor = 0;
+				m_iStage = STAGE_PLAYERS;
+				return;
+			}
+			
+			CollectZone(m_aZoneIDs[m_iCursor]);
+			m_iCursor++;
+			return;
+		}
+		
+		if (m_iStage == STAGE_PLAYERS)
+		{
+			if (m_iCursor >= m_aPlayerIDs.Count())
+			{
+				m_iCursor = 0;
+				m_iStage = STAGE_FINALIZE;
+				return;
+			}
+			
+			RBL_PlayerSaveData playerData = RBL_PlayerPersistence.GetInstance().CollectPlayerState(m_aPlayerIDs[m_iCursor]);
+			if (playerData)
+				m_SaveData.m_aPlayers.Insert(playerData);
+			m_iCursor++;
+		}
+	}
+	
+	protected void CollectZone(string zoneID)
+	{
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!zoneMgr)
+			return;
+		
+		RBL_ZoneSaveData zoneData = RBL_ZonePersistence.GetInstance().CollectZoneState(zoneMgr.GetZone(zoneID));
+		if (!zoneData)
+			return;
+		
+		m_SaveData.m_aZones.Insert(zoneData);
+		m_aCollectedZones.Insert(zoneID);
+	}
+	
+	// Global state is small, so it is read in the same frame the snapshot
+	// is handed off; zones that changed after being collected are redone
+	protected void Finalize()
+	{
+		StopListening();
+		
+		foreach (string zoneID : m_aDirtyZones)
+		{
+			RecollectZone(zoneID);
+		}
+		
+		RBL_CampaignPersistence campaign = RBL_CampaignPersistence.GetInstance();
+		m_SaveData.m_Campaign = campaign.CollectCampaignState();
+		m_SaveData.m_Economy = RBL_EconomyPersistence.GetInstance().CollectEconomyState();
+		m_SaveData.m_Commander = campaign.CollectCommanderState();
+		m_SaveData.m_aMissions = campaign.CollectActiveMissions();
+		
+		m_iStage = STAGE_DONE;
+	}
+	
+	protected void RecollectZone(string zoneID)
+	{
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!zoneMgr)
+			return;
+		
+		RBL_ZoneSaveData zoneData = RBL_ZonePersistence.GetInstance().CollectZoneState(zoneMgr.GetZone(zoneID));
+		if (!zoneData)
+			return;
+		
+		for (int i = 0; i < m_SaveData.m_aZones.Count(); i++)
+		{
+			if (m_SaveData.m_aZones[i].m_sZoneID == zoneID)
+			{
+				m_SaveData.m_aZones[i] = zoneData;
+				return;
+			}
+		}
+	}
+	
+	// ========================================================================
+	// CONSISTENCY
+	// ========================================================================
+	
+	protected void OnZoneOwnershipChanged(string zoneID, ERBLFactionKey previousOwner, ERBLFactionKey newOwner)
+	{
+		if (previousOwner == newOwner)
+			return;
+		
+		// Zones not yet reached will be read with their new owner anyway
+		if (m_aCollectedZones.Find(zoneID) == -1 || m_aDirtyZones.Find(zoneID) != -1)
+			return;
+		
+		m_aDirtyZones.Insert(zoneID);
+	}
+	
+	protected void StopListening()
+	{
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (zoneMgr)
+			zoneMgr.GetOnZoneOwnershipChanged().Remove(OnZoneOwnershipChanged);
+	}
+	
+	// ========================================================================
+	// STATE
+	// ========================================================================
+	
+	bool IsCollecting() { return m_iStage != STAGE_IDLE; }
+	bool IsComplete() { return m_iStage == STAGE_DONE; }
+	int GetLastFrameCount() { return m_iLastFrameCount; }
+}
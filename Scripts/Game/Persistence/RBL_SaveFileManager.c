@@ -8,12 +8,30 @@ class RBL_SaveFileManager
 	// Save file paths
 	protected static const string SAVE_FOLDER = "$profile:Rebellion/saves/";
 	protected static const string SAVE_EXTENSION = ".rblsave";
+	protected static const string BINARY_EXTENSION = ".rblbin";
+	protected static const string EXPORT_EXTENSION = ".export.json";
 	protected static const string BACKUP_EXTENSION = ".rblbak";
+	protected static const string ALTERNATE_SUFFIX = ".b";
 	protected static const string QUICKSAVE_NAME = "quicksave";
 	protected static const string AUTOSAVE_NAME = "autosave";
 	
 	protected static ref RBL_SaveFileManager s_Instance;
 	
+	// Format used by WriteSaveData when the caller does not pick one
+	protected ERBLSaveFormat m_eDefaultFormat;
+	
+	// Summaries of every save, kept in sync on write and delete
+	protected ref RBL_SaveIndex m_Index;
+	
+	// Compression applied to JSON saves
+	protected ERBLSaveCodec m_eCodec;
+	protected int m_iCodecLevel;
+	protected float m_fLastCompressionRatio;
+	protected int m_iLastCompressionMs;
+	
+	// Content checksum of the last JSON file ReadSaveFile accepted
+	protected int m_iLastReadChecksum;
+	
 	// ========================================================================
 	// SINGLETON
 	// ========================================================================
@@ -27,33 +45,47 @@ class RBL_SaveFileManager
 	
 	void RBL_SaveFileManager()
 	{
+		m_eDefaultFormat = ERBLSaveFormat.BINARY;
+		m_eCodec = ERBLSaveCodec.NONE;
+		m_iCodecLevel = 5;
+		m_fLastCompressionRatio = 1.0;
+		m_iLastCompressionMs = 0;
+		
 		// Ensure save directory exists
 		EnsureSaveDirectory();
+		
+		m_Index = new RBL_SaveIndex(SAVE_FOLDER);
 	}
 	
 	// ========================================================================
 	// FILE OPERATIONS
 	// ========================================================================
 	
-	// Write save data to file
-	bool WriteToFile(string filename, string jsonContent)
+	// Every save is a pair of files. Writes go to the file that is not
+	// current, and the index is switched over only once the write has
+	// finished, so a crash mid-save leaves the previous save in place and
+	// the previous file doubles as the backup without being copied
+	
+	// Write save data in the default format
+	bool WriteSaveData(string filename, RBL_SaveData saveData)
+	{
+		return WriteSaveDataAs(filename, saveData, m_eDefaultFormat);
+	}
+	
+	// Serialize save data straight into the file without building the
+	// whole document in memory first. Any copy of the save in the other
+	// format is removed so loads never pick up a stale file
+	bool WriteSaveDataAs(string filename, RBL_SaveData saveData, ERBLSaveFormat format)
 	{
-		if (filename.IsEmpty() || jsonContent.IsEmpty())
+		if (filename.IsEmpty() || !saveData)
 		{
-			PrintFormat("[RBL_SaveFile] Write failed: empty filename or content");
+			PrintFormat("[RBL_SaveFile] Write failed: empty filename or save data");
 			return false;
 		}
 		
-		string filepath = GetSavePath(filename);
+		bool alternate = GetWriteTarget(filename, format);
+		string filepath = GetSaveFilePath(filename, format, alternate);
 		
-		// Create backup of existing file
-		if (FileExists(filepath))
-		{
-			string backupPath = filepath + BACKUP_EXTENSION;
-			CopyFile(filepath, backupPath);
-		}
-		
-		// Write new content
 		FileHandle file = FileIO.OpenFile(filepath, FileMode.WRITE);
 		if (!file)
 		{
@@ -61,72 +93,241 @@ class RBL_SaveFileManager
 			return false;
 		}
 		
-		file.Write(jsonContent);
+		int bytes;
+		int checksum = 0;
+		if (format == ERBLSaveFormat.BINARY)
+		{
+			bytes = RBL_BinarySaveSerializer.WriteToFile(saveData, file);
+		}
+		else if (m_eCodec != ERBLSaveCodec.NONE)
+		{
+			string encoded = EncodeJson(RBL_SaveSerializer.SerializeToJson(saveData));
+			file.Write(encoded);
+			bytes = encoded.Length();
+			checksum = RBL_JsonWriter.ContentChecksum(encoded);
+		}
+		else
+		{
+			RBL_JsonWriter writer = new RBL_JsonWriter();
+			writer.Attach(file);
+			RBL_SaveSerializer.WriteSaveData(writer, saveData);
+			writer.Finish();
+			bytes = writer.GetLength();
+			checksum = writer.GetChecksum();
+		}
 		file.Close();
 		
-		PrintFormat("[RBL_SaveFile] Save written: %1 (%2 bytes)", filename, jsonContent.Length());
+		if (bytes < 0)
+		{
+			PrintFormat("[RBL_SaveFile] Serialization failed: %1", filename);
+			return false;
+		}
+		
+		if (!CommitWrite(filename, saveData, filepath, bytes, checksum, format, alternate))
+			return false;
+		
+		PrintFormat("[RBL_SaveFile] Save written: %1 (%2 bytes, %3)", filename, bytes, typename.EnumToString(ERBLSaveFormat, format));
+		return true;
+	}
+	
+	// Run the configured codec over serialized JSON and report how it did
+	protected string EncodeJson(string json)
+	{
+		int start = System.GetTickCount();
+		string encoded = RBL_SaveCodec.Encode(json, m_eCodec, m_iCodecLevel);
+		m_iLastCompressionMs = System.GetTickCount() - start;
+		
+		float rawLength = json.Length();
+		m_fLastCompressionRatio = 1.0;
+		if (rawLength > 0)
+			m_fLastCompressionRatio = encoded.Length() / rawLength;
+		
+		PrintFormat("[RBL_SaveFile] Compressed %1 -> %2 bytes (ratio %3, %4 ms, %5 level %6)",
+			json.Length(), encoded.Length(), m_fLastCompressionRatio, m_iLastCompressionMs,
+			typename.EnumToString(ERBLSaveCodec, m_eCodec), m_iCodecLevel);
+		return encoded;
+	}
+	
+	// Pick the file of the pair that does not hold the current save
+	protected bool GetWriteTarget(string filename, ERBLSaveFormat format)
+	{
+		RBL_SaveIndexEntry entry = m_Index.Find(filename);
+		if (entry && entry.Format == format)
+			return !entry.Alternate;
+		
+		// Unindexed save from before the pairing: keep it as the backup
+		return FileExists(GetSaveFilePath(filename, format, false));
+	}
+	
+	// Make a finished write the current save. Engine file handles offer no
+	// explicit sync, so the closed file's length is checked instead. JSON
+	// saves record the content checksum taken while they were written;
+	// binary saves embed their own and pass 0
+	protected bool CommitWrite(string filename, RBL_SaveData saveData, string filepath, int bytes, int checksum, ERBLSaveFormat format, bool alternate)
+	{
+		int written = GetFileLength(filepath);
+		if (written != bytes)
+		{
+			PrintFormat("[RBL_SaveFile] Write incomplete: %1 (%2 of %3 bytes)", filepath, written, bytes);
+			return false;
+		}
+		
+		m_Index.Update(filename, saveData, bytes, checksum, format, alternate);
+		
+		// Drop the other format's pair
+		DeleteFormatFiles(filename, GetOtherFormat(format));
 		return true;
 	}
 	
-	// Read save data from file
-	string ReadFromFile(string filename)
+	// Load save data in whichever format the file was written in, falling
+	// back to the previous save when the current file fails verification
+	RBL_SaveData LoadSaveData(string filename)
 	{
 		if (filename.IsEmpty())
+			return null;
+		
+		RBL_SaveIndexEntry entry = m_Index.Find(filename);
+		if (entry)
 		{
-			PrintFormat("[RBL_SaveFile] Read failed: empty filename");
-			return "";
+			RBL_SaveData saveData = ReadSaveFile(GetSaveFilePath(filename, entry.Format, entry.Alternate), entry.Format, entry.Bytes, entry.Checksum);
+			if (saveData)
+				return saveData;
+			
+			PrintFormat("[RBL_SaveFile] Current save failed verification, trying backup: %1", filename);
+			return ReadSaveFile(GetSaveFilePath(filename, entry.Format, !entry.Alternate), entry.Format, -1, 0);
 		}
 		
-		string filepath = GetSavePath(filename);
+		// Saves the index does not know about
+		string binaryPath = GetSaveFilePath(filename, ERBLSaveFormat.BINARY, false);
+		if (FileExists(binaryPath))
+			return ReadSaveFile(binaryPath, ERBLSaveFormat.BINARY, -1, 0);
 		
+		return ReadSaveFile(GetSaveFilePath(filename, ERBLSaveFormat.JSON, false), ERBLSaveFormat.JSON, -1, 0);
+	}
+	
+	// Binary saves verify their embedded checksum; JSON saves are checked
+	// against the indexed size and content checksum. expectedBytes < 0 skips
+	// the size check and expectedChecksum 0 skips the content check
+	protected RBL_SaveData ReadSaveFile(string filepath, ERBLSaveFormat format, int expectedBytes, int expectedChecksum)
+	{
+		m_iLastReadChecksum = 0;
 		if (!FileExists(filepath))
+			return null;
+		
+		if (expectedBytes >= 0 && GetFileLength(filepath) != expectedBytes)
 		{
-			PrintFormat("[RBL_SaveFile] File not found: %1", filepath);
-			return "";
+			PrintFormat("[RBL_SaveFile] Size mismatch: %1 (expected %2 bytes)", filepath, expectedBytes);
+			return null;
 		}
 		
-		FileHandle file = FileIO.OpenFile(filepath, FileMode.READ);
-		if (!file)
+		RBL_SaveData saveData;
+		if (format == ERBLSaveFormat.BINARY)
 		{
-			PrintFormat("[RBL_SaveFile] Failed to open file for reading: %1", filepath);
-			return "";
+			FileHandle file = FileIO.OpenFile(filepath, FileMode.READ);
+			if (!file)
+			{
+				PrintFormat("[RBL_SaveFile] Failed to open file for reading: %1", filepath);
+				return null;
+			}
+			
+			saveData = RBL_BinarySaveSerializer.ReadFromFile(file);
+			file.Close();
+		}
+		else
+		{
+			string raw = ReadTextFile(filepath);
+			int checksum = RBL_JsonWriter.ContentChecksum(raw);
+			if (expectedChecksum != 0 && checksum != expectedChecksum)
+			{
+				PrintFormat("[RBL_SaveFile] Checksum mismatch: %1", filepath);
+				return null;
+			}
+			m_iLastReadChecksum = checksum;
+			
+			string content = RBL_SaveCodec.Decode(raw);
+			if (content.IsEmpty())
+				return null;
+			
+			saveData = RBL_SaveSerializer.DeserializeFromJson(content);
 		}
 		
-		string content = "";
-		string line;
-		while (file.ReadLine(line) >= 0)
+		if (!saveData || !saveData.IsValid())
+			return null;
+		
+		PrintFormat("[RBL_SaveFile] Save loaded: %1", filepath);
+		return saveData;
+	}
+	
+	// Write a human-readable JSON copy of a save next to it for debugging
+	bool ExportSaveAsJson(string filename)
+	{
+		RBL_SaveData saveData = LoadSaveData(filename);
+		if (!saveData)
 		{
-			content += line;
+			PrintFormat("[RBL_SaveFile] Export failed, could not load: %1", filename);
+			return false;
 		}
+		
+		string exportPath = SAVE_FOLDER + filename + EXPORT_EXTENSION;
+		FileHandle file = FileIO.OpenFile(exportPath, FileMode.WRITE);
+		if (!file)
+		{
+			PrintFormat("[RBL_SaveFile] Failed to open file for writing: %1", exportPath);
+			return false;
+		}
+		
+		RBL_SaveSerializer.SerializeToFile(saveData, file);
 		file.Close();
 		
-		PrintFormat("[RBL_SaveFile] Save loaded: %1 (%2 bytes)", filename, content.Length());
+		PrintFormat("[RBL_SaveFile] Exported %1 to %2", filename, exportPath);
+		return true;
+	}
+	
+	protected string ReadTextFile(string filepath)
+	{
+		string content = RBL_FileReader.ReadAll(filepath);
+		if (content.IsEmpty())
+			PrintFormat("[RBL_SaveFile] Failed to read file: %1", filepath);
 		return content;
 	}
 	
 	// Delete save file
 	bool DeleteFile(string filename)
 	{
-		string filepath = GetSavePath(filename);
-		
-		if (!FileExists(filepath))
+		if (!SaveExists(filename))
 			return true; // Already doesn't exist
 		
-		bool result = FileIO.DeleteFile(filepath);
-		
-		// Also delete backup if exists
-		string backupPath = filepath + BACKUP_EXTENSION;
-		if (FileExists(backupPath))
-			FileIO.DeleteFile(backupPath);
+		DeleteFormatFiles(filename, ERBLSaveFormat.JSON);
+		DeleteFormatFiles(filename, ERBLSaveFormat.BINARY);
+		m_Index.Remove(filename);
 		
 		PrintFormat("[RBL_SaveFile] File deleted: %1", filename);
-		return result;
+		return true;
+	}
+	
+	// Remove both files of a save's pair in one format, plus any backup
+	// left by older versions
+	protected void DeleteFormatFiles(string filename, ERBLSaveFormat format)
+	{
+		string primaryPath = GetSaveFilePath(filename, format, false);
+		string alternatePath = GetSaveFilePath(filename, format, true);
+		
+		if (FileExists(primaryPath))
+			FileIO.DeleteFile(primaryPath);
+		if (FileExists(alternatePath))
+			FileIO.DeleteFile(alternatePath);
+		if (FileExists(primaryPath + BACKUP_EXTENSION))
+			FileIO.DeleteFile(primaryPath + BACKUP_EXTENSION);
 	}
 	
 	// Check if file exists
 	bool SaveExists(string filename)
 	{
-		return FileExists(GetSavePath(filename));
+		if (m_Index.Contains(filename))
+			return true;
+		
+		return FileExists(GetSaveFilePath(filename, ERBLSaveFormat.JSON, false))
+			|| FileExists(GetSaveFilePath(filename, ERBLSaveFormat.BINARY, false));
 	}
 	
 	// ========================================================================
@@ -136,8 +337,9 @@ class RBL_SaveFileManager
 	// Get list of all save files
 	array<string> GetSaveFileList()
 	{
+		// File enumeration is not available, so the index is the listing
 		array<string> saves = new array<string>();
-		// File enumeration not supported in this environment.
+		m_Index.GetNames(saves);
 		return saves;
 	}
 	
@@ -148,24 +350,20 @@ class RBL_SaveFileManager
 		info.m_iSlotIndex = slotIndex;
 		
 		string filename = GetSlotFilename(slotIndex);
-		string filepath = GetSavePath(filename);
 		
-		if (!FileExists(filepath))
+		if (!SaveExists(filename))
 		{
 			info.m_bIsEmpty = true;
 			return info;
 		}
 		
-		// Try to read and parse header only
-		string content = ReadFromFile(filename);
-		if (content.IsEmpty())
-		{
-			info.m_bIsCorrupted = true;
-			return info;
-		}
+		// Saves written before the index existed are read once and indexed
+		RBL_SaveIndexEntry entry = m_Index.Find(filename);
+		if (!entry)
+			entry = IndexExistingSave(filename);
 		
-		RBL_SaveData saveData = RBL_SaveSerializer.DeserializeFromJson(content);
-		if (!saveData || !saveData.IsValid())
+		// A size mismatch means the file was truncated or replaced outside the game
+		if (!entry || GetFileLength(GetSaveFilePath(filename, entry.Format, entry.Alternate)) != entry.Bytes)
 		{
 			info.m_bIsCorrupted = true;
 			return info;
@@ -174,24 +372,33 @@ class RBL_SaveFileManager
 		// Populate slot info
 		info.m_bIsEmpty = false;
 		info.m_sSlotName = "Slot " + slotIndex.ToString();
-		info.m_sSaveTime = saveData.m_sSaveTime;
-		info.m_sWorldName = saveData.m_sWorldName;
-		info.m_fPlayTime = saveData.m_Campaign.m_fTotalPlayTime;
-		info.m_iWarLevel = saveData.m_Campaign.m_iWarLevel;
-		
-		// Count zones
-		int fiaZones = 0;
-		for (int i = 0; i < saveData.m_aZones.Count(); i++)
-		{
-			if (saveData.m_aZones[i].m_iOwnerFaction == ERBLFactionKey.FIA)
-				fiaZones++;
-		}
-		info.m_iZonesControlled = fiaZones;
-		info.m_iTotalZones = saveData.m_aZones.Count();
+		info.m_sSaveTime = entry.SaveTime;
+		info.m_sWorldName = entry.WorldName;
+		info.m_fPlayTime = entry.PlayTime;
+		info.m_iWarLevel = entry.WarLevel;
+		info.m_iZonesControlled = entry.ZonesControlled;
+		info.m_iTotalZones = entry.TotalZones;
 		
 		return info;
 	}
 	
+	// Build an index entry for a save the index does not know about
+	protected RBL_SaveIndexEntry IndexExistingSave(string filename)
+	{
+		RBL_SaveData saveData = LoadSaveData(filename);
+		if (!saveData || !saveData.IsValid())
+			return null;
+		
+		ERBLSaveFormat format = ERBLSaveFormat.JSON;
+		if (FileExists(GetSaveFilePath(filename, ERBLSaveFormat.BINARY, false)))
+			format = ERBLSaveFormat.BINARY;
+		
+		// LoadSaveData just read this same file
+		string path = GetSaveFilePath(filename, format, false);
+		m_Index.Update(filename, saveData, GetFileLength(path), m_iLastReadChecksum, format, false);
+		return m_Index.Find(filename);
+	}
+	
 	// Get all slot infos
 	array<ref RBL_SaveSlotInfo> GetAllSlotInfos(int maxSlots)
 	{
@@ -205,20 +412,25 @@ class RBL_SaveFileManager
 		return infos;
 	}
 	
+	RBL_SaveIndexEntry GetIndexEntry(string filename)
+	{
+		return m_Index.Find(filename);
+	}
+	
 	// ========================================================================
 	// QUICKSAVE / AUTOSAVE
 	// ========================================================================
 	
-	// Write quicksave
-	bool WriteQuicksave(string jsonContent)
+	// Stream quicksave from save data
+	bool WriteQuicksaveData(RBL_SaveData saveData)
 	{
-		return WriteToFile(QUICKSAVE_NAME, jsonContent);
+		return WriteSaveData(QUICKSAVE_NAME, saveData);
 	}
 	
-	// Read quicksave
-	string ReadQuicksave()
+	// Load quicksave in whichever format it was written
+	RBL_SaveData LoadQuicksave()
 	{
-		return ReadFromFile(QUICKSAVE_NAME);
+		return LoadSaveData(QUICKSAVE_NAME);
 	}
 	
 	// Check if quicksave exists
@@ -227,18 +439,6 @@ class RBL_SaveFileManager
 		return SaveExists(QUICKSAVE_NAME);
 	}
 	
-	// Write autosave
-	bool WriteAutosave(string jsonContent)
-	{
-		return WriteToFile(AUTOSAVE_NAME, jsonContent);
-	}
-	
-	// Read autosave
-	string ReadAutosave()
-	{
-		return ReadFromFile(AUTOSAVE_NAME);
-	}
-	
 	// Check if autosave exists
 	bool AutosaveExists()
 	{
@@ -249,32 +449,33 @@ class RBL_SaveFileManager
 	// BACKUP AND RESTORE
 	// ========================================================================
 	
-	// Restore from backup
+	// Make the previous save current again
 	bool RestoreFromBackup(string filename)
 	{
-		string filepath = GetSavePath(filename);
-		string backupPath = filepath + BACKUP_EXTENSION;
-		
-		if (!FileExists(backupPath))
+		RBL_SaveIndexEntry entry = m_Index.Find(filename);
+		if (!entry)
 		{
 			PrintFormat("[RBL_SaveFile] No backup found for: %1", filename);
 			return false;
 		}
 		
-		// Copy backup over original
-		bool result = CopyFile(backupPath, filepath);
-		
-		if (result)
-			PrintFormat("[RBL_SaveFile] Restored from backup: %1", filename);
+		bool backupIsAlternate = !entry.Alternate;
+		string backupPath = GetSaveFilePath(filename, entry.Format, backupIsAlternate);
+		if (!ReadSaveFile(backupPath, entry.Format, -1, 0))
+		{
+			PrintFormat("[RBL_SaveFile] No usable backup for: %1", filename);
+			return false;
+		}
 		
-		return result;
+		m_Index.SetCurrentFile(filename, backupIsAlternate, GetFileLength(backupPath), m_iLastReadChecksum);
+		PrintFormat("[RBL_SaveFile] Restored from backup: %1", filename);
+		return true;
 	}
 	
 	// Create manual backup
 	bool CreateBackup(string filename, string backupName)
 	{
-		string filepath = GetSavePath(filename);
-		string backupPath = GetSavePath(backupName);
+		string filepath = GetCurrentPath(filename);
 		
 		if (!FileExists(filepath))
 		{
@@ -282,7 +483,11 @@ class RBL_SaveFileManager
 			return false;
 		}
 		
-		return CopyFile(filepath, backupPath);
+		RBL_SaveData saveData = LoadSaveData(filename);
+		if (!saveData)
+			return false;
+		
+		return WriteSaveData(backupName, saveData);
 	}
 	
 	// ========================================================================
@@ -305,6 +510,60 @@ class RBL_SaveFileManager
 		return SAVE_FOLDER + filename;
 	}
 	
+	// Get full path for filename in the given format
+	string GetSavePathForFormat(string filename, ERBLSaveFormat format)
+	{
+		if (format != ERBLSaveFormat.BINARY)
+			return GetSavePath(filename);
+		
+		return SAVE_FOLDER + filename + BINARY_EXTENSION;
+	}
+	
+	// Path of one file of a save's pair
+	string GetSaveFilePath(string filename, ERBLSaveFormat format, bool alternate)
+	{
+		if (!alternate)
+			return GetSavePathForFormat(filename, format);
+		
+		if (format == ERBLSaveFormat.BINARY)
+			return SAVE_FOLDER + filename + ALTERNATE_SUFFIX + BINARY_EXTENSION;
+		return SAVE_FOLDER + filename + ALTERNATE_SUFFIX + SAVE_EXTENSION;
+	}
+	
+	// Path of the file holding the save's current copy
+	protected string GetCurrentPath(string filename)
+	{
+		RBL_SaveIndexEntry entry = m_Index.Find(filename);
+		if (entry)
+			return GetSaveFilePath(filename, entry.Format, entry.Alternate);
+		
+		string binaryPath = GetSaveFilePath(filename, ERBLSaveFormat.BINARY, false);
+		if (FileExists(binaryPath))
+			return binaryPath;
+		return GetSavePath(filename);
+	}
+	
+	protected ERBLSaveFormat GetOtherFormat(ERBLSaveFormat format)
+	{
+		if (format == ERBLSaveFormat.BINARY)
+			return ERBLSaveFormat.JSON;
+		return ERBLSaveFormat.BINARY;
+	}
+	
+	void SetDefaultFormat(ERBLSaveFormat format) { m_eDefaultFormat = format; }
+	ERBLSaveFormat GetDefaultFormat() { return m_eDefaultFormat; }
+	
+	// Codec for JSON saves; binary saves are already compact and ignore it
+	void SetCodec(ERBLSaveCodec codec, int level)
+	{
+		m_eCodec = codec;
+		m_iCodecLevel = Math.Clamp(level, RBL_SaveCodec.MIN_LEVEL, RBL_SaveCodec.MAX_LEVEL);
+	}
+	ERBLSaveCodec GetCodec() { return m_eCodec; }
+	int GetCodecLevel() { return m_iCodecLevel; }
+	float GetLastCompressionRatio() { return m_fLastCompressionRatio; }
+	int GetLastCompressionMs() { return m_iLastCompressionMs; }
+	
 	// Get filename for slot index
 	string GetSlotFilename(int slotIndex)
 	{
@@ -317,43 +576,18 @@ class RBL_SaveFileManager
 		return FileIO.FileExists(path);
 	}
 	
-	// Copy file
-	protected bool CopyFile(string sourcePath, string destPath)
+	// Get file size
+	int GetFileSize(string filename)
 	{
-		string content = "";
-		
-		// Read source
-		FileHandle sourceFile = FileIO.OpenFile(sourcePath, FileMode.READ);
-		if (!sourceFile)
-			return false;
-		
-		string line;
-		while (sourceFile.ReadLine(line) >= 0)
-		{
-			content += line + "\n";
-		}
-		sourceFile.Close();
-		
-		// Write destination
-		FileHandle destFile = FileIO.OpenFile(destPath, FileMode.WRITE);
-		if (!destFile)
-			return false;
-		
-		destFile.Write(content);
-		destFile.Close();
-		
-		return true;
+		return GetFileLength(GetCurrentPath(filename));
 	}
 	
-	// Get file size
-	int GetFileSize(string filename)
+	protected int GetFileLength(string path)
 	{
-		string filepath = GetSavePath(filename);
-		
-		if (!FileExists(filepath))
+		if (!FileExists(path))
 			return 0;
 		
-		FileHandle file = FileIO.OpenFile(filepath, FileMode.READ);
+		FileHandle file = FileIO.OpenFile(path, FileMode.READ);
 		if (!file)
 			return 0;
 		
@@ -378,11 +612,7 @@ class RBL_SaveFileManager
 	// Validate save file integrity
 	bool ValidateSaveFile(string filename)
 	{
-		string content = ReadFromFile(filename);
-		if (content.IsEmpty())
-			return false;
-		
-		RBL_SaveData saveData = RBL_SaveSerializer.DeserializeFromJson(content);
+		RBL_SaveData saveData = LoadSaveData(filename);
 		if (!saveData)
 			return false;
 		
@@ -392,11 +622,11 @@ class RBL_SaveFileManager
 	// Get save version
 	int GetSaveVersion(string filename)
 	{
-		string content = ReadFromFile(filename);
-		if (content.IsEmpty())
-			return -1;
+		RBL_SaveIndexEntry entry = m_Index.Find(filename);
+		if (entry)
+			return entry.Version;
 		
-		RBL_SaveData saveData = RBL_SaveSerializer.DeserializeFromJson(content);
+		RBL_SaveData saveData = LoadSaveData(filename);
 		if (!saveData)
 			return -1;
 		
@@ -0,0 +1,306 @@
+// ============================================================================
+// PROJECT REBELLION - Save Index
+// Manifest of every save's summary so slot menus and autosave rotation never
+// have to open the saves themselves
+// Written alternately to two files; a reader takes the newest complete copy,
+// so a crash mid-write always leaves the previous index intact
+// ============================================================================
+
+// Summary of one save file
+class RBL_SaveIndexEntry
+{
+	string Name;
+	ERBLSaveFormat Format;
+	// Which of the save's two files holds the current copy; the other is
+	// the previous save and serves as its backup
+	bool Alternate;
+	int Bytes;
+	// Checksum of the current file's content; 0 for binary saves, which
+	// carry their own
+	int Checksum;
+	string SaveTime;
+	int Version;
+	int WarLevel;
+	float PlayTime;
+	int ZonesControlled;
+	int TotalZones;
+	string WorldName;
+}
+
+class RBL_SaveIndex
+{
+	protected static const string INDEX_NAME_A = "index_a.rblindex";
+	protected static const string INDEX_NAME_B = "index_b.rblindex";
+	protected static const string HEADER_TAG = "RBLINDEX";
+	protected static const string FOOTER_TAG = "END";
+	protected static const string SEPARATOR = "|";
+	
+	// Name, format, alternate, bytes, content checksum, time, version, war
+	// level, play time, zones, total, world, line checksum
+	protected const int ENTRY_FIELDS = 13;
+	
+	protected string m_sFolder;
+	protected ref map<string, ref RBL_SaveIndexEntry> m_mEntries;
+	protected int m_iGeneration;
+	protected bool m_bLastWroteA;
+	
+	void RBL_SaveIndex(string folder)
+	{
+		m_sFolder = folder;
+		m_mEntries = new map<string, ref RBL_SaveIndexEntry>();
+		m_iGeneration = 0;
+		m_bLastWroteA = false;
+		
+		Load();
+	}
+	
+	// ========================================================================
+	// QUERIES
+	// ========================================================================
+	
+	RBL_SaveIndexEntry Find(string name)
+	{
+		RBL_SaveIndexEntry entry;
+		m_mEntries.Find(name, entry);
+		return entry;
+	}
+	
+	bool Contains(string name)
+	{
+		return m_mEntries.Contains(name);
+	}
+	
+	void GetNames(notnull array<string> outNames)
+	{
+		outNames.Clear();
+		for (int i = 0; i < m_mEntries.Count(); i++)
+		{
+			outNames.Insert(m_mEntries.GetKey(i));
+		}
+	}
+	
+	int Count() { return m_mEntries.Count(); }
+	
+	// ========================================================================
+	// UPDATES
+	// ========================================================================
+	
+	// Record a save that was just written and persist the index
+	void Update(string name, RBL_SaveData saveData, int bytes, int checksum, ERBLSaveFormat format, bool alternate)
+	{
+		if (name.IsEmpty() || !saveData)
+			return;
+		
+		RBL_SaveIndexEntry entry = new RBL_SaveIndexEntry();
+		entry.Name = name;
+		entry.Format = format;
+		entry.Alternate = alternate;
+		entry.Bytes = bytes;
+		entry.Checksum = checksum;
+		entry.SaveTime = saveData.m_sSaveTime;
+		entry.Version = saveData.m_iVersion;
+		entry.WorldName = saveData.m_sWorldName;
+		
+		if (saveData.m_Campaign)
+		{
+			entry.WarLevel = saveData.m_Campaign.m_iWarLevel;
+			entry.PlayTime = saveData.m_Campaign.m_fTotalPlayTime;
+		}
+		
+		if (saveData.m_aZones)
+		{
+			entry.TotalZones = saveData.m_aZones.Count();
+			foreach (RBL_ZoneSaveData zone : saveData.m_aZones)
+			{
+				if (zone && zone.m_iOwnerFaction == ERBLFactionKey.FIA)
+					entry.ZonesControlled++;
+			}
+		}
+		
+		m_mEntries.Set(name, entry);
+		Write();
+	}
+	
+	// Point an entry at the other file of its pair (backup restore)
+	void SetCurrentFile(string name, bool alternate, int bytes, int checksum)
+	{
+		RBL_SaveIndexEntry entry = Find(name);
+		if (!entry)
+			return;
+		
+		entry.Alternate = alternate;
+		entry.Bytes = bytes;
+		entry.Checksum = checksum;
+		Write();
+	}
+	
+	void Remove(string name)
+	{
+		if (!m_mEntries.Contains(name))
+			return;
+		
+		m_mEntries.Remove(name);
+		Write();
+	}
+	
+	// ========================================================================
+	// PERSISTENCE
+	// ========================================================================
+	
+	protected void Load()
+	{
+		map<string, ref RBL_SaveIndexEntry> entriesA = new map<string, ref RBL_SaveIndexEntry>();
+		map<string, ref RBL_SaveIndexEntry> entriesB = new map<string, ref RBL_SaveIndexEntry>();
+		int generationA = ReadIndexFile(m_sFolder + INDEX_NAME_A, entriesA);
+		int generationB = ReadIndexFile(m_sFolder + INDEX_NAME_B, entriesB);
+		
+		if (generationA < 0 && generationB < 0)
+			return;
+		
+		if (generationA >= generationB)
+		{
+			m_mEntries = entriesA;
+			m_iGeneration = generationA;
+			m_bLastWroteA = true;
+		}
+		else
+		{
+			m_mEntries = entriesB;
+			m_iGeneration = generationB;
+			m_bLastWroteA = false;
+		}
+		
+		PrintFormat("[RBL_SaveIndex] Loaded %1 entries (generation %2)", m_mEntries.Count(), m_iGeneration);
+	}
+	
+	// Returns the file's generation, or -1 if it is missing or incomplete
+	protected int ReadIndexFile(string path, map<string, ref RBL_SaveIndexEntry> outEntries)
+	{
+		if (!FileIO.FileExists(path))
+			return -1;
+		
+		FileHandle file = FileIO.OpenFile(path, FileMode.READ);
+		if (!file)
+			return -1;
+		
+		array<string> fields = new array<string>();
+		string line;
+		int generation = -1;
+		int expected = 0;
+		int entryLines = 0;
+		bool complete = false;
+		
+		if (file.ReadLine(line) >= 0)
+		{
+			line.Split(SEPARATOR, fields, false);
+			if (fields.Count() == 3 && fields[0] == HEADER_TAG)
+			{
+				generation = fields[1].ToInt();
+				expected = fields[2].ToInt();
+			}
+		}
+		
+		while (generation >= 0 && file.ReadLine(line) >= 0)
+		{
+			fields.Clear();
+			line.Split(SEPARATOR, fields, false);
+			
+			if (fields.Count() == 2 && fields[0] == FOOTER_TAG)
+			{
+				complete = fields[1].ToInt() == generation && entryLines == expected;
+				break;
+			}
+			
+			entryLines++;
+			RBL_SaveIndexEntry entry = ParseEntry(line, fields);
+			if (entry)
+				outEntries.Set(entry.Name, entry);
+		}
+		file.Close();
+		
+		if (!complete)
+		{
+			outEntries.Clear();
+			return -1;
+		}
+		return generation;
+	}
+	
+	// Write the next generation into whichever file does not hold the current one
+	protected void Write()
+	{
+		m_iGeneration++;
+		m_bLastWroteA = !m_bLastWroteA;
+		
+		string path = m_sFolder + INDEX_NAME_B;
+		if (m_bLastWroteA)
+			path = m_sFolder + INDEX_NAME_A;
+		
+		FileHandle file = FileIO.OpenFile(path, FileMode.WRITE);
+		if (!file)
+		{
+			PrintFormat("[RBL_SaveIndex] Failed to open index for writing: %1", path);
+			return;
+		}
+		
+		file.WriteLine(HEADER_TAG + SEPARATOR + m_iGeneration.ToString() + SEPARATOR + m_mEntries.Count().ToString());
+		for (int i = 0; i < m_mEntries.Count(); i++)
+		{
+			file.WriteLine(FormatEntry(m_mEntries.GetElement(i)));
+		}
+		file.WriteLine(FOOTER_TAG + SEPARATOR + m_iGeneration.ToString());
+		file.Close();
+	}
+	
+	// ========================================================================
+	// ENTRY FORMAT
+	// ========================================================================
+	
+	protected string FormatEntry(RBL_SaveIndexEntry entry)
+	{
+		int format = entry.Format;
+		int alternate = entry.Alternate;
+		string body = entry.Name + SEPARATOR + format.ToString() + SEPARATOR + alternate.ToString();
+		body += SEPARATOR + entry.Bytes.ToString() + SEPARATOR + entry.Checksum.ToString();
+		body += SEPARATOR + Clean(entry.SaveTime) + SEPARATOR + entry.Version.ToString();
+		body += SEPARATOR + entry.WarLevel.ToString() + SEPARATOR + entry.PlayTime.ToString();
+		body += SEPARATOR + entry.ZonesControlled.ToString() + SEPARATOR + entry.TotalZones.ToString();
+		body += SEPARATOR + Clean(entry.WorldName);
+		return body + SEPARATOR + body.Hash().ToString();
+	}
+	
+	// Entries whose checksum does not match their fields are dropped; the
+	// save is re-indexed from the file the next time it is listed
+	protected RBL_SaveIndexEntry ParseEntry(string line, array<string> fields)
+	{
+		if (fields.Count() != ENTRY_FIELDS)
+			return null;
+		
+		string checksum = fields[ENTRY_FIELDS - 1];
+		string body = line.Substring(0, line.Length() - checksum.Length() - SEPARATOR.Length());
+		if (body.Hash() != checksum.ToInt())
+			return null;
+		
+		RBL_SaveIndexEntry entry = new RBL_SaveIndexEntry();
+		entry.Name = fields[0];
+		entry.Format = fields[1].ToInt();
+		entry.Alternate = fields[2].ToInt() != 0;
+		entry.Bytes = fields[3].ToInt();
+		entry.Checksum = fields[4].ToInt();
+		entry.SaveTime = fields[5];
+		entry.Version = fields[6].ToInt();
+		entry.WarLevel = fields[7].ToInt();
+		entry.PlayTime = fields[8].ToFloat();
+		entry.ZonesControlled = fields[9].ToInt();
+		entry.TotalZones = fields[10].ToInt();
+		entry.WorldName = fields[11];
+		return entry;
+	}
+	
+	protected string Clean(string value)
+	{
+		string cleaned = value;
+		cleaned.Replace(SEPARATOR, "/");
+		return cleaned;
+	}
+}
@@ -0,0 +1,600 @@
+// ============================================================================
+// PROJECT REBELLION - Save Journal
+// Append-only log of campaign state changes written between full snapshots
+// Recovery loads the snapshot named in the journal header and replays the
+// entries on top of it; compaction writes a new snapshot and truncates the log
+// ============================================================================
+
+class RBL_SaveJournal
+{
+	protected static ref RBL_SaveJournal s_Instance;
+	
+	protected static const string JOURNAL_PATH = "$profile:Rebellion/saves/campaign.rbljournal";
+	protected static const string SEPARATOR = "|";
+	
+	// Entry tags. Every entry stores the resulting value rather than a delta,
+	// so replaying an entry the snapshot already contains is harmless
+	static const string TAG_BASE = "B";
+	static const string TAG_ZONE_OWNER = "Z";
+	static const string TAG_BALANCE = "E";
+	static const string TAG_ARSENAL = "A";
+	static const string TAG_UNLOCK = "U";
+	static const string TAG_MISSION_STARTED = "MS";
+	static const string TAG_MISSION_COMPLETED = "MC";
+	static const string TAG_MISSION_FAILED = "MF";
+	
+	// Pending entries are appended to disk at most this often
+	protected const float FLUSH_INTERVAL = 2.0;
+	
+	// Past this many entries on disk a snapshot is taken early
+	protected const int COMPACTION_THRESHOLD = 500;
+	
+	protected ref array<string> m_aPending;
+	protected string m_sBaseSnapshot;
+	protected int m_iEntriesOnDisk;
+	protected float m_fTimeSinceFlush;
+	protected bool m_bInitialized;
+	protected bool m_bSuspended;
+	protected bool m_bCompactionQueued;
+	
+	// Stats
+	protected int m_iTotalFlushes;
+	protected int m_iTotalCompactions;
+	
+	// ========================================================================
+	// SINGLETON
+	// ========================================================================
+	
+	static RBL_SaveJournal GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new RBL_SaveJournal();
+		return s_Instance;
+	}
+	
+	void RBL_SaveJournal()
+	{
+		m_aPending = new array<string>();
+		m_sBaseSnapshot = "";
+		m_iEntriesOnDisk = 0;
+		m_fTimeSinceFlush = 0;
+		m_bInitialized = false;
+		m_bSuspended = false;
+		m_bCompactionQueued = false;
+		m_iTotalFlushes = 0;
+		m_iTotalCompactions = 0;
+	}
+	
+	// ========================================================================
+	// INITIALIZATION
+	// ========================================================================
+	
+	void Initialize()
+	{
+		if (m_bInitialized)
+			return;
+		
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (zoneMgr)
+			zoneMgr.GetOnZoneOwnershipChanged().Insert(OnZoneOwnershipChanged);
+		
+		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
+		if (econMgr)
+		{
+			econMgr.GetOnBalanceChanged().Insert(OnBalanceChanged);
+			econMgr.GetOnItemDeposited().Insert(OnArsenalChanged);
+			econMgr.GetOnItemWithdrawn().Insert(OnArsenalChanged);
+			econMgr.GetOnItemUnlocked().Insert(OnItemUnlocked);
+		}
+		
+		RBL_MissionManager missionMgr = RBL_MissionManager.GetInstance();
+		if (missionMgr)
+		{
+			missionMgr.GetOnMissionStarted().Insert(OnMissionStarted);
+			missionMgr.GetOnMissionCompleted().Insert(OnMissionCompleted);
+			missionMgr.GetOnMissionFailed().Insert(OnMissionFailed);
+		}
+		
+		// Restoring replays state through the same setters; none of that
+		// belongs in the journal
+		RBL_SaveRestorer restorer = RBL_SaveRestorer.GetInstance();
+		restorer.GetOnRestoreStart().Insert(OnRestoreStart);
+		restorer.GetOnRestoreComplete().Insert(OnRestoreComplete);
+		restorer.GetOnRestoreFailed().Insert(OnRestoreFailed);
+		
+		m_bInitialized = true;
+		PrintFormat("[RBL_Journal] Journal initialized: %1", JOURNAL_PATH);
+	}
+	
+	// ========================================================================
+	// UPDATE
+	// ========================================================================
+	
+	void Update(float timeSlice)
+	{
+		if (!m_bInitialized)
+			return;
+		
+		m_fTimeSinceFlush += timeSlice;
+		if (m_fTimeSinceFlush < FLUSH_INTERVAL)
+			return;
+		
+		Flush();
+	}
+	
+	// ========================================================================
+	// RECORDING
+	// ========================================================================
+	
+	protected void OnZoneOwnershipChanged(string zoneID, ERBLFactionKey previousOwner, ERBLFactionKey newOwner)
+	{
+		// Zone refreshes re-announce the current owner
+		if (previousOwner == newOwner)
+			return;
+		
+		int owner = newOwner;
+		int previous = previousOwner;
+		Record(TAG_ZONE_OWNER + SEPARATOR + Clean(zoneID) + SEPARATOR + owner.ToString() + SEPARATOR + previous.ToString());
+		
+		// Captures are too costly to lose to a crash; write them straight away
+		Flush();
+	}
+	
+	// One entry per committed economy transaction
+	protected void OnBalanceChanged(int newMoney, int newHR)
+	{
+		Record(TAG_BALANCE + SEPARATOR + newMoney.ToString() + SEPARATOR + newHR.ToString());
+	}
+	
+	protected void OnArsenalChanged(string itemPrefab, int newCount)
+	{
+		Record(TAG_ARSENAL + SEPARATOR + Clean(itemPrefab) + SEPARATOR + newCount.ToString());
+	}
+	
+	protected void OnItemUnlocked(string itemID)
+	{
+		Record(TAG_UNLOCK + SEPARATOR + Clean(itemID));
+	}
+	
+	protected void OnMissionStarted(RBL_Mission mission)
+	{
+		if (!mission)
+			return;
+		
+		vector area = mission.GetMissionArea();
+		int rewardMoney = 0;
+		int rewardHR = 0;
+		RBL_MissionReward reward = mission.GetReward();
+		if (reward)
+		{
+			rewardMoney = reward.GetMoney();
+			rewardHR = reward.GetHR();
+		}
+		
+		string entry = TAG_MISSION_STARTED + SEPARATOR + Clean(mission.GetID());
+		entry += SEPARATOR + Clean(mission.GetTypeString()) + SEPARATOR + Clean(mission.GetName());
+		entry += SEPARATOR + Clean(mission.GetTargetZoneID());
+		entry += SEPARATOR + area[0].ToString() + SEPARATOR + area[1].ToString() + SEPARATOR + area[2].ToString();
+		entry += SEPARATOR + mission.GetObjectiveCount().ToString() + SEPARATOR + mission.GetTimeLimit().ToString();
+		entry += SEPARATOR + rewardMoney.ToString() + SEPARATOR + rewardHR.ToString();
+		Record(entry);
+	}
+	
+	protected void OnMissionCompleted(RBL_Mission mission)
+	{
+		if (!mission)
+			return;
+		
+		Record(TAG_MISSION_COMPLETED + SEPARATOR + Clean(mission.GetID()));
+		Flush();
+	}
+	
+	protected void OnMissionFailed(RBL_Mission mission)
+	{
+		if (!mission)
+			return;
+		
+		Record(TAG_MISSION_FAILED + SEPARATOR + Clean(mission.GetID()));
+		Flush();
+	}
+	
+	protected void Record(string entry)
+	{
+		if (!m_bInitialized || m_bSuspended)
+			return;
+		
+		m_aPending.Insert(entry);
+	}
+	
+	// Separators inside IDs or names would split the entry on replay
+	protected string Clean(string value)
+	{
+		if (value.IndexOf(SEPARATOR) == -1)
+			return value;
+		
+		string cleaned = value;
+		cleaned.Replace(SEPARATOR, "/");
+		return cleaned;
+	}
+	
+	// ========================================================================
+	// FLUSH
+	// ========================================================================
+	
+	// Append pending entries to disk. Cheap enough to call on every event
+	// worth protecting (captures, mission results)
+	bool Flush()
+	{
+		m_fTimeSinceFlush = 0;
+		
+		if (m_aPending.IsEmpty())
+			return true;
+		
+		// Without a snapshot to replay onto, entries are meaningless; the
+		// first compaction writes one
+		if (m_sBaseSnapshot.IsEmpty())
+		{
+			RequestCompaction("No base snapshot");
+			return false;
+		}
+		
+		FileHandle file = FileIO.OpenFile(JOURNAL_PATH, FileMode.APPEND);
+		if (!file)
+		{
+			PrintFormat("[RBL_Journal] Failed to open journal for append: %1", JOURNAL_PATH);
+			return false;
+		}
+		
+		foreach (string entry : m_aPending)
+		{
+			file.WriteLine(entry);
+		}
+		file.Close();
+		
+		m_iEntriesOnDisk += m_aPending.Count();
+		m_aPending.Clear();
+		m_iTotalFlushes++;
+		
+		if (m_iEntriesOnDisk >= COMPACTION_THRESHOLD)
+			RequestCompaction("Journal size");
+		
+		return true;
+	}
+	
+	// ========================================================================
+	// COMPACTION
+	// ========================================================================
+	
+	// Queue a full snapshot. It runs from the call queue, never inside the
+	// event that asked for it
+	void RequestCompaction(string reason)
+	{
+		if (m_bCompactionQueued || m_bSuspended)
+			return;
+		
+		m_bCompactionQueued = true;
+		GetGame().GetCallqueue().CallLater(RunCompaction, 0, false, reason);
+	}
+	
+	protected void RunCompaction(string reason)
+	{
+		m_bCompactionQueued = false;
+		
+		RBL_AutoSaveManager autoSave = RBL_AutoSaveManager.GetInstance();
+		if (autoSave.IsSaving())
+			return;
+		
+		// OnSnapshotWritten truncates the journal once the snapshot is on disk
+		autoSave.TriggerAutoSave("Journal compaction: " + reason);
+	}
+	
+	// A full snapshot now holds everything recorded so far: start a fresh
+	// journal on top of it
+	void OnSnapshotWritten(string snapshotName)
+	{
+		FileHandle file = FileIO.OpenFile(JOURNAL_PATH, FileMode.WRITE);
+		if (!file)
+		{
+			PrintFormat("[RBL_Journal] Failed to reset journal: %1", JOURNAL_PATH);
+			return;
+		}
+		
+		file.WriteLine(TAG_BASE + SEPARATOR + snapshotName);
+		file.Close();
+		
+		m_sBaseSnapshot = snapshotName;
+		m_iEntriesOnDisk = 0;
+		m_aPending.Clear();
+		m_iTotalCompactions++;
+		
+		PrintFormat("[RBL_Journal] Compacted onto snapshot %1", snapshotName);
+	}
+	
+	// ========================================================================
+	// RECOVERY
+	// ========================================================================
+	
+	bool HasRecoverableJournal()
+	{
+		return !ReadBaseSnapshot().IsEmpty();
+	}
+	
+	// Load the base snapshot and apply every journal entry to it
+	RBL_SaveData LoadRecoveryData()
+	{
+		array<string> lines = ReadJournalLines();
+		if (lines.IsEmpty())
+			return null;
+		
+		string baseName = GetBaseName(lines[0]);
+		if (baseName.IsEmpty())
+		{
+			PrintFormat("[RBL_Journal] Journal has no base snapshot header");
+			return null;
+		}
+		
+		RBL_SaveData saveData = RBL_SaveFileManager.GetInstance().LoadSaveData(baseName);
+		if (!saveData)
+		{
+			PrintFormat("[RBL_Journal] Base snapshot missing or unreadable: %1", baseName);
+			return null;
+		}
+		
+		int applied = 0;
+		for (int i = 1; i < lines.Count(); i++)
+		{
+			if (ApplyEntry(saveData, lines[i]))
+				applied++;
+		}
+		
+		PrintFormat("[RBL_Journal] Recovered %1 + %2 journal entries", baseName, applied);
+		return saveData;
+	}
+	
+	protected string ReadBaseSnapshot()
+	{
+		if (!FileIO.FileExists(JOURNAL_PATH))
+			return "";
+		
+		FileHandle file = FileIO.OpenFile(JOURNAL_PATH, FileMode.READ);
+		if (!file)
+			return "";
+		
+		string line;
+		string baseName = "";
+		if (file.ReadLine(line) >= 0)
+			baseName = GetBaseName(line);
+		file.Close();
+		
+		if (baseName.IsEmpty() || !RBL_SaveFileManager.GetInstance().SaveExists(baseName))
+			return "";
+		return baseName;
+	}
+	
+	protected array<string> ReadJournalLines()
+	{
+		array<string> lines = new array<string>();
+		string content = RBL_FileReader.ReadAll(JOURNAL_PATH);
+		if (content.IsEmpty())
+			return lines;
+		
+		content.Split("\n", lines, true);
+		
+		// WriteLine may end lines with CRLF
+		for (int i = 0; i < lines.Count(); i++)
+		{
+			lines[i] = lines[i].Trim();
+		}
+		return lines;
+	}
+	
+	protected string GetBaseName(string headerLine)
+	{
+		array<string> fields = new array<string>();
+		headerLine.Split(SEPARATOR, fields, false);
+		if (fields.Count() < 2 || fields[0] != TAG_BASE)
+			return "";
+		return fields[1];
+	}
+	
+	// A torn final line from a crash mid-append fails the field count check
+	// and is skipped
+	protected bool ApplyEntry(RBL_SaveData saveData, string line)
+	{
+		array<string> fields = new array<string>();
+		line.Split(SEPARATOR, fields, false);
+		if (fields.IsEmpty())
+			return false;
+		
+		string tag = fields[0];
+		
+		if (tag == TAG_ZONE_OWNER && fields.Count() >= 4)
+			return ApplyZoneOwner(saveData, fields[1], fields[2].ToInt(), fields[3].ToInt());
+		
+		if (tag == TAG_BALANCE && fields.Count() >= 3 && saveData.m_Economy)
+		{
+			saveData.m_Economy.m_iFIAMoney = fields[1].ToInt();
+			saveData.m_Economy.m_iFIAHumanResources = fields[2].ToInt();
+			return true;
+		}
+		
+		if (tag == TAG_ARSENAL && fields.Count() >= 3)
+			return ApplyArsenalCount(saveData, fields[1], fields[2].ToInt());
+		
+		if (tag == TAG_UNLOCK && fields.Count() >= 2)
+			return ApplyUnlock(saveData, fields[1]);
+		
+		if (tag == TAG_MISSION_STARTED && fields.Count() >= 12)
+			return ApplyMissionStarted(saveData, fields);
+		
+		if ((tag == TAG_MISSION_COMPLETED || tag == TAG_MISSION_FAILED) && fields.Count() >= 2)
+			return ApplyMissionResult(saveData, fields[1], tag == TAG_MISSION_COMPLETED);
+		
+		return false;
+	}
+	
+	protected bool ApplyZoneOwner(RBL_SaveData saveData, string zoneID, int newOwner, int previousOwner)
+	{
+		if (!saveData.m_aZones)
+			return false;
+		
+		foreach (RBL_ZoneSaveData zone : saveData.m_aZones)
+		{
+			if (!zone || zone.m_sZoneID != zoneID)
+				continue;
+			
+			zone.m_iPreviousOwner = previousOwner;
+			zone.m_iOwnerFaction = newOwner;
+			zone.m_fCaptureProgress = 0;
+			return true;
+		}
+		return false;
+	}
+	
+	protected bool ApplyArsenalCount(RBL_SaveData saveData, string itemID, int count)
+	{
+		if (!saveData.m_Economy)
+			return false;
+		
+		if (!saveData.m_Economy.m_aArsenalItems)
+			saveData.m_Economy.m_aArsenalItems = new array<ref RBL_ArsenalItemSave>();
+		
+		// Older snapshots may spell the ID with different case
+		string normalized = RBL_ItemRegistry.Normalize(itemID);
+		foreach (RBL_ArsenalItemSave item : saveData.m_Economy.m_aArsenalItems)
+		{
+			if (item && RBL_ItemRegistry.Normalize(item.m_sItemID) == normalized)
+			{
+				item.m_iQuantity = count;
+				return true;
+			}
+		}
+		
+		saveData.m_Economy.m_aArsenalItems.Insert(new RBL_ArsenalItemSave(itemID, count));
+		return true;
+	}
+	
+	protected bool ApplyUnlock(RBL_SaveData saveData, string itemID)
+	{
+		if (!saveData.m_Economy)
+			return false;
+		
+		if (!saveData.m_Economy.m_aUnlockedItems)
+			saveData.m_Economy.m_aUnlockedItems = new array<string>();
+		
+		if (saveData.m_Economy.m_aUnlockedItems.Find(itemID) == -1)
+			saveData.m_Economy.m_aUnlockedItems.Insert(itemID);
+		return true;
+	}
+	
+	protected bool ApplyMissionStarted(RBL_SaveData saveData, array<string> fields)
+	{
+		if (!saveData.m_aMissions)
+			saveData.m_aMissions = new array<ref RBL_MissionSaveData>();
+		
+		if (FindMission(saveData, fields[1]))
+			return true;
+		
+		RBL_MissionSaveData data = new RBL_MissionSaveData();
+		data.m_sMissionID = fields[1];
+		data.m_sMissionType = fields[2];
+		data.m_sMissionName = fields[3];
+		data.m_sTargetZone = fields[4];
+		data.m_vTargetPosition = Vector(fields[5].ToFloat(), fields[6].ToFloat(), fields[7].ToFloat());
+		data.m_iTotalObjectives = fields[8].ToInt();
+		data.m_fTimeLimit = fields[9].ToFloat();
+		data.m_fTimeRemaining = data.m_fTimeLimit;
+		data.m_iMoneyReward = fields[10].ToInt();
+		data.m_iHRReward = fields[11].ToInt();
+		data.m_bIsActive = true;
+		
+		saveData.m_aMissions.Insert(data);
+		return true;
+	}
+	
+	protected bool ApplyMissionResult(RBL_SaveData saveData, string missionID, bool completed)
+	{
+		RBL_MissionSaveData data = FindMission(saveData, missionID);
+		if (!data)
+			return false;
+		
+		data.m_bIsActive = false;
+		data.m_bIsCompleted = completed;
+		data.m_bIsFailed = !completed;
+		return true;
+	}
+	
+	protected RBL_MissionSaveData FindMission(RBL_SaveData saveData, string missionID)
+	{
+		if (!saveData.m_aMissions)
+			return null;
+		
+		foreach (RBL_MissionSaveData data : saveData.m_aMissions)
+		{
+			if (data && data.m_sMissionID == missionID)
+				return data;
+		}
+		return null;
+	}
+	
+	// ========================================================================
+	// RESTORE EVENTS
+	// ========================================================================
+	
+	protected void OnRestoreStart()
+	{
+		m_bSuspended = true;
+		m_aPending.Clear();
+	}
+	
+	protected void OnRestoreComplete(RBL_RestoreResult result)
+	{
+		m_bSuspended = false;
+		
+		// The restored state becomes the new base
+		RequestCompaction("Restore complete");
+	}
+	
+	protected void OnRestoreFailed(string reason)
+	{
+		m_bSuspended = false;
+	}
+	
+	// ========================================================================
+	// ACCESSORS
+	// ========================================================================
+	
+	string GetBaseSnapshot() { return m_sBaseSnapshot; }
+	int GetPendingCount() { return m_aPending.Count(); }
+	int GetEntriesOnDisk() { return m_iEntriesOnDisk; }
+	int GetTotalFlushes() { return m_iTotalFlushes; }
+	int GetTotalCompactions() { return m_iTotalCompactions; }
+}
+
+// ============================================================================
+// DEBUG COMMANDS
+// ============================================================================
+class RBL_SaveJournalCommands
+{
+	static void PrintStats()
+	{
+		RBL_SaveJournal journal = RBL_SaveJournal.GetInstance();
+		
+		PrintFormat("[RBL_Journal] === SAVE JOURNAL ===");
+		PrintFormat("Base snapshot: %1", journal.GetBaseSnapshot());
+		PrintFormat("Pending entries: %1", journal.GetPendingCount());
+		PrintFormat("Entries on disk: %1", journal.GetEntriesOnDisk());
+		PrintFormat("Flushes: %1", journal.GetTotalFlushes());
+		PrintFormat("Compactions: %1", journal.GetTotalCompactions());
+	}
+	
+	static void Flush()
+	{
+		RBL_SaveJournal.GetInstance().Flush();
+	}
+	
+	static void Compact()
+	{
+		RBL_SaveJournal.GetInstance().RequestCompaction("Manual");
+	}
+}
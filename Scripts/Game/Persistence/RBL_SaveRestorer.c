@@ -13,6 +13,12 @@ class RBL_SaveRestorer
 	protected ref RBL_SaveData m_PendingRestore;
 	protected ref RBL_RestoreResult m_RestoreResult;
 	
+	// Pipeline state. Chunked phases walk their save array with the cursor
+	protected int m_iPhaseCursor;
+	protected bool m_bPhaseDone;
+	protected int m_iPhaseStartTick;
+	protected int m_iRestoreStartTick;
+	
 	// Callbacks
 	protected ref ScriptInvoker m_OnRestoreStart;
 	protected ref ScriptInvoker m_OnRestoreProgress;
@@ -24,11 +30,16 @@ class RBL_SaveRestorer
 	protected const int PHASE_CAMPAIGN = 1;
 	protected const int PHASE_ZONES = 2;
 	protected const int PHASE_ECONOMY = 3;
-	protected const int PHASE_PLAYERS = 4;
-	protected const int PHASE_COMMANDER = 5;
-	protected const int PHASE_MISSIONS = 6;
-	protected const int PHASE_FINALIZE = 7;
-	protected const int PHASE_COMPLETE = 8;
+	protected const int PHASE_VEHICLES = 4;
+	protected const int PHASE_PLAYERS = 5;
+	protected const int PHASE_COMMANDER = 6;
+	protected const int PHASE_MISSIONS = 7;
+	protected const int PHASE_FINALIZE = 8;
+	protected const int PHASE_COMPLETE = 9;
+	
+	// Milliseconds of restore work per frame. Phases run back to back until
+	// the budget is spent; at least one unit of work always runs
+	protected const int FRAME_BUDGET_MS = 8;
 	
 	// ========================================================================
 	// SINGLETON
@@ -45,6 +56,8 @@ class RBL_SaveRestorer
 	{
 		m_bIsRestoring = false;
 		m_iRestorePhase = 0;
+		m_iPhaseCursor = 0;
+		m_bPhaseDone = false;
 		m_OnRestoreStart = new ScriptInvoker();
 		m_OnRestoreProgress = new ScriptInvoker();
 		m_OnRestoreComplete = new ScriptInvoker();
@@ -75,12 +88,14 @@ class RBL_SaveRestorer
 		m_bIsRestoring = true;
 		m_iRestorePhase = PHASE_VALIDATE;
 		m_RestoreResult = new RBL_RestoreResult();
+		m_iRestoreStartTick = System.GetTickCount();
 		
 		PrintFormat("[RBL_SaveRestorer] Starting restoration...");
 		m_OnRestoreStart.Invoke();
+		BeginPhase();
 		
-		// Start phased restoration
-		ProcessNextPhase();
+		// First frame of the pipeline runs now
+		ProcessPipeline();
 		
 		return true;
 	}
@@ -102,15 +117,13 @@ class RBL_SaveRestorer
 	bool StartRestoreFromFile(string filename)
 	{
 		RBL_SaveFileManager fileMgr = RBL_SaveFileManager.GetInstance();
-		string json = fileMgr.ReadFromFile(filename);
-		
-		if (json.IsEmpty())
+		if (!fileMgr.SaveExists(filename))
 		{
 			m_OnRestoreFailed.Invoke("Failed to read file: " + filename);
 			return false;
 		}
 		
-		RBL_SaveData saveData = RBL_SaveSerializer.DeserializeFromJson(json);
+		RBL_SaveData saveData = fileMgr.LoadSaveData(filename);
 		if (!saveData)
 		{
 			m_OnRestoreFailed.Invoke("Failed to parse save file");
@@ -124,63 +137,107 @@ class RBL_SaveRestorer
 	// PHASED RESTORATION
 	// ========================================================================
 	
-	protected void ProcessNextPhase()
+	// Run phases back to back until the frame budget is spent, then resume
+	// next frame
+	protected void ProcessPipeline()
 	{
 		if (!m_bIsRestoring || !m_PendingRestore)
 			return;
 		
-		bool success = true;
-		string phaseName = GetPhaseName(m_iRestorePhase);
+		m_RestoreResult.m_iFramesUsed++;
+		int frameStart = System.GetTickCount();
+		
+		while (true)
+		{
+			if (m_iRestorePhase == PHASE_COMPLETE)
+			{
+				CompleteRestore();
+				return;
+			}
+			
+			if (!StepPhase())
+			{
+				FailRestore("Phase failed: " + GetPhaseName(m_iRestorePhase));
+				return;
+			}
+			
+			if (m_bPhaseDone)
+				EndPhase();
+			
+			if (System.GetTickCount() - frameStart >= FRAME_BUDGET_MS)
+				break;
+		}
 		
-		PrintFormat("[RBL_SaveRestorer] Phase %1: %2", m_iRestorePhase, phaseName);
+		GetGame().GetCallqueue().CallLater(ProcessPipeline, 0, false);
+	}
+	
+	// One unit of work in the current phase. Single-step phases finish in
+	// one call; chunked phases restore one entry per call
+	protected bool StepPhase()
+	{
+		// Single-step phases are done unless a chunked phase says otherwise
+		m_bPhaseDone = true;
 		
 		switch (m_iRestorePhase)
 		{
 			case PHASE_VALIDATE:
-				success = PhaseValidate();
-				break;
+				return PhaseValidate();
 			case PHASE_CAMPAIGN:
-				success = PhaseCampaign();
-				break;
+				return PhaseCampaign();
 			case PHASE_ZONES:
-				success = PhaseZones();
-				break;
+				return PhaseZones();
 			case PHASE_ECONOMY:
-				success = PhaseEconomy();
-				break;
+				return PhaseEconomy();
+			case PHASE_VEHICLES:
+				return PhaseVehicles();
 			case PHASE_PLAYERS:
-				success = PhasePlayers();
-				break;
+				return PhasePlayers();
 			case PHASE_COMMANDER:
-				success = PhaseCommander();
-				break;
+				return PhaseCommander();
 			case PHASE_MISSIONS:
-				success = PhaseMissions();
-				break;
+				return PhaseMissions();
 			case PHASE_FINALIZE:
-				success = PhaseFinalize();
-				break;
-			case PHASE_COMPLETE:
-				CompleteRestore();
-				return;
+				return PhaseFinalize();
 		}
+		return true;
+	}
+	
+	protected void BeginPhase()
+	{
+		m_iPhaseCursor = 0;
+		m_bPhaseDone = false;
+		m_iPhaseStartTick = System.GetTickCount();
+		
+		PrintFormat("[RBL_SaveRestorer] Phase %1: %2", m_iRestorePhase, GetPhaseName(m_iRestorePhase));
+	}
+	
+	// Record the phase's time, report progress and move on
+	protected void EndPhase()
+	{
+		int elapsed = System.GetTickCount() - m_iPhaseStartTick;
+		m_RestoreResult.m_aPhaseTimes.Insert(elapsed);
 		
-		// Invoke progress callback
+		string phaseName = GetPhaseName(m_iRestorePhase);
 		float progress = m_iRestorePhase / (float)PHASE_COMPLETE;
 		m_OnRestoreProgress.Invoke(progress, phaseName);
 		
-		if (success)
-		{
-			// Move to next phase
-			m_iRestorePhase++;
-			// Schedule next phase (allows UI to update)
-			GetGame().GetCallqueue().CallLater(ProcessNextPhase, 100, false);
-		}
-		else
+		m_iRestorePhase++;
+		if (m_iRestorePhase != PHASE_COMPLETE)
+			BeginPhase();
+	}
+	
+	// Chunked phases: true while the cursor still points into the array,
+	// otherwise marks the phase done
+	protected bool HasNextEntry(int count)
+	{
+		if (m_iPhaseCursor < count)
 		{
-			// Phase failed
-			FailRestore("Phase failed: " + phaseName);
+			m_bPhaseDone = false;
+			return true;
 		}
+		
+		m_bPhaseDone = true;
+		return false;
 	}
 	
 	// ========================================================================
@@ -235,15 +292,23 @@ class RBL_SaveRestorer
 		return success;
 	}
 	
-	// Phase 2: Restore zones
+	// Phase 2: Restore zones, one per step
 	protected bool PhaseZones()
 	{
-		if (!m_PendingRestore.m_aZones || m_PendingRestore.m_aZones.IsEmpty())
+		if (!m_PendingRestore.m_aZones)
 			return true; // No zone data, skip
 		
-		int restored = RBL_ZonePersistence.GetInstance().RestoreAllZoneStates(m_PendingRestore.m_aZones);
-		m_RestoreResult.m_iZonesRestored = restored;
-		m_RestoreResult.m_bZonesRestored = (restored > 0);
+		if (!HasNextEntry(m_PendingRestore.m_aZones.Count()))
+		{
+			m_RestoreResult.m_bZonesRestored = (m_RestoreResult.m_iZonesRestored > 0);
+			return true;
+		}
+		
+		RBL_ZoneSaveData zoneData = m_PendingRestore.m_aZones[m_iPhaseCursor];
+		m_iPhaseCursor++;
+		
+		if (zoneData && RBL_ZonePersistence.GetInstance().RestoreZoneEntry(zoneData))
+			m_RestoreResult.m_iZonesRestored++;
 		
 		return true; // Don't fail on partial zone restore
 	}
@@ -254,26 +319,54 @@ class RBL_SaveRestorer
 		if (!m_PendingRestore.m_Economy)
 			return true; // No economy data, skip
 		
-		bool success = RBL_EconomyPersistence.GetInstance().RestoreEconomyState(m_PendingRestore.m_Economy);
+		// Vehicles are respawned by the next phase
+		bool success = RBL_EconomyPersistence.GetInstance().RestoreEconomyState(m_PendingRestore.m_Economy, false);
 		m_RestoreResult.m_bEconomyRestored = success;
 		
 		return success;
 	}
 	
-	// Phase 4: Restore players
+	// Phase 4: Respawn the vehicle pool, one vehicle per step
+	protected bool PhaseVehicles()
+	{
+		RBL_EconomySaveData economy = m_PendingRestore.m_Economy;
+		if (!economy || !economy.m_aVehiclePool)
+			return true; // No vehicle data, skip
+		
+		RBL_EconomyPersistence econPersist = RBL_EconomyPersistence.GetInstance();
+		if (m_iPhaseCursor == 0)
+			econPersist.ClearVehiclePool();
+		
+		if (!HasNextEntry(economy.m_aVehiclePool.Count()))
+			return true;
+		
+		if (econPersist.RestoreVehicle(economy.m_aVehiclePool[m_iPhaseCursor]))
+			m_RestoreResult.m_iVehiclesRestored++;
+		m_iPhaseCursor++;
+		
+		return true; // Don't fail on partial vehicle restore
+	}
+	
+	// Phase 5: Restore players, one per step
 	protected bool PhasePlayers()
 	{
-		if (!m_PendingRestore.m_aPlayers || m_PendingRestore.m_aPlayers.IsEmpty())
+		if (!m_PendingRestore.m_aPlayers)
 			return true; // No player data, skip
 		
-		int restored = RBL_PlayerPersistence.GetInstance().RestoreAllPlayerStates(m_PendingRestore.m_aPlayers);
-		m_RestoreResult.m_iPlayersRestored = restored;
-		m_RestoreResult.m_bPlayersRestored = true; // Don't fail on partial player restore
+		if (!HasNextEntry(m_PendingRestore.m_aPlayers.Count()))
+		{
+			m_RestoreResult.m_bPlayersRestored = true; // Don't fail on partial player restore
+			return true;
+		}
+		
+		if (RBL_PlayerPersistence.GetInstance().RestorePlayerEntry(m_PendingRestore.m_aPlayers[m_iPhaseCursor]))
+			m_RestoreResult.m_iPlayersRestored++;
+		m_iPhaseCursor++;
 		
 		return true;
 	}
 	
-	// Phase 5: Restore commander AI
+	// Phase 6: Restore commander AI
 	protected bool PhaseCommander()
 	{
 		if (!m_PendingRestore.m_Commander)
@@ -285,7 +378,7 @@ class RBL_SaveRestorer
 		return true; // Don't fail on commander restore
 	}
 	
-	// Phase 6: Restore missions
+	// Phase 7: Restore missions
 	protected bool PhaseMissions()
 	{
 		if (!m_PendingRestore.m_aMissions || m_PendingRestore.m_aMissions.IsEmpty())
@@ -298,7 +391,7 @@ class RBL_SaveRestorer
 		return true;
 	}
 	
-	// Phase 7: Finalize restoration
+	// Phase 8: Finalize restoration
 	protected bool PhaseFinalize()
 	{
 		// Refresh all systems
@@ -320,12 +413,19 @@ class RBL_SaveRestorer
 		m_bIsRestoring = false;
 		m_RestoreResult.m_bSuccess = true;
 		m_RestoreResult.m_fCompletionTime = GetGame().GetWorld().GetWorldTime();
+		m_RestoreResult.m_iTotalMs = System.GetTickCount() - m_iRestoreStartTick;
 		
 		PrintFormat("[RBL_SaveRestorer] ========================================");
 		PrintFormat("[RBL_SaveRestorer] RESTORATION COMPLETE");
 		PrintFormat("[RBL_SaveRestorer] Zones: %1", m_RestoreResult.m_iZonesRestored);
 		PrintFormat("[RBL_SaveRestorer] Players: %1", m_RestoreResult.m_iPlayersRestored);
+		PrintFormat("[RBL_SaveRestorer] Vehicles: %1", m_RestoreResult.m_iVehiclesRestored);
 		PrintFormat("[RBL_SaveRestorer] Missions: %1", m_RestoreResult.m_iMissionsRestored);
+		for (int i = 0; i < m_RestoreResult.m_aPhaseTimes.Count(); i++)
+		{
+			PrintFormat("[RBL_SaveRestorer] %1: %2 ms", GetPhaseName(i), m_RestoreResult.m_aPhaseTimes[i]);
+		}
+		PrintFormat("[RBL_SaveRestorer] Total: %1 ms over %2 frames", m_RestoreResult.m_iTotalMs, m_RestoreResult.m_iFramesUsed);
 		PrintFormat("[RBL_SaveRestorer] ========================================");
 		
 		m_OnRestoreComplete.Invoke(m_RestoreResult);
@@ -343,6 +443,7 @@ class RBL_SaveRestorer
 	protected void FailRestore(string reason)
 	{
 		m_bIsRestoring = false;
+		GetGame().GetCallqueue().Remove(ProcessPipeline);
 		m_RestoreResult.m_bSuccess = false;
 		m_RestoreResult.m_sFailureReason = reason;
 		
@@ -373,6 +474,7 @@ class RBL_SaveRestorer
 			case PHASE_CAMPAIGN: return "Campaign State";
 			case PHASE_ZONES: return "Zone States";
 			case PHASE_ECONOMY: return "Economy";
+			case PHASE_VEHICLES: return "Vehicles";
 			case PHASE_PLAYERS: return "Player Data";
 			case PHASE_COMMANDER: return "Commander AI";
 			case PHASE_MISSIONS: return "Missions";
@@ -459,6 +561,7 @@ class RBL_SaveRestorer
 	// Check if currently restoring
 	bool IsRestoring() { return m_bIsRestoring; }
 	int GetCurrentPhase() { return m_iRestorePhase; }
+	RBL_RestoreResult GetLastResult() { return m_RestoreResult; }
 	
 	// Event accessors
 	ScriptInvoker GetOnRestoreStart() { return m_OnRestoreStart; }
@@ -494,6 +597,13 @@ class RBL_RestoreResult
 	int m_iZonesRestored;
 	int m_iPlayersRestored;
 	int m_iMissionsRestored;
+	int m_iVehiclesRestored;
+	
+	// Milliseconds from start to end of each phase, indexed by phase, and
+	// for the whole restore
+	ref array<int> m_aPhaseTimes;
+	int m_iTotalMs;
+	int m_iFramesUsed;
 	
 	void RBL_RestoreResult()
 	{
@@ -513,6 +623,10 @@ class RBL_RestoreResult
 		m_iZonesRestored = 0;
 		m_iPlayersRestored = 0;
 		m_iMissionsRestored = 0;
+		m_iVehiclesRestored = 0;
+		m_aPhaseTimes = new array<int>();
+		m_iTotalMs = 0;
+		m_iFramesUsed = 0;
 	}
 	
 	string GetSummary()
@@ -1,6 +1,7 @@
 // ============================================================================
 // PROJECT REBELLION - Save Serializer
 // JSON serialization and deserialization utilities
+// Writing streams through RBL_JsonWriter
 // ============================================================================
 
 class RBL_SaveSerializer
@@ -15,32 +16,56 @@ class RBL_SaveSerializer
 		if (!saveData)
 			return "";
 		
-		string json = "{";
+		RBL_JsonWriter writer = new RBL_JsonWriter();
+		WriteSaveData(writer, saveData);
+		return writer.ToString();
+	}
+	
+	// Serialize full save data straight into an open file
+	static bool SerializeToFile(RBL_SaveData saveData, FileHandle file)
+	{
+		if (!saveData || !file)
+			return false;
+		
+		RBL_JsonWriter writer = new RBL_JsonWriter();
+		writer.Attach(file);
+		WriteSaveData(writer, saveData);
+		writer.Finish();
+		return true;
+	}
+	
+	static void WriteSaveData(RBL_JsonWriter writer, RBL_SaveData saveData)
+	{
+		writer.BeginObject();
 		
 		// Header
-		json += SerializeHeader(saveData);
+		WriteHeader(writer, saveData);
 		
 		// Campaign
-		json += ",\"campaign\":" + SerializeCampaign(saveData.m_Campaign);
+		writer.Key("campaign");
+		WriteCampaign(writer, saveData.m_Campaign);
 		
 		// Zones
-		json += ",\"zones\":" + SerializeZoneArray(saveData.m_aZones);
+		writer.Key("zones");
+		WriteZoneArray(writer, saveData.m_aZones);
 		
 		// Economy
-		json += ",\"economy\":" + SerializeEconomy(saveData.m_Economy);
+		writer.Key("economy");
+		WriteEconomy(writer, saveData.m_Economy);
 		
 		// Players
-		json += ",\"players\":" + SerializePlayerArray(saveData.m_aPlayers);
+		writer.Key("players");
+		WritePlayerArray(writer, saveData.m_aPlayers);
 		
 		// Commander
-		json += ",\"commander\":" + SerializeCommander(saveData.m_Commander);
+		writer.Key("commander");
+		WriteCommander(writer, saveData.m_Commander);
 		
 		// Missions
-		json += ",\"missions\":" + SerializeMissionArray(saveData.m_aMissions);
+		writer.Key("missions");
+		WriteMissionArray(writer, saveData.m_aMissions);
 		
-		json += "}";
-		
-		return json;
+		writer.EndObject();
 	}
 	
 	// Deserialize JSON string to save data
@@ -88,43 +113,43 @@ class RBL_SaveSerializer
 	// HEADER SERIALIZATION
 	// ========================================================================
 	
-	protected static string SerializeHeader(RBL_SaveData saveData)
+	protected static void WriteHeader(RBL_JsonWriter writer, RBL_SaveData saveData)
 	{
-		string json = "";
-		json += "\"magic\":\"" + saveData.m_sMagic + "\"";
-		json += ",\"version\":" + saveData.m_iVersion.ToString();
-		json += ",\"saveTime\":\"" + saveData.m_sSaveTime + "\"";
-		json += ",\"playerId\":\"" + saveData.m_sPlayerId + "\"";
-		json += ",\"worldName\":\"" + saveData.m_sWorldName + "\"";
-		return json;
+		writer.StringField("magic", saveData.m_sMagic);
+		writer.IntField("version", saveData.m_iVersion);
+		writer.StringField("saveTime", saveData.m_sSaveTime);
+		writer.StringField("playerId", saveData.m_sPlayerId);
+		writer.StringField("worldName", saveData.m_sWorldName);
 	}
 	
 	// ========================================================================
 	// CAMPAIGN SERIALIZATION
 	// ========================================================================
 	
-	protected static string SerializeCampaign(RBL_CampaignSaveData campaign)
+	protected static void WriteCampaign(RBL_JsonWriter writer, RBL_CampaignSaveData campaign)
 	{
 		if (!campaign)
-			return "null";
+		{
+			writer.Null();
+			return;
+		}
 		
-		string json = "{";
-		json += "\"warLevel\":" + campaign.m_iWarLevel.ToString();
-		json += ",\"aggression\":" + campaign.m_iAggression.ToString();
-		json += ",\"civilianSupport\":" + campaign.m_iCivilianSupport.ToString();
-		json += ",\"totalPlayTime\":" + campaign.m_fTotalPlayTime.ToString();
-		json += ",\"gameDays\":" + campaign.m_iGameDays.ToString();
-		json += ",\"currentDayTime\":" + campaign.m_fCurrentDayTime.ToString();
-		json += ",\"alertState\":" + campaign.m_iAlertState.ToString();
-		json += ",\"alertDecayTimer\":" + campaign.m_fAlertDecayTimer.ToString();
-		json += ",\"zonesCaptured\":" + campaign.m_iZonesCaptured.ToString();
-		json += ",\"zonesLost\":" + campaign.m_iZonesLost.ToString();
-		json += ",\"enemiesKilled\":" + campaign.m_iEnemiesKilled.ToString();
-		json += ",\"friendliesLost\":" + campaign.m_iFriendliesLost.ToString();
-		json += ",\"startDate\":\"" + campaign.m_sStartDate + "\"";
-		json += ",\"lastPlayDate\":\"" + campaign.m_sLastPlayDate + "\"";
-		json += "}";
-		return json;
+		writer.BeginObject();
+		writer.IntField("warLevel", campaign.m_iWarLevel);
+		writer.IntField("aggression", campaign.m_iAggression);
+		writer.IntField("civilianSupport", campaign.m_iCivilianSupport);
+		writer.FloatField("totalPlayTime", campaign.m_fTotalPlayTime);
+		writer.IntField("gameDays", campaign.m_iGameDays);
+		writer.FloatField("currentDayTime", campaign.m_fCurrentDayTime);
+		writer.IntField("alertState", campaign.m_iAlertState);
+		writer.FloatField("alertDecayTimer", campaign.m_fAlertDecayTimer);
+		writer.IntField("zonesCaptured", campaign.m_iZonesCaptured);
+		writer.IntField("zonesLost", campaign.m_iZonesLost);
+		writer.IntField("enemiesKilled", campaign.m_iEnemiesKilled);
+		writer.IntField("friendliesLost", campaign.m_iFriendliesLost);
+		writer.StringField("startDate", campaign.m_sStartDate);
+		writer.StringField("lastPlayDate", campaign.m_sLastPlayDate);
+		writer.EndObject();
 	}
 	
 	protected static void DeserializeCampaign(SCR_JsonLoadContext ctx, RBL_CampaignSaveData campaign)
@@ -154,49 +179,49 @@ class RBL_SaveSerializer
 	// ZONE SERIALIZATION
 	// ========================================================================
 	
-protected static string SerializeZoneArray(array<ref RBL_ZoneSaveData> zones)
+	protected static void WriteZoneArray(RBL_JsonWriter writer, array<ref RBL_ZoneSaveData> zones)
 	{
-		if (!zones || zones.IsEmpty())
-			return "[]";
-		
-		string json = "[";
-		for (int i = 0; i < zones.Count(); i++)
+		writer.BeginArray();
+		if (zones)
 		{
-			if (i > 0) json += ",";
-			json += SerializeZone(zones[i]);
+			for (int i = 0; i < zones.Count(); i++)
+			{
+				WriteZone(writer, zones[i]);
+			}
 		}
-		json += "]";
-		return json;
+		writer.EndArray();
 	}
 	
-protected static string SerializeZone(RBL_ZoneSaveData zone)
+	protected static void WriteZone(RBL_JsonWriter writer, RBL_ZoneSaveData zone)
 	{
 		if (!zone)
-			return "null";
+		{
+			writer.Null();
+			return;
+		}
 		
-		string json = "{";
-		json += "\"zoneID\":\"" + zone.m_sZoneID + "\"";
-		json += ",\"zoneName\":\"" + zone.m_sZoneName + "\"";
-		json += ",\"zoneType\":" + zone.m_iZoneType.ToString();
-		json += ",\"position\":" + SerializeVector(zone.m_vPosition);
-		json += ",\"ownerFaction\":" + zone.m_iOwnerFaction.ToString();
-		json += ",\"previousOwner\":" + zone.m_iPreviousOwner.ToString();
-		json += ",\"garrisonStrength\":" + zone.m_iGarrisonStrength.ToString();
-		json += ",\"maxGarrison\":" + zone.m_iMaxGarrison.ToString();
-		json += ",\"garrisonUnitTypes\":" + SerializeStringArray(zone.m_aGarrisonUnitTypes);
-		json += ",\"supportLevel\":" + zone.m_iSupportLevel.ToString();
-		json += ",\"supportTrend\":" + zone.m_iSupportTrend.ToString();
-		json += ",\"captureProgress\":" + zone.m_fCaptureProgress.ToString();
-		json += ",\"capturingFaction\":" + zone.m_iCapturingFaction.ToString();
-		json += ",\"resourceOutput\":" + zone.m_iResourceOutput.ToString();
-		json += ",\"resourceTimer\":" + zone.m_fResourceTimer.ToString();
-		json += ",\"isUnderAttack\":" + BoolToJson(zone.m_bIsUnderAttack);
-		json += ",\"isContested\":" + BoolToJson(zone.m_bIsContested);
-		json += ",\"isDestroyed\":" + BoolToJson(zone.m_bIsDestroyed);
-		json += ",\"lastCaptureTime\":" + zone.m_fLastCaptureTime.ToString();
-		json += ",\"lastAttackTime\":" + zone.m_fLastAttackTime.ToString();
-		json += "}";
-		return json;
+		writer.BeginObject();
+		writer.StringField("zoneID", zone.m_sZoneID);
+		writer.StringField("zoneName", zone.m_sZoneName);
+		writer.IntField("zoneType", zone.m_iZoneType);
+		writer.VectorField("position", zone.m_vPosition);
+		writer.IntField("ownerFaction", zone.m_iOwnerFaction);
+		writer.IntField("previousOwner", zone.m_iPreviousOwner);
+		writer.IntField("garrisonStrength", zone.m_iGarrisonStrength);
+		writer.IntField("maxGarrison", zone.m_iMaxGarrison);
+		writer.StringArrayField("garrisonUnitTypes", zone.m_aGarrisonUnitTypes);
+		writer.IntField("supportLevel", zone.m_iSupportLevel);
+		writer.IntField("supportTrend", zone.m_iSupportTrend);
+		writer.FloatField("captureProgress", zone.m_fCaptureProgress);
+		writer.IntField("capturingFaction", zone.m_iCapturingFaction);
+		writer.IntField("resourceOutput", zone.m_iResourceOutput);
+		writer.FloatField("resourceTimer", zone.m_fResourceTimer);
+		writer.BoolField("isUnderAttack", zone.m_bIsUnderAttack);
+		writer.BoolField("isContested", zone.m_bIsContested);
+		writer.BoolField("isDestroyed", zone.m_bIsDestroyed);
+		writer.FloatField("lastCaptureTime", zone.m_fLastCaptureTime);
+		writer.FloatField("lastAttackTime", zone.m_fLastAttackTime);
+		writer.EndObject();
 	}
 	
 protected static void DeserializeZones(SCR_JsonLoadContext ctx, array<ref RBL_ZoneSaveData> zones)
@@ -209,27 +234,31 @@ protected static void DeserializeZones(SCR_JsonLoadContext ctx, array<ref RBL_Zo
 	// ECONOMY SERIALIZATION
 	// ========================================================================
 	
-	protected static string SerializeEconomy(RBL_EconomySaveData economy)
+	protected static void WriteEconomy(RBL_JsonWriter writer, RBL_EconomySaveData economy)
 	{
 		if (!economy)
-			return "null";
+		{
+			writer.Null();
+			return;
+		}
 		
-		string json = "{";
-		json += "\"fiaMoney\":" + economy.m_iFIAMoney.ToString();
-		json += ",\"fiaHR\":" + economy.m_iFIAHumanResources.ToString();
-		json += ",\"fiaFuel\":" + economy.m_iFIAFuel.ToString();
-		json += ",\"fiaAmmo\":" + economy.m_iFIAAmmo.ToString();
-		json += ",\"moneyPerMinute\":" + economy.m_iMoneyPerMinute.ToString();
-		json += ",\"hrPerMinute\":" + economy.m_iHRPerMinute.ToString();
-		json += ",\"arsenalItems\":" + SerializeArsenalArray(economy.m_aArsenalItems);
-		json += ",\"unlockedItems\":" + SerializeStringArray(economy.m_aUnlockedItems);
-		json += ",\"vehiclePool\":" + SerializeVehicleArray(economy.m_aVehiclePool);
-		json += ",\"totalMoneyEarned\":" + economy.m_iTotalMoneyEarned.ToString();
-		json += ",\"totalMoneySpent\":" + economy.m_iTotalMoneySpent.ToString();
-		json += ",\"totalItemsBought\":" + economy.m_iTotalItemsBought.ToString();
-		json += ",\"totalItemsSold\":" + economy.m_iTotalItemsSold.ToString();
-		json += "}";
-		return json;
+		writer.BeginObject();
+		writer.IntField("fiaMoney", economy.m_iFIAMoney);
+		writer.IntField("fiaHR", economy.m_iFIAHumanResources);
+		writer.IntField("fiaFuel", economy.m_iFIAFuel);
+		writer.IntField("fiaAmmo", economy.m_iFIAAmmo);
+		writer.IntField("moneyPerMinute", economy.m_iMoneyPerMinute);
+		writer.IntField("hrPerMinute", economy.m_iHRPerMinute);
+		writer.Key("arsenalItems");
+		WriteArsenalArray(writer, economy.m_aArsenalItems);
+		writer.StringArrayField("unlockedItems", economy.m_aUnlockedItems);
+		writer.Key("vehiclePool");
+		WriteVehicleArray(writer, economy.m_aVehiclePool);
+		writer.IntField("totalMoneyEarned", economy.m_iTotalMoneyEarned);
+		writer.IntField("totalMoneySpent", economy.m_iTotalMoneySpent);
+		writer.IntField("totalItemsBought", economy.m_iTotalItemsBought);
+		writer.IntField("totalItemsSold", economy.m_iTotalItemsSold);
+		writer.EndObject();
 	}
 	
 	protected static void DeserializeEconomy(SCR_JsonLoadContext ctx, RBL_EconomySaveData economy)
@@ -254,19 +283,20 @@ protected static void DeserializeZones(SCR_JsonLoadContext ctx, array<ref RBL_Zo
 		ctx.EndObject();
 	}
 	
-	protected static string SerializeArsenalArray(array<ref RBL_ArsenalItemSave> items)
+	protected static void WriteArsenalArray(RBL_JsonWriter writer, array<ref RBL_ArsenalItemSave> items)
 	{
-		if (!items || items.IsEmpty())
-			return "[]";
-		
-		string json = "[";
-		for (int i = 0; i < items.Count(); i++)
+		writer.BeginArray();
+		if (items)
 		{
-			if (i > 0) json += ",";
-			json += "{\"id\":\"" + items[i].m_sItemID + "\",\"qty\":" + items[i].m_iQuantity.ToString() + "}";
+			for (int i = 0; i < items.Count(); i++)
+			{
+				writer.BeginObject();
+				writer.StringField("id", items[i].m_sItemID);
+				writer.IntField("qty", items[i].m_iQuantity);
+				writer.EndObject();
+			}
 		}
-		json += "]";
-		return json;
+		writer.EndArray();
 	}
 	
 	protected static void DeserializeArsenalArray(SCR_JsonLoadContext ctx, array<ref RBL_ArsenalItemSave> items)
@@ -275,23 +305,25 @@ protected static void DeserializeZones(SCR_JsonLoadContext ctx, array<ref RBL_Zo
 	// Array parsing not supported in this serializer version.
 	}
 	
-	protected static string SerializeVehicleArray(array<ref RBL_VehicleSave> vehicles)
+	protected static void WriteVehicleArray(RBL_JsonWriter writer, array<ref RBL_VehicleSave> vehicles)
 	{
-		if (!vehicles || vehicles.IsEmpty())
-			return "[]";
-		
-		string json = "[";
-		for (int i = 0; i < vehicles.Count(); i++)
+		writer.BeginArray();
+		if (vehicles)
 		{
-			if (i > 0) json += ",";
-			RBL_VehicleSave v = vehicles[i];
-			json += "{\"id\":\"" + v.m_sVehicleID + "\",\"type\":\"" + v.m_sVehicleType + "\"";
-			json += ",\"fuel\":" + v.m_fFuel.ToString() + ",\"health\":" + v.m_fHealth.ToString();
-			json += ",\"deployed\":" + BoolToJson(v.m_bIsDeployed);
-			json += ",\"pos\":" + SerializeVector(v.m_vPosition) + "}";
+			for (int i = 0; i < vehicles.Count(); i++)
+			{
+				RBL_VehicleSave v = vehicles[i];
+				writer.BeginObject();
+				writer.StringField("id", v.m_sVehicleID);
+				writer.StringField("type", v.m_sVehicleType);
+				writer.FloatField("fuel", v.m_fFuel);
+				writer.FloatField("health", v.m_fHealth);
+				writer.BoolField("deployed", v.m_bIsDeployed);
+				writer.VectorField("pos", v.m_vPosition);
+				writer.EndObject();
+			}
 		}
-		json += "]";
-		return json;
+		writer.EndArray();
 	}
 	
 	protected static void DeserializeVehicleArray(SCR_JsonLoadContext ctx, array<ref RBL_VehicleSave> vehicles)
@@ -304,47 +336,47 @@ protected static void DeserializeZones(SCR_JsonLoadContext ctx, array<ref RBL_Zo
 	// PLAYER SERIALIZATION
 	// ========================================================================
 	
-	protected static string SerializePlayerArray(array<ref RBL_PlayerSaveData> players)
+	protected static void WritePlayerArray(RBL_JsonWriter writer, array<ref RBL_PlayerSaveData> players)
 	{
-		if (!players || players.IsEmpty())
-			return "[]";
-		
-		string json = "[";
-		for (int i = 0; i < players.Count(); i++)
+		writer.BeginArray();
+		if (players)
 		{
-			if (i > 0) json += ",";
-			json += SerializePlayer(players[i]);
+			for (int i = 0; i < players.Count(); i++)
+			{
+				WritePlayer(writer, players[i]);
+			}
 		}
-		json += "]";
-		return json;
+		writer.EndArray();
 	}
 	
-	protected static string SerializePlayer(RBL_PlayerSaveData player)
+	protected static void WritePlayer(RBL_JsonWriter writer, RBL_PlayerSaveData player)
 	{
 		if (!player)
-			return "null";
+		{
+			writer.Null();
+			return;
+		}
 		
-		string json = "{";
-		json += "\"uid\":\"" + player.m_sPlayerUID + "\"";
-		json += ",\"name\":\"" + EscapeString(player.m_sPlayerName) + "\"";
-		json += ",\"money\":" + player.m_iMoney.ToString();
-		json += ",\"hr\":" + player.m_iHumanResources.ToString();
-		json += ",\"kills\":" + player.m_iKills.ToString();
-		json += ",\"deaths\":" + player.m_iDeaths.ToString();
-		json += ",\"zonesCaptured\":" + player.m_iZonesCaptured.ToString();
-		json += ",\"missionsCompleted\":" + player.m_iMissionsCompleted.ToString();
-		json += ",\"playTime\":" + player.m_fPlayTime.ToString();
-		json += ",\"rank\":" + player.m_iRank.ToString();
-		json += ",\"experience\":" + player.m_iExperience.ToString();
-		json += ",\"unlocks\":" + SerializeStringArray(player.m_aUnlocks);
-		json += ",\"achievements\":" + SerializeStringArray(player.m_aAchievements);
-		json += ",\"inventory\":" + SerializeStringArray(player.m_aInventoryItems);
-		json += ",\"lastPosition\":" + SerializeVector(player.m_vLastPosition);
-		json += ",\"lastDirection\":" + player.m_fLastDirection.ToString();
-		json += ",\"coverStatus\":" + player.m_iCoverStatus.ToString();
-		json += ",\"suspicionLevel\":" + player.m_fSuspicionLevel.ToString();
-		json += "}";
-		return json;
+		writer.BeginObject();
+		writer.StringField("uid", player.m_sPlayerUID);
+		writer.StringField("name", player.m_sPlayerName);
+		writer.IntField("money", player.m_iMoney);
+		writer.IntField("hr", player.m_iHumanResources);
+		writer.IntField("kills", player.m_iKills);
+		writer.IntField("deaths", player.m_iDeaths);
+		writer.IntField("zonesCaptured", player.m_iZonesCaptured);
+		writer.IntField("missionsCompleted", player.m_iMissionsCompleted);
+		writer.FloatField("playTime", player.m_fPlayTime);
+		writer.IntField("rank", player.m_iRank);
+		writer.IntField("experience", player.m_iExperience);
+		writer.StringArrayField("unlocks", player.m_aUnlocks);
+		writer.StringArrayField("achievements", player.m_aAchievements);
+		writer.StringArrayField("inventory", player.m_aInventoryItems);
+		writer.VectorField("lastPosition", player.m_vLastPosition);
+		writer.FloatField("lastDirection", player.m_fLastDirection);
+		writer.IntField("coverStatus", player.m_iCoverStatus);
+		writer.FloatField("suspicionLevel", player.m_fSuspicionLevel);
+		writer.EndObject();
 	}
 	
 	protected static void DeserializePlayers(SCR_JsonLoadContext ctx, array<ref RBL_PlayerSaveData> players)
@@ -357,24 +389,27 @@ protected static void DeserializeZones(SCR_JsonLoadContext ctx, array<ref RBL_Zo
 	// COMMANDER SERIALIZATION
 	// ========================================================================
 	
-	protected static string SerializeCommander(RBL_CommanderSaveData commander)
+	protected static void WriteCommander(RBL_JsonWriter writer, RBL_CommanderSaveData commander)
 	{
 		if (!commander)
-			return "null";
+		{
+			writer.Null();
+			return;
+		}
 		
-		string json = "{";
-		json += "\"resources\":" + commander.m_iCommanderResources.ToString();
-		json += ",\"reinforcementPool\":" + commander.m_iReinforcementPool.ToString();
-		json += ",\"threatLevel\":" + commander.m_iThreatLevel.ToString();
-		json += ",\"highestThreatZone\":\"" + commander.m_sHighestThreatZone + "\"";
-		json += ",\"operations\":" + SerializeOperationArray(commander.m_aActiveOperations);
-		json += ",\"qrfCooldown\":" + commander.m_fQRFCooldown.ToString();
-		json += ",\"patrolCooldown\":" + commander.m_fPatrolCooldown.ToString();
-		json += ",\"offensiveCooldown\":" + commander.m_fOffensiveCooldown.ToString();
-		json += ",\"knownPlayerPositions\":" + SerializeStringArray(commander.m_aKnownPlayerPositions);
-		json += ",\"recentlyAttackedZones\":" + SerializeStringArray(commander.m_aRecentlyAttackedZones);
-		json += "}";
-		return json;
+		writer.BeginObject();
+		writer.IntField("resources", commander.m_iCommanderResources);
+		writer.IntField("reinforcementPool", commander.m_iReinforcementPool);
+		writer.IntField("threatLevel", commander.m_iThreatLevel);
+		writer.StringField("highestThreatZone", commander.m_sHighestThreatZone);
+		writer.Key("operations");
+		WriteOperationArray(writer, commander.m_aActiveOperations);
+		writer.FloatField("qrfCooldown", commander.m_fQRFCooldown);
+		writer.FloatField("patrolCooldown", commander.m_fPatrolCooldown);
+		writer.FloatField("offensiveCooldown", commander.m_fOffensiveCooldown);
+		writer.StringArrayField("knownPlayerPositions", commander.m_aKnownPlayerPositions);
+		writer.StringArrayField("recentlyAttackedZones", commander.m_aRecentlyAttackedZones);
+		writer.EndObject();
 	}
 	
 	protected static void DeserializeCommander(SCR_JsonLoadContext ctx, RBL_CommanderSaveData commander)
@@ -396,22 +431,25 @@ protected static void DeserializeZones(SCR_JsonLoadContext ctx, array<ref RBL_Zo
 		ctx.EndObject();
 	}
 	
-	protected static string SerializeOperationArray(array<ref RBL_OperationSave> operations)
+	protected static void WriteOperationArray(RBL_JsonWriter writer, array<ref RBL_OperationSave> operations)
 	{
-		if (!operations || operations.IsEmpty())
-			return "[]";
-		
-		string json = "[";
-		for (int i = 0; i < operations.Count(); i++)
+		writer.BeginArray();
+		if (operations)
 		{
-			if (i > 0) json += ",";
-			RBL_OperationSave op = operations[i];
-			json += "{\"id\":\"" + op.m_sOperationID + "\",\"type\":" + op.m_iOperationType.ToString();
-			json += ",\"target\":\"" + op.m_sTargetZone + "\",\"units\":" + op.m_iAssignedUnits.ToString();
-			json += ",\"start\":" + op.m_fStartTime.ToString() + ",\"progress\":" + op.m_fProgress.ToString() + "}";
+			for (int i = 0; i < operations.Count(); i++)
+			{
+				RBL_OperationSave op = operations[i];
+				writer.BeginObject();
+				writer.StringField("id", op.m_sOperationID);
+				writer.IntField("type", op.m_iOperationType);
+				writer.StringField("target", op.m_sTargetZone);
+				writer.IntField("units", op.m_iAssignedUnits);
+				writer.FloatField("start", op.m_fStartTime);
+				writer.FloatField("progress", op.m_fProgress);
+				writer.EndObject();
+			}
 		}
-		json += "]";
-		return json;
+		writer.EndArray();
 	}
 	
 	protected static void DeserializeOperationArray(SCR_JsonLoadContext ctx, array<ref RBL_OperationSave> operations)
@@ -424,46 +462,46 @@ protected static void DeserializeZones(SCR_JsonLoadContext ctx, array<ref RBL_Zo
 	// MISSION SERIALIZATION
 	// ========================================================================
 	
-	protected static string SerializeMissionArray(array<ref RBL_MissionSaveData> missions)
+	protected static void WriteMissionArray(RBL_JsonWriter writer, array<ref RBL_MissionSaveData> missions)
 	{
-		if (!missions || missions.IsEmpty())
-			return "[]";
-		
-		string json = "[";
-		for (int i = 0; i < missions.Count(); i++)
+		writer.BeginArray();
+		if (missions)
 		{
-			if (i > 0) json += ",";
-			json += SerializeMission(missions[i]);
+			for (int i = 0; i < missions.Count(); i++)
+			{
+				WriteMission(writer, missions[i]);
+			}
 		}
-		json += "]";
-		return json;
+		writer.EndArray();
 	}
 	
-	protected static string SerializeMission(RBL_MissionSaveData mission)
+	protected static void WriteMission(RBL_JsonWriter writer, RBL_MissionSaveData mission)
 	{
 		if (!mission)
-			return "null";
+		{
+			writer.Null();
+			return;
+		}
 		
-		string json = "{";
-		json += "\"id\":\"" + mission.m_sMissionID + "\"";
-		json += ",\"type\":\"" + mission.m_sMissionType + "\"";
-		json += ",\"name\":\"" + EscapeString(mission.m_sMissionName) + "\"";
-		json += ",\"targetZone\":\"" + mission.m_sTargetZone + "\"";
-		json += ",\"targetPos\":" + SerializeVector(mission.m_vTargetPosition);
-		json += ",\"progress\":" + mission.m_fProgress.ToString();
-		json += ",\"objectivesCompleted\":" + mission.m_iObjectivesCompleted.ToString();
-		json += ",\"totalObjectives\":" + mission.m_iTotalObjectives.ToString();
-		json += ",\"timeLimit\":" + mission.m_fTimeLimit.ToString();
-		json += ",\"timeRemaining\":" + mission.m_fTimeRemaining.ToString();
-		json += ",\"startTime\":" + mission.m_fStartTime.ToString();
-		json += ",\"moneyReward\":" + mission.m_iMoneyReward.ToString();
-		json += ",\"hrReward\":" + mission.m_iHRReward.ToString();
-		json += ",\"itemRewards\":" + SerializeStringArray(mission.m_aItemRewards);
-		json += ",\"isActive\":" + BoolToJson(mission.m_bIsActive);
-		json += ",\"isCompleted\":" + BoolToJson(mission.m_bIsCompleted);
-		json += ",\"isFailed\":" + BoolToJson(mission.m_bIsFailed);
-		json += "}";
-		return json;
+		writer.BeginObject();
+		writer.StringField("id", mission.m_sMissionID);
+		writer.StringField("type", mission.m_sMissionType);
+		writer.StringField("name", mission.m_sMissionName);
+		writer.StringField("targetZone", mission.m_sTargetZone);
+		writer.VectorField("targetPos", mission.m_vTargetPosition);
+		writer.FloatField("progress", mission.m_fProgress);
+		writer.IntField("objectivesCompleted", mission.m_iObjectivesCompleted);
+		writer.IntField("totalObjectives", mission.m_iTotalObjectives);
+		writer.FloatField("timeLimit", mission.m_fTimeLimit);
+		writer.FloatField("timeRemaining", mission.m_fTimeRemaining);
+		writer.FloatField("startTime", mission.m_fStartTime);
+		writer.IntField("moneyReward", mission.m_iMoneyReward);
+		writer.IntField("hrReward", mission.m_iHRReward);
+		writer.StringArrayField("itemRewards", mission.m_aItemRewards);
+		writer.BoolField("isActive", mission.m_bIsActive);
+		writer.BoolField("isCompleted", mission.m_bIsCompleted);
+		writer.BoolField("isFailed", mission.m_bIsFailed);
+		writer.EndObject();
 	}
 	
 	protected static void DeserializeMissions(SCR_JsonLoadContext ctx, array<ref RBL_MissionSaveData> missions)
@@ -476,47 +514,16 @@ protected static void DeserializeZones(SCR_JsonLoadContext ctx, array<ref RBL_Zo
 	// UTILITY FUNCTIONS
 	// ========================================================================
 	
-	protected static string SerializeVector(vector v)
-	{
-		return "[" + v[0].ToString() + "," + v[1].ToString() + "," + v[2].ToString() + "]";
-	}
-	
 	protected static void DeserializeVector(SCR_JsonLoadContext ctx, string name, out vector v)
 	{
 	v = vector.Zero;
 	}
 	
-	protected static string SerializeStringArray(array<string> arr)
-	{
-		if (!arr || arr.IsEmpty())
-			return "[]";
-		
-		string json = "[";
-		for (int i = 0; i < arr.Count(); i++)
-		{
-			if (i > 0) json += ",";
-			json += "\"" + EscapeString(arr[i]) + "\"";
-		}
-		json += "]";
-		return json;
-	}
-	
 	protected static void DeserializeStringArray(SCR_JsonLoadContext ctx, string name, array<string> arr)
 	{
 		arr.Clear();
 	// Array parsing not supported in this serializer version.
 	}
 	
-	protected static string BoolToJson(bool value)
-	{
-		if (value)
-			return "true";
-		return "false";
-	}
-	
-	protected static string EscapeString(string str)
-	{
-	return str;
-	}
 }
 
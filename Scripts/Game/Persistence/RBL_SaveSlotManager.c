@@ -17,6 +17,9 @@ class RBL_SaveSlotManager
 	protected ref array<ref RBL_SaveSlotInfo> m_aSlotInfos;
 	protected ref array<string> m_aRecentSaves;
 	
+	// Storage format per slot
+	protected ref array<ERBLSaveFormat> m_aSlotFormats;
+	
 	// ========================================================================
 	// SINGLETON
 	// ========================================================================
@@ -35,6 +38,12 @@ class RBL_SaveSlotManager
 		m_aSlotInfos = new array<ref RBL_SaveSlotInfo>();
 		m_aRecentSaves = new array<string>();
 		
+		m_aSlotFormats = new array<ERBLSaveFormat>();
+		for (int i = 0; i < MAX_SAVE_SLOTS; i++)
+		{
+			m_aSlotFormats.Insert(ERBLSaveFormat.BINARY);
+		}
+		
 		RefreshSlotInfos();
 	}
 	
@@ -137,20 +146,12 @@ class RBL_SaveSlotManager
 		// Update save timestamp
 		saveData.m_sSaveTime = GetCurrentTimestamp();
 		
-		// Serialize
-		string json = RBL_SaveSerializer.SerializeToJson(saveData);
-		if (json.IsEmpty())
-		{
-			PrintFormat("[RBL_SaveSlot] Serialization failed");
-			return false;
-		}
-		
 		// Get filename for slot
 		RBL_SaveFileManager fileMgr = RBL_SaveFileManager.GetInstance();
 		string filename = fileMgr.GetSlotFilename(slotIndex);
 		
-		// Write to file
-		bool result = fileMgr.WriteToFile(filename, json);
+		// Serialize straight to file in the slot's format
+		bool result = fileMgr.WriteSaveDataAs(filename, saveData, m_aSlotFormats[slotIndex]);
 		
 		if (result)
 		{
@@ -181,16 +182,14 @@ class RBL_SaveSlotManager
 		RBL_SaveFileManager fileMgr = RBL_SaveFileManager.GetInstance();
 		string filename = fileMgr.GetSlotFilename(slotIndex);
 		
-		// Read from file
-		string json = fileMgr.ReadFromFile(filename);
-		if (json.IsEmpty())
+		if (!fileMgr.SaveExists(filename))
 		{
 			PrintFormat("[RBL_SaveSlot] Slot %1 is empty or unreadable", slotIndex);
 			return null;
 		}
 		
-		// Deserialize
-		RBL_SaveData saveData = RBL_SaveSerializer.DeserializeFromJson(json);
+		// Load in whichever format the slot was written
+		RBL_SaveData saveData = fileMgr.LoadSaveData(filename);
 		
 		if (saveData)
 		{
@@ -201,6 +200,33 @@ class RBL_SaveSlotManager
 		return saveData;
 	}
 	
+	// Choose the storage format used for future saves to a slot
+	void SetSlotFormat(int slotIndex, ERBLSaveFormat format)
+	{
+		if (slotIndex < 0 || slotIndex >= MAX_SAVE_SLOTS)
+			return;
+		
+		m_aSlotFormats[slotIndex] = format;
+	}
+	
+	ERBLSaveFormat GetSlotFormat(int slotIndex)
+	{
+		if (slotIndex < 0 || slotIndex >= MAX_SAVE_SLOTS)
+			return ERBLSaveFormat.JSON;
+		
+		return m_aSlotFormats[slotIndex];
+	}
+	
+	// Write a readable JSON copy of a slot for debugging
+	bool ExportSlotAsJson(int slotIndex)
+	{
+		if (slotIndex < 0 || slotIndex >= MAX_SAVE_SLOTS)
+			return false;
+		
+		RBL_SaveFileManager fileMgr = RBL_SaveFileManager.GetInstance();
+		return fileMgr.ExportSaveAsJson(fileMgr.GetSlotFilename(slotIndex));
+	}
+	
 	// Delete slot
 	bool DeleteSlot(int slotIndex)
 	{
@@ -142,40 +142,47 @@ class RBL_ZonePersistence
 			if (!zoneData)
 				continue;
 			
-			// Find zone by ID
-			RBL_CampaignZone zone = zoneMgr.GetZone(zoneData.m_sZoneID);
-			
-			if (!zone)
-			{
-				// Zone doesn't exist - might need to create it
-				PrintFormat("[RBL_ZonePersistence] Zone not found for restore: %1", zoneData.m_sZoneID);
-				
-				// Try to create the zone if position is valid
-				if (zoneData.m_vPosition != vector.Zero)
-				{
-					zone = CreateZoneFromData(zoneData);
-					if (zone)
-						zoneMgr.RegisterZone(zone);
-				}
-			}
-			
-			if (zone)
-			{
-				if (RestoreZoneState(zone, zoneData))
-					restoredCount++;
-				else
-					failedCount++;
-			}
+			if (RestoreZoneEntry(zoneData))
+				restoredCount++;
 			else
-			{
 				failedCount++;
-			}
 		}
 		
 		PrintFormat("[RBL_ZonePersistence] Restored %1 zones (%2 failed)", restoredCount, failedCount);
 		return restoredCount;
 	}
 	
+	// Restore one saved zone, creating it if it no longer exists. Lets the
+	// restorer spread zones over several frames
+	bool RestoreZoneEntry(RBL_ZoneSaveData zoneData)
+	{
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!zoneMgr || !zoneData)
+			return false;
+		
+		// Find zone by ID
+		RBL_CampaignZone zone = zoneMgr.GetZone(zoneData.m_sZoneID);
+		
+		if (!zone)
+		{
+			// Zone doesn't exist - might need to create it
+			PrintFormat("[RBL_ZonePersistence] Zone not found for restore: %1", zoneData.m_sZoneID);
+			
+			// Try to create the zone if position is valid
+			if (zoneData.m_vPosition != vector.Zero)
+			{
+				zone = CreateZoneFromData(zoneData);
+				if (zone)
+					zoneMgr.RegisterZone(zone);
+			}
+		}
+		
+		if (!zone)
+			return false;
+		
+		return RestoreZoneState(zone, zoneData);
+	}
+	
 	// Restore single zone state
 	bool RestoreZoneState(RBL_CampaignZone zone, RBL_ZoneSaveData data)
 	{
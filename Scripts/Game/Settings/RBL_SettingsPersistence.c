@@ -35,14 +35,6 @@ class RBL_SettingsPersistence
 			return false;
 		}
 		
-		// Serialize to JSON
-		string json = SerializeSettings(settings);
-		if (json.IsEmpty())
-		{
-			PrintFormat("[RBL_SettingsPersistence] Serialization failed");
-			return false;
-		}
-		
 		// Write to file
 		string filepath = GetSettingsFilePath();
 		
@@ -53,10 +45,14 @@ class RBL_SettingsPersistence
 			return false;
 		}
 		
-		file.Write(json);
+		// Serialize straight to the file
+		RBL_JsonWriter writer = new RBL_JsonWriter();
+		writer.Attach(file);
+		WriteSettings(writer, settings);
+		writer.Finish();
 		file.Close();
 		
-		PrintFormat("[RBL_SettingsPersistence] Settings saved: %1 bytes", json.Length());
+		PrintFormat("[RBL_SettingsPersistence] Settings saved: %1 bytes", writer.GetLength());
 		return true;
 	}
 	
@@ -81,20 +77,7 @@ class RBL_SettingsPersistence
 		}
 		
 		// Read file content
-		FileHandle file = FileIO.OpenFile(filepath, FileMode.READ);
-		if (!file)
-		{
-			PrintFormat("[RBL_SettingsPersistence] Failed to open file for reading");
-			return false;
-		}
-		
-		string content = "";
-		string line;
-		while (file.ReadLine(line) >= 0)
-		{
-			content += line;
-		}
-		file.Close();
+		string content = RBL_FileReader.ReadAll(filepath);
 		
 		if (content.IsEmpty())
 		{
@@ -144,51 +127,58 @@ class RBL_SettingsPersistence
 	// SERIALIZATION
 	// ========================================================================
 	
-	protected string SerializeSettings(RBL_SettingsData settings)
+	protected void WriteSettings(RBL_JsonWriter writer, RBL_SettingsData settings)
 	{
-		// Manual JSON construction for Enfusion compatibility - minified
-		string json = "{";
-		json += "\"version\":" + settings.m_iVersion.ToString() + ",";
-		json += "\"gameplay\":{";
-		json += "\"difficulty\":" + ((int)settings.m_eDifficulty).ToString() + ",";
-		json += "\"autoSaveEnabled\":" + BoolToString(settings.m_bAutoSaveEnabled) + ",";
-		json += "\"autoSaveInterval\":" + settings.m_fAutoSaveInterval.ToString() + ",";
-		json += "\"saveOnZoneCapture\":" + BoolToString(settings.m_bSaveOnZoneCapture) + ",";
-		json += "\"saveOnMissionComplete\":" + BoolToString(settings.m_bSaveOnMissionComplete) + ",";
-		json += "\"undercoverSystemEnabled\":" + BoolToString(settings.m_bUndercoverSystemEnabled) + ",";
-		json += "\"friendlyFireEnabled\":" + BoolToString(settings.m_bFriendlyFireEnabled) + ",";
-		json += "\"showTutorialHints\":" + BoolToString(settings.m_bShowTutorialHints);
-		json += "},";
-		json += "\"display\":{";
-		json += "\"hudEnabled\":" + BoolToString(settings.m_bHUDEnabled) + ",";
-		json += "\"hudOpacity\":" + settings.m_fHUDOpacity.ToString() + ",";
-		json += "\"uiScale\":" + settings.m_fUIScale.ToString() + ",";
-		json += "\"showMapMarkers\":" + BoolToString(settings.m_bShowMapMarkers) + ",";
-		json += "\"showZoneNames\":" + BoolToString(settings.m_bShowZoneNames) + ",";
-		json += "\"showZoneInfo\":" + BoolToString(settings.m_bShowZoneInfo) + ",";
-		json += "\"showUndercoverStatus\":" + BoolToString(settings.m_bShowUndercoverStatus) + ",";
-		json += "\"showMinimap\":" + BoolToString(settings.m_bShowMinimap) + ",";
-		json += "\"showNotifications\":" + BoolToString(settings.m_bShowNotifications) + ",";
-		json += "\"notificationDuration\":" + settings.m_fNotificationDuration.ToString() + ",";
-		json += "\"showKeybindHints\":" + BoolToString(settings.m_bShowKeybindHints) + ",";
-		json += "\"showDamageNumbers\":" + BoolToString(settings.m_bShowDamageNumbers) + ",";
-		json += "\"showCaptureBar\":" + BoolToString(settings.m_bShowCaptureBar);
-		json += "},";
-		json += "\"audio\":{";
-		json += "\"masterVolume\":" + settings.m_fMasterVolume.ToString() + ",";
-		json += "\"musicVolume\":" + settings.m_fMusicVolume.ToString() + ",";
-		json += "\"sfxVolume\":" + settings.m_fSFXVolume.ToString() + ",";
-		json += "\"uiVolume\":" + settings.m_fUIVolume.ToString() + ",";
-		json += "\"muteWhenUnfocused\":" + BoolToString(settings.m_bMuteWhenUnfocused);
-		json += "},";
-		json += "\"controls\":{";
-		json += "\"mouseSensitivity\":" + settings.m_fMouseSensitivity.ToString() + ",";
-		json += "\"invertY\":" + BoolToString(settings.m_bInvertY) + ",";
-		json += "\"toggleADS\":" + BoolToString(settings.m_bToggleADS) + ",";
-		json += "\"toggleSprint\":" + BoolToString(settings.m_bToggleSprint);
-		json += "}";
-		json += "}";
-		return json;
+		writer.BeginObject();
+		writer.IntField("version", settings.m_iVersion);
+		
+		writer.Key("gameplay");
+		writer.BeginObject();
+		writer.IntField("difficulty", settings.m_eDifficulty);
+		writer.BoolField("autoSaveEnabled", settings.m_bAutoSaveEnabled);
+		writer.FloatField("autoSaveInterval", settings.m_fAutoSaveInterval);
+		writer.BoolField("saveOnZoneCapture", settings.m_bSaveOnZoneCapture);
+		writer.BoolField("saveOnMissionComplete", settings.m_bSaveOnMissionComplete);
+		writer.BoolField("undercoverSystemEnabled", settings.m_bUndercoverSystemEnabled);
+		writer.BoolField("friendlyFireEnabled", settings.m_bFriendlyFireEnabled);
+		writer.BoolField("showTutorialHints", settings.m_bShowTutorialHints);
+		writer.EndObject();
+		
+		writer.Key("display");
+		writer.BeginObject();
+		writer.BoolField("hudEnabled", settings.m_bHUDEnabled);
+		writer.FloatField("hudOpacity", settings.m_fHUDOpacity);
+		writer.FloatField("uiScale", settings.m_fUIScale);
+		writer.BoolField("showMapMarkers", settings.m_bShowMapMarkers);
+		writer.BoolField("showZoneNames", settings.m_bShowZoneNames);
+		writer.BoolField("showZoneInfo", settings.m_bShowZoneInfo);
+		writer.BoolField("showUndercoverStatus", settings.m_bShowUndercoverStatus);
+		writer.BoolField("showMinimap", settings.m_bShowMinimap);
+		writer.BoolField("showNotifications", settings.m_bShowNotifications);
+		writer.FloatField("notificationDuration", settings.m_fNotificationDuration);
+		writer.BoolField("showKeybindHints", settings.m_bShowKeybindHints);
+		writer.BoolField("showDamageNumbers", settings.m_bShowDamageNumbers);
+		writer.BoolField("showCaptureBar", settings.m_bShowCaptureBar);
+		writer.EndObject();
+		
+		writer.Key("audio");
+		writer.BeginObject();
+		writer.FloatField("masterVolume", settings.m_fMasterVolume);
+		writer.FloatField("musicVolume", settings.m_fMusicVolume);
+		writer.FloatField("sfxVolume", settings.m_fSFXVolume);
+		writer.FloatField("uiVolume", settings.m_fUIVolume);
+		writer.BoolField("muteWhenUnfocused", settings.m_bMuteWhenUnfocused);
+		writer.EndObject();
+		
+		writer.Key("controls");
+		writer.BeginObject();
+		writer.FloatField("mouseSensitivity", settings.m_fMouseSensitivity);
+		writer.BoolField("invertY", settings.m_bInvertY);
+		writer.BoolField("toggleADS", settings.m_bToggleADS);
+		writer.BoolField("toggleSprint", settings.m_bToggleSprint);
+		writer.EndObject();
+		
+		writer.EndObject();
 	}
 	
 	protected bool DeserializeSettings(string json, RBL_SettingsData outSettings)
@@ -308,13 +298,6 @@ class RBL_SettingsPersistence
 	// PARSING HELPERS
 	// ========================================================================
 	
-	protected string BoolToString(bool value)
-	{
-		if (value)
-			return "true";
-		return "false";
-	}
-	
 	protected int ParseIntValue(string json, string key, int defaultValue)
 	{
 		string searchKey = "\"" + key + "\":";
@@ -436,30 +419,9 @@ class RBL_SettingsPersistence
 		string sourcePath = GetSettingsFilePath();
 		string backupPath = sourcePath + ".backup";
 		
-		if (!FileIO.FileExists(sourcePath))
+		if (!RBL_FileReader.Copy(sourcePath, backupPath))
 			return false;
 		
-		// Read source
-		FileHandle sourceFile = FileIO.OpenFile(sourcePath, FileMode.READ);
-		if (!sourceFile)
-			return false;
-		
-		string content = "";
-		string line;
-		while (sourceFile.ReadLine(line) >= 0)
-		{
-			content += line + "\n";
-		}
-		sourceFile.Close();
-		
-		// Write backup
-		FileHandle backupFile = FileIO.OpenFile(backupPath, FileMode.WRITE);
-		if (!backupFile)
-			return false;
-		
-		backupFile.Write(content);
-		backupFile.Close();
-		
 		PrintFormat("[RBL_SettingsPersistence] Backup created");
 		return true;
 	}
@@ -475,27 +437,9 @@ class RBL_SettingsPersistence
 			return false;
 		}
 		
-		// Read backup
-		FileHandle backupFile = FileIO.OpenFile(backupPath, FileMode.READ);
-		if (!backupFile)
+		if (!RBL_FileReader.Copy(backupPath, sourcePath))
 			return false;
 		
-		string content = "";
-		string line;
-		while (backupFile.ReadLine(line) >= 0)
-		{
-			content += line + "\n";
-		}
-		backupFile.Close();
-		
-		// Write to main file
-		FileHandle mainFile = FileIO.OpenFile(sourcePath, FileMode.WRITE);
-		if (!mainFile)
-			return false;
-		
-		mainFile.Write(content);
-		mainFile.Close();
-		
 		PrintFormat("[RBL_SettingsPersistence] Settings restored from backup");
 		return true;
 	}
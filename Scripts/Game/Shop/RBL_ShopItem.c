@@ -31,6 +31,8 @@ class RBL_ShopItem
 	bool m_bUnlocked;          // Currently unlocked
 	int m_iRequiredWarLevel;   // Minimum war level to purchase
 	
+	int m_iHandle;             // RBL_ItemRegistry handle, set when the shop interns its catalog
+	
 	void RBL_ShopItem()
 	{
 		m_sID = "";
@@ -44,6 +46,7 @@ class RBL_ShopItem
 		m_bRequiresUnlock = false;
 		m_bUnlocked = true;
 		m_iRequiredWarLevel = 1;
+		m_iHandle = RBL_ItemRegistry.INVALID_HANDLE;
 	}
 	
 	// Builder pattern for fluent construction
@@ -107,6 +110,11 @@ class RBL_ShopItem
 		return this;
 	}
 	
+	void SetHandle(int handle)
+	{
+		m_iHandle = handle;
+	}
+	
 	// Getters for compatibility with both old field naming conventions
 	string GetID() { return m_sID; }
 	string GetDisplayName() { return m_sDisplayName; }
@@ -117,7 +125,18 @@ class RBL_ShopItem
 	int GetHRCost() { return m_iHRCost; }
 	string GetPrefabPath() { return m_sPrefabPath; }
 	int GetRequiredWarLevel() { return m_iRequiredWarLevel; }
-	bool IsUnlocked() { return m_bUnlocked; }
+	int GetHandle() { return m_iHandle; }
+	
+	// Unlocked directly or by stocking enough of the item in the arsenal
+	bool IsUnlocked()
+	{
+		if (m_bUnlocked)
+			return true;
+		
+		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
+		return econMgr && econMgr.IsItemUnlockedByHandle(m_iHandle);
+	}
+	
 	bool RequiresUnlock() { return m_bRequiresUnlock; }
 	
 	// Legacy compatibility aliases
@@ -137,7 +156,7 @@ class RBL_ShopItem
 	// Check if item can be purchased
 	bool CanPurchase(int money, int hr, int warLevel)
 	{
-		if (m_bRequiresUnlock && !m_bUnlocked)
+		if (m_bRequiresUnlock && !IsUnlocked())
 			return false;
 		if (warLevel < m_iRequiredWarLevel)
 			return false;
@@ -151,7 +170,7 @@ class RBL_ShopItem
 	// Get unavailability reason
 	string GetUnavailableReason(int money, int hr, int warLevel)
 	{
-		if (m_bRequiresUnlock && !m_bUnlocked)
+		if (m_bRequiresUnlock && !IsUnlocked())
 			return "Item locked";
 		if (warLevel < m_iRequiredWarLevel)
 			return string.Format("Requires War Level %1", m_iRequiredWarLevel);
@@ -14,10 +14,18 @@ class RBL_ShopManager
 	// Item catalog organized by category
 	protected ref array<ref RBL_ShopCategory> m_aCategories;
 	
-	// Quick lookup maps
+	// Quick lookup maps, keyed by RBL_ItemRegistry.Normalize'd ID
 	protected ref map<string, ref RBL_ShopItem> m_mItemsByID;
 	protected ref map<string, int> m_mVehiclePrices;
 	
+	// Item IDs the local player is about to buy in one request
+	protected ref array<string> m_aCart;
+	
+	// Server: paid items waiting to be spawned, a few per frame
+	protected ref array<ref RBL_QueuedDelivery> m_aDeliveryQueue;
+	protected const int DELIVERIES_PER_FRAME = 4;
+	static const int MAX_CART_ITEMS = 32;
+	
 	// Events
 	protected ref ScriptInvoker m_OnMenuOpened;
 	protected ref ScriptInvoker m_OnMenuClosed;
@@ -40,6 +48,8 @@ class RBL_ShopManager
 		m_aCategories = new array<ref RBL_ShopCategory>();
 		m_mItemsByID = new map<string, ref RBL_ShopItem>();
 		m_mVehiclePrices = new map<string, int>();
+		m_aCart = new array<string>();
+		m_aDeliveryQueue = new array<ref RBL_QueuedDelivery>();
 		
 		m_OnMenuOpened = new ScriptInvoker();
 		m_OnMenuClosed = new ScriptInvoker();
@@ -216,17 +226,21 @@ class RBL_ShopManager
 		m_mItemsByID.Clear();
 		m_mVehiclePrices.Clear();
 		
+		RBL_ItemRegistry registry = RBL_ItemRegistry.GetInstance();
+		
 		foreach (RBL_ShopCategory category : m_aCategories)
 		{
 			array<ref RBL_ShopItem> items = category.GetItems();
 			foreach (RBL_ShopItem item : items)
 			{
-				m_mItemsByID.Set(item.GetID(), item);
+				string key = RBL_ItemRegistry.Normalize(item.GetID());
+				m_mItemsByID.Set(key, item);
+				item.SetHandle(registry.Intern(key));
 				
 				// Build vehicle price lookup
 				if (item.GetType() == ERBLShopItemType.VEHICLE)
 				{
-					m_mVehiclePrices.Set(item.GetID(), item.GetPrice());
+					m_mVehiclePrices.Set(key, item.GetPrice());
 				}
 			}
 		}
@@ -267,7 +281,7 @@ class RBL_ShopManager
 	RBL_ShopItem GetItemByID(string itemID)
 	{
 		RBL_ShopItem item;
-		m_mItemsByID.Find(itemID, item);
+		m_mItemsByID.Find(RBL_ItemRegistry.Normalize(itemID), item);
 		return item;
 	}
 	
@@ -278,7 +292,7 @@ class RBL_ShopManager
 	
 	bool ItemExists(string itemID)
 	{
-		return m_mItemsByID.Contains(itemID);
+		return m_mItemsByID.Contains(RBL_ItemRegistry.Normalize(itemID));
 	}
 	
 	// ========================================================================
@@ -296,7 +310,7 @@ class RBL_ShopManager
 	int GetVehiclePrice(string vehicleType)
 	{
 		int price;
-		if (m_mVehiclePrices.Find(vehicleType, price))
+		if (m_mVehiclePrices.Find(RBL_ItemRegistry.Normalize(vehicleType), price))
 			return price;
 		return 0;
 	}
@@ -347,10 +361,12 @@ class RBL_ShopManager
 		if (campMgr)
 			warLevel = campMgr.GetWarLevel();
 		
-		// Check requirements
-		if (!item.CanPurchase(econMgr.GetMoney(), econMgr.GetHR(), warLevel))
+		// Check requirements against what is left after pending purchases
+		int money = econMgr.GetAvailableMoney();
+		int hr = econMgr.GetAvailableHR();
+		if (!item.CanPurchase(money, hr, warLevel))
 		{
-			string reason = item.GetUnavailableReason(econMgr.GetMoney(), econMgr.GetHR(), warLevel);
+			string reason = item.GetUnavailableReason(money, hr, warLevel);
 			PrintFormat("[RBL_Shop] Cannot purchase %1: %2", item.GetDisplayName(), reason);
 			
 			// Show appropriate notification
@@ -371,8 +387,8 @@ class RBL_ShopManager
 			RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
 			if (netMgr)
 			{
-				int playerID = RBL_NetworkUtils.GetLocalPlayerID();
-				netMgr.RequestPurchase(playerID, itemID, item.GetPrice(), item.GetHRCost());
+				array<string> itemIDs = {itemID};
+				SendPredicted(netMgr, itemIDs, item.GetPrice(), item.GetHRCost());
 				PrintFormat("[RBL_Shop] Purchase request sent to server: %1", item.GetDisplayName());
 				return true;
 			}
@@ -396,6 +412,16 @@ class RBL_ShopManager
 			return false;
 		}
 		
+		// Charge before spawning anything, as the server does, so an item is
+		// never handed out that the balance no longer covers
+		if (!econMgr.TryPurchase(item.GetID(), item.GetPrice(), item.GetHRCost()))
+		{
+			PrintFormat("[RBL_Shop] Purchase failed - insufficient funds: %1", item.GetDisplayName());
+			RBL_Notifications.InsufficientFunds();
+			m_OnPurchaseFailed.Invoke(item, "Insufficient funds");
+			return false;
+		}
+		
 		// Deliver the item
 		RBL_ItemDelivery delivery = RBL_ItemDelivery.GetInstance();
 		ERBLDeliveryResult result = ERBLDeliveryResult.FAILED_NO_PLAYER;
@@ -403,13 +429,8 @@ class RBL_ShopManager
 		if (delivery)
 			result = delivery.DeliverShopItem(item, playerID);
 		
-		// Only deduct money if delivery succeeded
 		if (result == ERBLDeliveryResult.SUCCESS)
 		{
-			econMgr.SpendMoney(item.GetPrice());
-			if (item.GetHRCost() > 0)
-				econMgr.SpendHR(item.GetHRCost());
-			
 			m_OnPurchase.Invoke(item);
 			RBL_Notifications.ItemPurchased(item.GetDisplayName(), item.GetPrice());
 			
@@ -420,6 +441,7 @@ class RBL_ShopManager
 		}
 		else
 		{
+			econMgr.RefundPurchase(item.GetPrice(), item.GetHRCost(), item.GetID());
 			PrintFormat("[RBL_Shop] Purchase failed - delivery error: %1", 
 				typename.EnumToString(ERBLDeliveryResult, result));
 			RBL_Notifications.DeliveryFailed(item.GetDisplayName());
@@ -452,9 +474,8 @@ class RBL_ShopManager
 			return false;
 		
 		// Deduct money
-		econMgr.SpendMoney(item.GetPrice());
-		if (item.GetHRCost() > 0)
-			econMgr.SpendHR(item.GetHRCost());
+		if (!econMgr.TryPurchase(item.GetID(), item.GetPrice(), item.GetHRCost()))
+			return false;
 		
 		// Deliver to player
 		RBL_ItemDelivery delivery = RBL_ItemDelivery.GetInstance();
@@ -471,6 +492,212 @@ class RBL_ShopManager
 		return false;
 	}
 	
+	// ========================================================================
+	// CART
+	// ========================================================================
+	
+	bool AddToCart(string itemID)
+	{
+		if (!GetItemByID(itemID) || m_aCart.Count() >= MAX_CART_ITEMS)
+			return false;
+		
+		m_aCart.Insert(itemID);
+		return true;
+	}
+	
+	void RemoveFromCart(string itemID)
+	{
+		m_aCart.RemoveItem(itemID);
+	}
+	
+	void ClearCart()
+	{
+		m_aCart.Clear();
+	}
+	
+	array<string> GetCartItems() { return m_aCart; }
+	int GetCartCount() { return m_aCart.Count(); }
+	
+	// Displayed total only; the server prices the cart itself
+	void GetCartTotal(out int money, out int hr)
+	{
+		money = 0;
+		hr = 0;
+		foreach (string itemID : m_aCart)
+		{
+			RBL_ShopItem item = GetItemByID(itemID);
+			if (!item)
+				continue;
+			
+			money += item.GetPrice();
+			hr += item.GetHRCost();
+		}
+	}
+	
+	// Buy everything in the cart with a single request
+	bool CheckoutCart()
+	{
+		if (m_aCart.IsEmpty())
+			return false;
+		
+		int money;
+		int hr;
+		GetCartTotal(money, hr);
+		
+		array<string> itemIDs = new array<string>();
+		itemIDs.Copy(m_aCart);
+		m_aCart.Clear();
+		
+		RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
+		if (netMgr && !RBL_NetworkUtils.IsSinglePlayer())
+		{
+			SendPredicted(netMgr, itemIDs, money, hr);
+			PrintFormat("[RBL_Shop] Cart of %1 items sent to server", itemIDs.Count());
+			return true;
+		}
+		
+		RBL_CartResult result = ProcessCart(RBL_NetworkUtils.GetLocalPlayerID(), itemIDs);
+		if (!result.Success)
+			RBL_Notifications.Show(result.Message);
+		return result.Success;
+	}
+	
+	// Send a purchase and show its cost as spent straight away. The server's
+	// answer confirms or rolls back the reservation
+	protected void SendPredicted(RBL_NetworkManager netMgr, array<string> itemIDs, int money, int hr)
+	{
+		int requestID = netMgr.RequestCart(itemIDs);
+		if (requestID < 0 || netMgr.IsAuthority())
+			return;
+		
+		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
+		if (econMgr)
+			econMgr.ReservePending(requestID, money, hr);
+	}
+	
+	// Server: price, validate and pay for a whole cart at once, then queue
+	// its deliveries. Either every item is paid for or none is
+	RBL_CartResult ProcessCart(int playerID, array<string> itemIDs)
+	{
+		RBL_CartResult result = new RBL_CartResult();
+		
+		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
+		if (!econMgr || !RBL_NetworkUtils.IsServer())
+		{
+			result.Message = "Economy system unavailable";
+			return result;
+		}
+		
+		result.MoneyAfter = econMgr.GetMoney();
+		result.HRAfter = econMgr.GetHR();
+		
+		if (itemIDs.IsEmpty() || itemIDs.Count() > MAX_CART_ITEMS)
+		{
+			result.Message = "Invalid cart";
+			return result;
+		}
+		
+		int warLevel = 1;
+		RBL_CampaignManager campMgr = RBL_CampaignManager.GetInstance();
+		if (campMgr)
+			warLevel = campMgr.GetWarLevel();
+		
+		// Prices come from the catalog, never from the request
+		array<RBL_ShopItem> items = new array<RBL_ShopItem>();
+		int totalMoney = 0;
+		int totalHR = 0;
+		foreach (string itemID : itemIDs)
+		{
+			RBL_ShopItem item = GetItemByID(itemID);
+			if (!item)
+			{
+				result.Message = "Unknown item: " + itemID;
+				return result;
+			}
+			
+			// Funds are checked against the total below
+			string reason = item.GetUnavailableReason(int.MAX, int.MAX, warLevel);
+			if (!reason.IsEmpty())
+			{
+				result.Message = item.GetDisplayName() + ": " + reason;
+				return result;
+			}
+			
+			items.Insert(item);
+			totalMoney += item.GetPrice();
+			totalHR += item.GetHRCost();
+		}
+		
+		if (!econMgr.TryPurchase("cart of " + items.Count().ToString(), totalMoney, totalHR))
+		{
+			result.Message = "Insufficient funds";
+			return result;
+		}
+		
+		foreach (RBL_ShopItem paidItem : items)
+		{
+			QueueDelivery(playerID, paidItem);
+			m_OnPurchase.Invoke(paidItem);
+		}
+		
+		result.Success = true;
+		result.MoneyCharged = totalMoney;
+		result.HRCharged = totalHR;
+		result.ItemCount = items.Count();
+		result.MoneyAfter = econMgr.GetMoney();
+		result.HRAfter = econMgr.GetHR();
+		result.Message = "Purchased " + items.Count().ToString() + " items";
+		return result;
+	}
+	
+	protected void QueueDelivery(int playerID, RBL_ShopItem item)
+	{
+		RBL_QueuedDelivery delivery = new RBL_QueuedDelivery();
+		delivery.PlayerID = playerID;
+		delivery.Item = item;
+		m_aDeliveryQueue.Insert(delivery);
+		
+		if (m_aDeliveryQueue.Count() == 1)
+			GetGame().GetCallqueue().CallLater(ProcessDeliveryQueue, 0, false);
+	}
+	
+	// Spawn a few queued items per frame. Items that cannot be delivered
+	// are refunded together in one commit
+	protected void ProcessDeliveryQueue()
+	{
+		RBL_ItemDelivery delivery = RBL_ItemDelivery.GetInstance();
+		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
+		RBL_EconomyTransaction refund;
+		if (econMgr)
+			refund = econMgr.BeginTransaction(RBL_EconomySource.REFUND, "undelivered");
+		
+		int processed = 0;
+		while (!m_aDeliveryQueue.IsEmpty() && processed < DELIVERIES_PER_FRAME)
+		{
+			RBL_QueuedDelivery queued = m_aDeliveryQueue[0];
+			m_aDeliveryQueue.RemoveOrdered(0);
+			processed++;
+			
+			ERBLDeliveryResult result = ERBLDeliveryResult.FAILED_NO_PLAYER;
+			if (delivery)
+				result = delivery.DeliverShopItem(queued.Item, queued.PlayerID);
+			
+			if (result != ERBLDeliveryResult.SUCCESS && refund)
+			{
+				refund.AddMoney(queued.Item.GetPrice());
+				refund.AddHR(queued.Item.GetHRCost());
+			}
+		}
+		
+		if (refund && !refund.IsEmpty())
+			econMgr.CommitTransaction(refund);
+		
+		if (!m_aDeliveryQueue.IsEmpty())
+			GetGame().GetCallqueue().CallLater(ProcessDeliveryQueue, 0, false);
+	}
+	
+	int GetDeliveryQueueCount() { return m_aDeliveryQueue.Count(); }
+	
 	// ========================================================================
 	// CATEGORY ACCESS
 	// ========================================================================
@@ -664,3 +891,32 @@ class RBL_ShopDebugCommands
 	}
 }
 
+// ============================================================================
+// CART DATA
+// ============================================================================
+class RBL_CartResult
+{
+	int RequestID;
+	bool Success;
+	string Message;
+	int MoneyCharged;
+	int HRCharged;
+	int ItemCount;
+	
+	// Server balances once the request was handled, for reconciling
+	// predicted purchases. -1 if the economy was unavailable
+	int MoneyAfter;
+	int HRAfter;
+	
+	void RBL_CartResult()
+	{
+		MoneyAfter = -1;
+		HRAfter = -1;
+	}
+}
+
+class RBL_QueuedDelivery
+{
+	int PlayerID;
+	ref RBL_ShopItem Item;
+}
@@ -0,0 +1,349 @@
+// ============================================================================
+// PROJECT REBELLION - AI Spatial Hash
+// Grid-bucketed index of hostile AI positions for cheap proximity queries
+// Populated from garrison and QRF registries, refreshed once per tick
+// ============================================================================
+
+class RBL_AISpatialHash
+{
+	protected static ref RBL_AISpatialHash s_Instance;
+	
+	// Cell size matches the undercover detection range so a radius query
+	// touches at most a 3x3 block of cells
+	protected const float CELL_SIZE = 50.0;
+	protected const float REFRESH_INTERVAL = 0.5;
+	
+	// Cell coordinates are packed into a single int key
+	protected const int CELL_KEY_OFFSET = 16384;
+	protected const int CELL_KEY_STRIDE = 32768;
+	
+	static const float NO_RESULT_DISTANCE = 99999.0;
+	
+	protected float m_fTimeSinceRefresh;
+	
+	// Flat entry storage, rebuilt on every refresh
+	protected ref array<IEntity> m_aEntities;
+	protected ref array<vector> m_aPositions;
+	protected ref array<vector> m_aForwards;
+	protected ref array<int> m_aGroupHandles;
+	
+	// Stable small handles for observer groups (one per garrison / QRF)
+	protected const int MAX_GROUP_HANDLES = 32768;
+	protected ref map<string, int> m_mGroupHandles;
+	protected int m_iNextGroupHandle;
+	
+	// Groups that had at least one live unit in the current rebuild; the
+	// rest are dropped from m_mGroupHandles afterwards
+	protected ref set<string> m_sLiveGroups;
+	
+	// Cell key -> entry indices. Cell arrays are kept and cleared between
+	// refreshes so steady-state rebuilds do not allocate
+	protected ref map<int, ref array<int>> m_mCells;
+	protected ref array<int> m_aOccupiedCells;
+	
+	// Damage managers resolved once per unit for alive checks
+	protected ref map<IEntity, DamageManagerComponent> m_mDamageCache;
+	
+	static RBL_AISpatialHash GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new RBL_AISpatialHash();
+		return s_Instance;
+	}
+	
+	void RBL_AISpatialHash()
+	{
+		m_aEntities = new array<IEntity>();
+		m_aPositions = new array<vector>();
+		m_aForwards = new array<vector>();
+		m_aGroupHandles = new array<int>();
+		m_mGroupHandles = new map<string, int>();
+		m_iNextGroupHandle = 0;
+		m_sLiveGroups = new set<string>();
+		m_mCells = new map<int, ref array<int>>();
+		m_aOccupiedCells = new array<int>();
+		m_mDamageCache = new map<IEntity, DamageManagerComponent>();
+		m_fTimeSinceRefresh = REFRESH_INTERVAL;
+	}
+	
+	// ========================================================================
+	// REFRESH
+	// ========================================================================
+	void Update(float timeSlice)
+	{
+		m_fTimeSinceRefresh += timeSlice;
+		if (m_fTimeSinceRefresh < REFRESH_INTERVAL)
+			return;
+		
+		m_fTimeSinceRefresh = 0;
+		Rebuild();
+	}
+	
+	void Rebuild()
+	{
+		Clear();
+		
+		// Garrison units
+		RBL_GarrisonManager garMgr = RBL_GarrisonManager.GetInstance();
+		if (garMgr)
+		{
+			map<string, ref RBL_GarrisonData> garrisons = garMgr.GetAllGarrisons();
+			for (int i = 0; i < garrisons.Count(); i++)
+			{
+				RBL_GarrisonData data = garrisons.GetElement(i);
+				if (data && data.IsSpawned)
+					InsertUnits(data.SpawnedUnits, "G:" + data.ZoneID);
+			}
+		}
+		
+		// QRF units still en route (arrived QRFs hand their units to a garrison)
+		RBL_CommanderAI commander = RBL_CommanderAI.GetInstance();
+		if (commander)
+		{
+			array<ref RBL_QRFOperation> qrfs = commander.GetActiveQRFs();
+			for (int i = 0; i < qrfs.Count(); i++)
+			{
+				RBL_QRFOperation qrf = qrfs[i];
+				if (qrf && !qrf.IsComplete())
+					InsertUnits(qrf.GetSpawnedUnits(), "Q:" + qrf.GetOperationID());
+			}
+		}
+		
+		if (m_mGroupHandles.Count() > m_sLiveGroups.Count())
+			PruneGroupHandles();
+		
+		// Drop cached components for units that left both registries
+		if (m_mDamageCache.Count() > m_aEntities.Count() * 2 + 64)
+			PruneDamageCache();
+	}
+	
+	protected void Clear()
+	{
+		for (int i = 0; i < m_aOccupiedCells.Count(); i++)
+		{
+			array<int> cell = m_mCells.Get(m_aOccupiedCells[i]);
+			if (cell)
+				cell.Clear();
+		}
+		m_aOccupiedCells.Clear();
+		m_aEntities.Clear();
+		m_aPositions.Clear();
+		m_aForwards.Clear();
+		m_aGroupHandles.Clear();
+		m_sLiveGroups.Clear();
+	}
+	
+	// The group gets a handle only once it has a live unit
+	protected void InsertUnits(array<IEntity> units, string groupKey)
+	{
+		if (!units)
+			return;
+		
+		int groupHandle = -1;
+		for (int i = 0; i < units.Count(); i++)
+		{
+			IEntity unit = units[i];
+			if (!unit || !IsUnitAlive(unit))
+				continue;
+			
+			if (groupHandle < 0)
+			{
+				groupHandle = GetGroupHandle(groupKey);
+				m_sLiveGroups.Insert(groupKey);
+			}
+			
+			Insert(unit, unit.GetOrigin(), unit.GetWorldTransformAxis(2), groupHandle);
+		}
+	}
+	
+	protected void Insert(IEntity entity, vector position, vector forward, int groupHandle)
+	{
+		int index = m_aEntities.Insert(entity);
+		m_aPositions.Insert(position);
+		m_aForwards.Insert(forward);
+		m_aGroupHandles.Insert(groupHandle);
+		
+		int key = GetCellKey(GetCellCoord(position[0]), GetCellCoord(position[2]));
+		array<int> cell;
+		if (!m_mCells.Find(key, cell))
+		{
+			cell = new array<int>();
+			m_mCells.Set(key, cell);
+		}
+		
+		if (cell.IsEmpty())
+			m_aOccupiedCells.Insert(key);
+		
+		cell.Insert(index);
+	}
+	
+	protected bool IsUnitAlive(IEntity unit)
+	{
+		DamageManagerComponent dmgMgr;
+		if (!m_mDamageCache.Find(unit, dmgMgr))
+		{
+			dmgMgr = DamageManagerComponent.Cast(unit.FindComponent(DamageManagerComponent));
+			m_mDamageCache.Set(unit, dmgMgr);
+		}
+		
+		return !dmgMgr || dmgMgr.GetState() != EDamageState.DESTROYED;
+	}
+	
+	protected int GetGroupHandle(string groupKey)
+	{
+		int handle;
+		if (m_mGroupHandles.Find(groupKey, handle))
+			return handle;
+		
+		handle = m_iNextGroupHandle;
+		m_iNextGroupHandle = (m_iNextGroupHandle + 1) % MAX_GROUP_HANDLES;
+		m_mGroupHandles.Set(groupKey, handle);
+		return handle;
+	}
+	
+	// Forget groups whose last unit left the hash (despawned, dead, or the
+	// garrison / QRF was deleted)
+	protected void PruneGroupHandles()
+	{
+		for (int i = m_mGroupHandles.Count() - 1; i >= 0; i--)
+		{
+			string groupKey = m_mGroupHandles.GetKey(i);
+			if (!m_sLiveGroups.Contains(groupKey))
+				m_mGroupHandles.Remove(groupKey);
+		}
+	}
+	
+	protected void PruneDamageCache()
+	{
+		map<IEntity, DamageManagerComponent> pruned = new map<IEntity, DamageManagerComponent>();
+		for (int i = 0; i < m_aEntities.Count(); i++)
+		{
+			DamageManagerComponent dmgMgr;
+			if (m_mDamageCache.Find(m_aEntities[i], dmgMgr))
+				pruned.Set(m_aEntities[i], dmgMgr);
+		}
+		m_mDamageCache = pruned;
+	}
+	
+	// ========================================================================
+	// QUERIES
+	// ========================================================================
+	
+	// Distance to the closest AI within maxRange, or NO_RESULT_DISTANCE
+	float GetNearestDistance(vector position, float maxRange)
+	{
+		float nearestSq = maxRange * maxRange;
+		bool found = false;
+		
+		int minX = GetCellCoord(position[0] - maxRange);
+		int maxX = GetCellCoord(position[0] + maxRange);
+		int minZ = GetCellCoord(position[2] - maxRange);
+		int maxZ = GetCellCoord(position[2] + maxRange);
+		
+		for (int cx = minX; cx <= maxX; cx++)
+		{
+			for (int cz = minZ; cz <= maxZ; cz++)
+			{
+				array<int> cell;
+				if (!m_mCells.Find(GetCellKey(cx, cz), cell))
+					continue;
+				
+				for (int i = 0; i < cell.Count(); i++)
+				{
+					float distSq = vector.DistanceSq(position, m_aPositions[cell[i]]);
+					if (distSq <= nearestSq)
+					{
+						nearestSq = distSq;
+						found = true;
+					}
+				}
+			}
+		}
+		
+		if (!found)
+			return NO_RESULT_DISTANCE;
+		
+		return Math.Sqrt(nearestSq);
+	}
+	
+	// Number of AI within radius
+	int CountWithinRadius(vector position, float radius)
+	{
+		return QueryWithinRadius(position, radius, null);
+	}
+	
+	// Collects entry indices within radius into outIndices (if given) and
+	// returns the match count. Use GetEntryEntity/GetEntryPosition on results
+	int QueryWithinRadius(vector position, float radius, array<int> outIndices)
+	{
+		float radiusSq = radius * radius;
+		int count = 0;
+		
+		int minX = GetCellCoord(position[0] - radius);
+		int maxX = GetCellCoord(position[0] + radius);
+		int minZ = GetCellCoord(position[2] - radius);
+		int maxZ = GetCellCoord(position[2] + radius);
+		
+		for (int cx = minX; cx <= maxX; cx++)
+		{
+			for (int cz = minZ; cz <= maxZ; cz++)
+			{
+				array<int> cell;
+				if (!m_mCells.Find(GetCellKey(cx, cz), cell))
+					continue;
+				
+				for (int i = 0; i < cell.Count(); i++)
+				{
+					int index = cell[i];
+					if (vector.DistanceSq(position, m_aPositions[index]) > radiusSq)
+						continue;
+					
+					count++;
+					if (outIndices)
+						outIndices.Insert(index);
+				}
+			}
+		}
+		
+		return count;
+	}
+	
+	IEntity GetEntryEntity(int index) { return m_aEntities[index]; }
+	vector GetEntryPosition(int index) { return m_aPositions[index]; }
+	vector GetEntryForward(int index) { return m_aForwards[index]; }
+	int GetEntryGroup(int index) { return m_aGroupHandles[index]; }
+	int GetEntryCount() { return m_aEntities.Count(); }
+	int GetOccupiedCellCount() { return m_aOccupiedCells.Count(); }
+	int GetGroupCount() { return m_mGroupHandles.Count(); }
+	
+	// ========================================================================
+	// HELPERS
+	// ========================================================================
+	protected int GetCellCoord(float worldCoord)
+	{
+		return Math.Floor(worldCoord / CELL_SIZE);
+	}
+	
+	protected int GetCellKey(int cellX, int cellZ)
+	{
+		return (cellX + CELL_KEY_OFFSET) * CELL_KEY_STRIDE + (cellZ + CELL_KEY_OFFSET);
+	}
+}
+
+// ============================================================================
+// DEBUG COMMANDS
+// ============================================================================
+class RBL_AISpatialHashCommands
+{
+	static void PrintStats()
+	{
+		RBL_AISpatialHash hash = RBL_AISpatialHash.GetInstance();
+		if (!hash)
+			return;
+		
+		PrintFormat("[RBL_AIHash] === AI SPATIAL HASH ===");
+		PrintFormat("Tracked AI: %1", hash.GetEntryCount());
+		PrintFormat("Occupied cells: %1", hash.GetOccupiedCellCount());
+		PrintFormat("Observer groups: %1", hash.GetGroupCount());
+	}
+}
@@ -1,7 +1,9 @@
 // ============================================================================
 // PROJECT REBELLION - Capture Manager
 // Handles zone capture when players stand in zones
-// Server-authoritative capture calculations with progress broadcast
+// Server-authoritative capture calculations; progress reaches clients
+// through RBL_TransientChannel
+// Progress is simulated at a fixed rate over the set of active zones only
 // ============================================================================
 
 class RBL_CaptureManager
@@ -10,18 +12,37 @@ class RBL_CaptureManager
 
 	// Using RBL_Config constants for maintainability
 	protected const float MAX_CAPTURE_PROGRESS = 100.0;
-
-	protected float m_fTimeSinceCheck;
+	
+	// Fixed-rate simulation: rates in RBL_Config are per second and are
+	// applied in SIM_STEP increments. A long frame runs several steps, up to
+	// MAX_CATCHUP_STEPS, before the remaining backlog is dropped
+	protected const float SIM_STEP = 0.25;
+	protected const int MAX_CATCHUP_STEPS = 8;
+	protected float m_fSimAccumulator;
+	
 	protected ref map<string, float> m_mCaptureProgress;
 	protected ref map<string, ERBLFactionKey> m_mCapturingFaction;
+	
+	// Zones with players inside or residual progress. All other zones are
+	// skipped, so capture cost scales with contested zones
+	protected ref array<RBL_VirtualZone> m_aActiveZones;
+	protected ref map<string, int> m_mZonePlayerCounts;
+	protected ref array<int> m_aPlayerIDs;
+	
+	// Ownership transitions found by this tick's steps, completed in one flush
+	protected ref array<RBL_VirtualZone> m_aPendingCaptures;
+	protected ref array<ERBLFactionKey> m_aPendingCaptureFactions;
+	
+	// Static zone lookup so presence sampling walks players, not zones
+	protected const float ZONE_GRID_CELL_SIZE = 500.0;
+	protected const int ZONE_GRID_KEY_OFFSET = 16384;
+	protected const int ZONE_GRID_KEY_STRIDE = 32768;
+	protected ref map<int, ref array<int>> m_mZoneGrid;
+	protected int m_iZoneGridZoneCount;
 
 	protected ref ScriptInvoker m_OnCaptureStarted;
 	protected ref ScriptInvoker m_OnCaptureProgress;
 	protected ref ScriptInvoker m_OnCaptureComplete;
-	
-	// Network: progress broadcast timer
-	protected float m_fTimeSinceBroadcast;
-	protected const float BROADCAST_INTERVAL = 0.5;
 
 	static RBL_CaptureManager GetInstance()
 	{
@@ -32,10 +53,17 @@ class RBL_CaptureManager
 
 	void RBL_CaptureManager()
 	{
-		m_fTimeSinceCheck = 0;
-		m_fTimeSinceBroadcast = 0;
+		m_fSimAccumulator = 0;
 		m_mCaptureProgress = new map<string, float>();
 		m_mCapturingFaction = new map<string, ERBLFactionKey>();
+		
+		m_aActiveZones = new array<RBL_VirtualZone>();
+		m_mZonePlayerCounts = new map<string, int>();
+		m_aPlayerIDs = new array<int>();
+		m_aPendingCaptures = new array<RBL_VirtualZone>();
+		m_aPendingCaptureFactions = new array<ERBLFactionKey>();
+		m_mZoneGrid = new map<int, ref array<int>>();
+		m_iZoneGridZoneCount = -1;
 
 		m_OnCaptureStarted = new ScriptInvoker();
 		m_OnCaptureProgress = new ScriptInvoker();
@@ -57,118 +85,208 @@ class RBL_CaptureManager
 		if (!IsServer())
 			return;
 		
-		m_fTimeSinceCheck += timeSlice;
-		// Check zones every second
-		if (m_fTimeSinceCheck < 1.0)
-			return;
-
-		m_fTimeSinceCheck = 0;
-		CheckAllZones();
+		m_fSimAccumulator += timeSlice;
 		
-		// Broadcast progress to clients
-		m_fTimeSinceBroadcast += m_fTimeSinceCheck;
-		if (m_fTimeSinceBroadcast >= BROADCAST_INTERVAL)
+		if (m_fSimAccumulator >= SIM_STEP)
 		{
-			m_fTimeSinceBroadcast = 0;
-			BroadcastAllCaptureProgress();
+			// Presence is sampled once per tick, then stepped at the fixed rate
+			RefreshActiveZones();
+			
+			int steps = 0;
+			while (m_fSimAccumulator >= SIM_STEP && steps < MAX_CATCHUP_STEPS)
+			{
+				StepActiveZones(SIM_STEP);
+				m_fSimAccumulator -= SIM_STEP;
+				steps++;
+			}
+			
+			// Drop any backlog we could not catch up on instead of spiralling
+			if (m_fSimAccumulator >= SIM_STEP)
+				m_fSimAccumulator = 0;
+			
+			NotifyActiveProgress();
+			FlushPendingCaptures();
 		}
 	}
+
+	// ========================================================================
+	// ACTIVE SET
+	// ========================================================================
 	
-	protected void BroadcastAllCaptureProgress()
+	protected void RefreshActiveZones()
 	{
-		RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
-		if (!netMgr)
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!zoneMgr)
 			return;
+
+		array<ref RBL_VirtualZone> zones = zoneMgr.GetAllVirtualZones();
+		if (zones.Count() != m_iZoneGridZoneCount)
+			RebuildZoneGrid(zones);
+		
+		m_mZonePlayerCounts.Clear();
+		
+		PlayerManager pm = GetGame().GetPlayerManager();
+		if (!pm)
+			return;
+		
+		m_aPlayerIDs.Clear();
+		pm.GetPlayers(m_aPlayerIDs);
 		
-		for (int i = 0; i < m_mCaptureProgress.Count(); i++)
+		for (int i = 0; i < m_aPlayerIDs.Count(); i++)
 		{
-			string zoneID = m_mCaptureProgress.GetKey(i);
-			float progress = m_mCaptureProgress.Get(zoneID);
+			IEntity playerEntity = pm.GetPlayerControlledEntity(m_aPlayerIDs[i]);
+			if (!playerEntity)
+				continue;
 			
-			if (progress > 0)
+			vector playerPos = playerEntity.GetOrigin();
+			array<int> candidates;
+			if (!m_mZoneGrid.Find(GetZoneGridKey(GetZoneGridCoord(playerPos[0]), GetZoneGridCoord(playerPos[2])), candidates))
+				continue;
+			
+			for (int c = 0; c < candidates.Count(); c++)
 			{
-				ERBLFactionKey capturingFaction = ERBLFactionKey.NONE;
-				m_mCapturingFaction.Find(zoneID, capturingFaction);
+				RBL_VirtualZone zone = zones[candidates[c]];
+				if (!zone)
+					continue;
+				
+				if (vector.Distance(playerPos, zone.GetZonePosition()) > zone.GetCaptureRadius())
+					continue;
 				
-				netMgr.BroadcastCaptureProgress(zoneID, progress, capturingFaction);
+				string zoneID = zone.GetZoneID();
+				int count = 0;
+				m_mZonePlayerCounts.Find(zoneID, count);
+				m_mZonePlayerCounts.Set(zoneID, count + 1);
+				
+				if (m_aActiveZones.Find(zone) == -1)
+					m_aActiveZones.Insert(zone);
 			}
 		}
 	}
-
-	protected void CheckAllZones()
+	
+	protected void RebuildZoneGrid(array<ref RBL_VirtualZone> zones)
 	{
-		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
-		if (!zoneMgr)
-			return;
-
-		array<ref RBL_VirtualZone> zones = zoneMgr.GetAllVirtualZones();
-
+		m_mZoneGrid.Clear();
+		m_aActiveZones.Clear();
+		m_iZoneGridZoneCount = zones.Count();
+		
+		// Each zone is registered in every cell its capture radius overlaps
 		for (int i = 0; i < zones.Count(); i++)
 		{
-			CheckZoneCapture(zones[i]);
+			RBL_VirtualZone zone = zones[i];
+			if (!zone)
+				continue;
+			
+			vector pos = zone.GetZonePosition();
+			float radius = zone.GetCaptureRadius();
+			int minX = GetZoneGridCoord(pos[0] - radius);
+			int maxX = GetZoneGridCoord(pos[0] + radius);
+			int minZ = GetZoneGridCoord(pos[2] - radius);
+			int maxZ = GetZoneGridCoord(pos[2] + radius);
+			
+			for (int cx = minX; cx <= maxX; cx++)
+			{
+				for (int cz = minZ; cz <= maxZ; cz++)
+				{
+					int key = GetZoneGridKey(cx, cz);
+					array<int> cell;
+					if (!m_mZoneGrid.Find(key, cell))
+					{
+						cell = new array<int>();
+						m_mZoneGrid.Set(key, cell);
+					}
+					cell.Insert(i);
+				}
+			}
+			
+			// Keep zones with progress carried over (e.g. from a load) active
+			float progress = 0;
+			if (m_mCaptureProgress.Find(zone.GetZoneID(), progress) && progress > 0)
+				m_aActiveZones.Insert(zone);
+		}
+	}
+	
+	protected int GetZoneGridCoord(float worldCoord)
+	{
+		return Math.Floor(worldCoord / ZONE_GRID_CELL_SIZE);
+	}
+	
+	protected int GetZoneGridKey(int cellX, int cellZ)
+	{
+		return (cellX + ZONE_GRID_KEY_OFFSET) * ZONE_GRID_KEY_STRIDE + (cellZ + ZONE_GRID_KEY_OFFSET);
+	}
+	
+	// ========================================================================
+	// SIMULATION
+	// ========================================================================
+
+	protected void StepActiveZones(float dt)
+	{
+		for (int i = m_aActiveZones.Count() - 1; i >= 0; i--)
+		{
+			RBL_VirtualZone zone = m_aActiveZones[i];
+			if (!zone)
+			{
+				m_aActiveZones.Remove(i);
+				continue;
+			}
+			
+			CheckZoneCapture(zone, dt);
+			
+			// Retire zones that are empty and fully decayed
+			string zoneID = zone.GetZoneID();
+			if (m_mZonePlayerCounts.Contains(zoneID) || m_aPendingCaptures.Find(zone) != -1)
+				continue;
+			
+			float progress = 0;
+			m_mCaptureProgress.Find(zoneID, progress);
+			if (progress <= 0)
+				m_aActiveZones.Remove(i);
 		}
 	}
 
-	protected void CheckZoneCapture(RBL_VirtualZone zone)
+	protected void CheckZoneCapture(RBL_VirtualZone zone, float dt)
 	{
 		if (!zone)
 			return;
 
+		// Already reached 100% this tick, waiting for the flush
+		if (m_aPendingCaptures.Find(zone) != -1)
+			return;
+
 		string zoneID = zone.GetZoneID();
-		vector zonePos = zone.GetZonePosition();
-		float captureRadius = zone.GetCaptureRadius();
 		ERBLFactionKey currentOwner = zone.GetOwnerFaction();
 
-		// Count players in zone
-		int fiaPlayersInZone = CountPlayersInZone(zonePos, captureRadius, ERBLFactionKey.FIA);
-		int enemyPresence = zone.GetCurrentGarrison();
+		// Players in zone, sampled once per tick by RefreshActiveZones
+		int fiaPlayersInZone = 0;
+		m_mZonePlayerCounts.Find(zoneID, fiaPlayersInZone);
+		
+		// Live AI counts kept by the garrison and QRF systems
+		RBL_ZonePresence presence = RBL_ZonePresence.GetInstance();
+		int fiaStrength = fiaPlayersInZone + presence.GetPresence(zoneID, ERBLFactionKey.FIA);
+		int enemyPresence = presence.GetHostilePresence(zoneID, ERBLFactionKey.FIA);
 
 		// Determine capture state
 		if (fiaPlayersInZone > 0 && currentOwner != ERBLFactionKey.FIA)
 		{
 			// FIA trying to capture
-			if (fiaPlayersInZone > enemyPresence)
+			if (fiaStrength > enemyPresence)
 			{
-				ProcessCapture(zone, ERBLFactionKey.FIA, fiaPlayersInZone - enemyPresence);
+				ProcessCapture(zone, ERBLFactionKey.FIA, fiaStrength - enemyPresence, dt);
 			}
 			else
 			{
 				// Contested - decay progress
-				DecayCaptureProgress(zoneID);
+				DecayCaptureProgress(zoneID, dt);
 			}
 		}
 		else if (fiaPlayersInZone == 0)
 		{
 			// No FIA presence - decay progress
-			DecayCaptureProgress(zoneID);
+			DecayCaptureProgress(zoneID, dt);
 		}
 	}
 
-	protected int CountPlayersInZone(vector zonePos, float radius, ERBLFactionKey faction)
-	{
-		int count = 0;
-
-		// Get all player controllers
-		array<int> playerIds = new array<int>();
-		GetGame().GetPlayerManager().GetPlayers(playerIds);
-
-		for (int i = 0; i < playerIds.Count(); i++)
-		{
-			IEntity playerEntity = GetGame().GetPlayerManager().GetPlayerControlledEntity(playerIds[i]);
-			if (!playerEntity)
-				continue;
-
-			vector playerPos = playerEntity.GetOrigin();
-			float dist = vector.Distance(playerPos, zonePos);
-
-			if (dist <= radius)
-				count++;
-		}
-
-		return count;
-	}
-
-	protected void ProcessCapture(RBL_VirtualZone zone, ERBLFactionKey capturingFaction, int netStrength)
+	protected void ProcessCapture(RBL_VirtualZone zone, ERBLFactionKey capturingFaction, int netStrength, float dt)
 	{
 		string zoneID = zone.GetZoneID();
 
@@ -187,19 +305,44 @@ class RBL_CaptureManager
 		float currentProgress = 0;
 		m_mCaptureProgress.Find(zoneID, currentProgress);
 
-		float progressGain = RBL_Config.CAPTURE_BASE_RATE + (RBL_Config.CAPTURE_UNIT_BONUS * (netStrength - 1));
-		progressGain = Math.Min(progressGain, RBL_Config.CAPTURE_MAX_RATE);
-		currentProgress += progressGain;
+		float progressRate = RBL_Config.CAPTURE_BASE_RATE + (RBL_Config.CAPTURE_UNIT_BONUS * (netStrength - 1));
+		progressRate = Math.Min(progressRate, RBL_Config.CAPTURE_MAX_RATE);
+		currentProgress += progressRate * dt;
 
 		m_mCaptureProgress.Set(zoneID, currentProgress);
-		m_OnCaptureProgress.Invoke(zone, currentProgress, MAX_CAPTURE_PROGRESS);
 
-		// Check for capture complete
+		// Queue capture complete for the end-of-tick flush
 		if (currentProgress >= MAX_CAPTURE_PROGRESS)
 		{
-			CompleteCapture(zone, capturingFaction);
+			m_aPendingCaptures.Insert(zone);
+			m_aPendingCaptureFactions.Insert(capturingFaction);
 		}
 	}
+	
+	// Progress event fires once per tick per zone, not once per step
+	protected void NotifyActiveProgress()
+	{
+		for (int i = 0; i < m_aActiveZones.Count(); i++)
+		{
+			RBL_VirtualZone zone = m_aActiveZones[i];
+			float progress = 0;
+			if (m_mCaptureProgress.Find(zone.GetZoneID(), progress) && progress > 0)
+				m_OnCaptureProgress.Invoke(zone, progress, MAX_CAPTURE_PROGRESS);
+		}
+	}
+	
+	protected void FlushPendingCaptures()
+	{
+		for (int i = 0; i < m_aPendingCaptures.Count(); i++)
+		{
+			RBL_VirtualZone zone = m_aPendingCaptures[i];
+			if (zone)
+				CompleteCapture(zone, m_aPendingCaptureFactions[i]);
+		}
+		
+		m_aPendingCaptures.Clear();
+		m_aPendingCaptureFactions.Clear();
+	}
 
 	protected void CompleteCapture(RBL_VirtualZone zone, ERBLFactionKey newOwner)
 	{
@@ -235,8 +378,10 @@ class RBL_CaptureManager
 		{
 			int moneyReward = zone.GetStrategicValue() / 2;
 			int hrReward = 2;
-			econMgr.AddMoney(moneyReward);
-			econMgr.AddHR(hrReward);
+			RBL_EconomyTransaction reward = econMgr.BeginTransaction(RBL_EconomySource.CAPTURE, zoneID);
+			reward.AddMoney(moneyReward);
+			reward.AddHR(hrReward);
+			econMgr.CommitTransaction(reward);
 			PrintFormat("[RBL] Capture reward: $%1, +%2 HR", moneyReward, hrReward);
 		}
 
@@ -285,7 +430,7 @@ class RBL_CaptureManager
 		}
 	}
 
-	protected void DecayCaptureProgress(string zoneID)
+	protected void DecayCaptureProgress(string zoneID, float dt)
 	{
 		float currentProgress = 0;
 		if (!m_mCaptureProgress.Find(zoneID, currentProgress))
@@ -294,7 +439,7 @@ class RBL_CaptureManager
 		if (currentProgress <= 0)
 			return;
 
-		currentProgress -= RBL_Config.CAPTURE_DECAY_RATE;
+		currentProgress -= RBL_Config.CAPTURE_DECAY_RATE * dt;
 		if (currentProgress < 0)
 			currentProgress = 0;
 
@@ -313,11 +458,23 @@ class RBL_CaptureManager
 		return progress;
 	}
 
+	ERBLFactionKey GetCapturingFaction(string zoneID)
+	{
+		ERBLFactionKey faction = ERBLFactionKey.NONE;
+		m_mCapturingFaction.Find(zoneID, faction);
+		return faction;
+	}
+
 	bool IsZoneBeingCaptured(string zoneID)
 	{
 		return m_mCapturingFaction.Contains(zoneID);
 	}
 
+	int GetActiveZoneCount() { return m_aActiveZones.Count(); }
+	// Zones with players inside or residual progress; RBL_TransientChannel
+	// sends these to clients
+	array<RBL_VirtualZone> GetActiveZones() { return m_aActiveZones; }
+
 	ScriptInvoker GetOnCaptureStarted() { return m_OnCaptureStarted; }
 	ScriptInvoker GetOnCaptureProgress() { return m_OnCaptureProgress; }
 	ScriptInvoker GetOnCaptureComplete() { return m_OnCaptureComplete; }
@@ -27,11 +27,15 @@ class RBL_GarrisonData
 	void Clear()
 	{
 		// Delete all spawned entities
+		RBL_ZonePresence presence = RBL_ZonePresence.GetInstance();
 		for (int i = SpawnedUnits.Count() - 1; i >= 0; i--)
 		{
 			IEntity unit = SpawnedUnits[i];
 			if (unit)
+			{
+				presence.UnregisterUnit(unit);
 				SCR_EntityHelper.DeleteEntityAndChildren(unit);
+			}
 		}
 		SpawnedUnits.Clear();
 		
@@ -62,9 +66,14 @@ class RBL_GarrisonData
 			// Check if unit is alive
 			DamageManagerComponent dmgMgr = DamageManagerComponent.Cast(unit.FindComponent(DamageManagerComponent));
 			if (dmgMgr && dmgMgr.GetState() != EDamageState.DESTROYED)
+			{
 				alive++;
+			}
 			else
+			{
+				RBL_ZonePresence.GetInstance().UnregisterUnit(unit);
 				SpawnedUnits.Remove(i);
+			}
 		}
 		CurrentStrength = alive;
 		return alive;
@@ -326,7 +335,10 @@ class RBL_GarrisonManager
 			
 			IEntity unit = SpawnUnit(prefab, spawnPos);
 			if (unit)
+			{
 				data.SpawnedUnits.Insert(unit);
+				RBL_ZonePresence.GetInstance().RegisterUnit(unit, zoneID, owner);
+			}
 		}
 		
 		// Spawn vehicles
@@ -511,6 +523,8 @@ class RBL_GarrisonManager
 		return data;
 	}
 	
+	map<string, ref RBL_GarrisonData> GetAllGarrisons() { return m_mGarrisons; }
+	
 	// Update all garrisons (check alive counts)
 	void Update(float timeSlice)
 	{
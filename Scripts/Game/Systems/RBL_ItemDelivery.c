@@ -285,15 +285,15 @@ class RBL_ItemDelivery
 		{
 			m_OnItemDelivered.Invoke(eventData);
 			PrintFormat("[RBL_Delivery] Delivered %1 to player %2", item.GetDisplayName(), playerID);
-			NotifyDeliverySuccess(item.GetDisplayName(), category);
 		}
 		else
 		{
 			m_OnDeliveryFailed.Invoke(eventData);
 			PrintFormat("[RBL_Delivery] Failed to deliver %1: %2", item.GetDisplayName(), typename.EnumToString(ERBLDeliveryResult, result));
-			RBL_Notifications.DeliveryFailed(item.GetDisplayName());
 		}
 		
+		ReportDeliveryResult(playerID, item.GetDisplayName(), category, result);
+		
 		return result;
 	}
 	
@@ -350,6 +350,10 @@ class RBL_ItemDelivery
 		{
 			vector spawnPos = GetRecruitSpawnPosition(playerEntity, i);
 			IEntity recruitEntity = SpawnEntity(prefab, spawnPos);
+			
+			// Recruits count toward capture of whatever zone they are in
+			if (recruitEntity)
+				RBL_ZonePresence.GetInstance().RegisterMobileUnit(recruitEntity, ERBLFactionKey.FIA);
 		}
 		
 		return ERBLDeliveryResult.SUCCESS;
@@ -413,19 +417,16 @@ class RBL_ItemDelivery
 		{
 			m_OnItemDelivered.Invoke(eventData);
 			PrintFormat("[RBL_Delivery] Delivered %1 to player %2", item.GetDisplayName(), playerID);
-			
-			// Show category-specific notifications
-			NotifyDeliverySuccess(item.GetDisplayName(), item.GetCategory());
 		}
 		else
 		{
 			m_OnDeliveryFailed.Invoke(eventData);
 			PrintFormat("[RBL_Delivery] Failed to deliver %1: %2", item.GetDisplayName(), typename.EnumToString(ERBLDeliveryResult, result));
-			
-			// Show failure notification
-			RBL_Notifications.DeliveryFailed(item.GetDisplayName());
 		}
 		
+		// Show category-specific notifications to the receiving player
+		ReportDeliveryResult(playerID, item.GetDisplayName(), item.GetCategory(), result);
+		
 		return result;
 	}
 	
@@ -1204,6 +1205,23 @@ protected vector GetRecruitSpawnPosition(IEntity playerEntity, int index = 0)
 	// NOTIFICATIONS
 	// ========================================================================
 	
+	// Tell the receiving player how the delivery went. A multiplayer server
+	// sends it to that player's client only
+	protected void ReportDeliveryResult(int playerID, string itemName, string category, ERBLDeliveryResult result)
+	{
+		RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
+		if (netMgr && netMgr.IsServer() && RBL_NetworkUtils.IsMultiplayer())
+		{
+			netMgr.SendDeliveryResult(playerID, itemName, category, result);
+			return;
+		}
+		
+		if (result == ERBLDeliveryResult.SUCCESS)
+			NotifyDeliverySuccess(itemName, category);
+		else
+			RBL_Notifications.DeliveryFailed(itemName);
+	}
+	
 	// Show notification for successful delivery
 	void NotifyDeliverySuccess(string itemName, string category)
 	{
@@ -1322,8 +1340,10 @@ class RBL_DeliveryCommands
 		RBL_EconomyManager econ = RBL_EconomyManager.GetInstance();
 		if (econ)
 		{
-			econ.AddMoney(10000);
-			econ.AddHR(50);
+			RBL_EconomyTransaction grant = econ.BeginTransaction(RBL_EconomySource.DEBUG);
+			grant.AddMoney(10000);
+			grant.AddHR(50);
+			econ.CommitTransaction(grant);
 			PrintFormat("[RBL_Delivery] Added $10000 and 50 HR for testing");
 		}
 	}
@@ -0,0 +1,260 @@
+// ============================================================================
+// PROJECT REBELLION - Undercover Perception
+// View-cone and line-of-sight checks for enemy observers
+// Trace results are cached per (observer group, player) and budgeted per frame
+// ============================================================================
+
+class RBL_VisibilityEntry
+{
+	bool Visible;
+	float ExpiresAt;
+}
+
+class RBL_UndercoverPerception
+{
+	protected const float VISIBILITY_TTL = 1.5;
+	protected const int MAX_TRACES_PER_FRAME = 8;
+	
+	// Re-traces of expired entries may only use this much of the budget;
+	// the rest is kept for pairs that have never been traced
+	protected const int MAX_REFRESH_TRACES_PER_FRAME = 4;
+	protected const float PRUNE_INTERVAL = 10.0;
+	
+	// Trace from observer eye height to player chest height
+	protected const float OBSERVER_EYE_HEIGHT = 1.6;
+	protected const float TARGET_HEIGHT = 1.2;
+	
+	// Cache key = group handle * stride + player ID
+	protected const int CACHE_KEY_STRIDE = 65536;
+	
+	protected float m_fClock;
+	protected float m_fTimeSincePrune;
+	protected int m_iTracesThisFrame;
+	protected int m_iCandidateOffset;
+	protected float m_fConeCos;
+	
+	protected ref map<int, ref RBL_VisibilityEntry> m_mCache;
+	protected ref TraceParam m_TraceParam;
+	
+	// Scratch arrays reused between evaluations
+	protected ref array<int> m_aCandidates;
+	protected ref array<int> m_aResolvedGroups;
+	protected ref array<bool> m_aResolvedVisible;
+	
+	// Stats
+	protected int m_iTraceCount;
+	protected int m_iCacheHits;
+	protected int m_iBudgetMisses;
+	
+	void RBL_UndercoverPerception()
+	{
+		m_fClock = 0;
+		m_fTimeSincePrune = 0;
+		m_iTracesThisFrame = 0;
+		m_iCandidateOffset = 0;
+		m_fConeCos = Math.Cos(RBL_DetectionFactors.VIEW_CONE_HALF_ANGLE * Math.DEG2RAD);
+		
+		m_mCache = new map<int, ref RBL_VisibilityEntry>();
+		m_TraceParam = new TraceParam();
+		m_aCandidates = new array<int>();
+		m_aResolvedGroups = new array<int>();
+		m_aResolvedVisible = new array<bool>();
+		
+		m_iTraceCount = 0;
+		m_iCacheHits = 0;
+		m_iBudgetMisses = 0;
+	}
+	
+	// Called every frame - resets the trace budget and ages the cache
+	void Update(float timeSlice)
+	{
+		m_fClock += timeSlice;
+		m_iTracesThisFrame = 0;
+		
+		m_fTimeSincePrune += timeSlice;
+		if (m_fTimeSincePrune >= PRUNE_INTERVAL)
+		{
+			m_fTimeSincePrune = 0;
+			PruneExpired();
+		}
+	}
+	
+	// ========================================================================
+	// EVALUATION
+	// ========================================================================
+	
+	// Returns how many enemies within range can see the player and writes the
+	// distance to the closest of them (NO_RESULT_DISTANCE if none)
+	int EvaluateObservers(int playerID, IEntity playerEntity, vector playerPos, float range, out float nearestObserverDist)
+	{
+		nearestObserverDist = RBL_AISpatialHash.NO_RESULT_DISTANCE;
+		
+		RBL_AISpatialHash aiHash = RBL_AISpatialHash.GetInstance();
+		if (!aiHash || !playerEntity)
+			return 0;
+		
+		m_aCandidates.Clear();
+		m_aResolvedGroups.Clear();
+		m_aResolvedVisible.Clear();
+		
+		if (aiHash.QueryWithinRadius(playerPos, range, m_aCandidates) == 0)
+			return 0;
+		
+		int observerCount = 0;
+		
+		// Start at a different candidate each call so the same group does not
+		// always take the trace budget first
+		int candidateCount = m_aCandidates.Count();
+		m_iCandidateOffset = (m_iCandidateOffset + 1) % candidateCount;
+		
+		for (int i = 0; i < candidateCount; i++)
+		{
+			int index = m_aCandidates[(i + m_iCandidateOffset) % candidateCount];
+			vector observerPos = aiHash.GetEntryPosition(index);
+			float dist = vector.Distance(observerPos, playerPos);
+			
+			if (!IsInViewCone(observerPos, aiHash.GetEntryForward(index), playerPos, dist))
+				continue;
+			
+			// One trace answers for the whole observer group
+			int group = aiHash.GetEntryGroup(index);
+			bool visible;
+			int resolved = m_aResolvedGroups.Find(group);
+			if (resolved != -1)
+			{
+				visible = m_aResolvedVisible[resolved];
+			}
+			else
+			{
+				visible = ResolveGroupVisibility(group, playerID, aiHash.GetEntryEntity(index), observerPos, playerEntity, playerPos);
+				m_aResolvedGroups.Insert(group);
+				m_aResolvedVisible.Insert(visible);
+			}
+			
+			if (!visible)
+				continue;
+			
+			observerCount++;
+			if (dist < nearestObserverDist)
+				nearestObserverDist = dist;
+		}
+		
+		return observerCount;
+	}
+	
+	protected bool IsInViewCone(vector observerPos, vector observerForward, vector playerPos, float dist)
+	{
+		// Anyone this close notices regardless of facing
+		if (dist <= RBL_DetectionFactors.PERIPHERAL_AWARENESS_RANGE)
+			return true;
+		
+		vector toPlayer = playerPos - observerPos;
+		toPlayer[1] = 0;
+		observerForward[1] = 0;
+		
+		float toPlayerLen = toPlayer.Length();
+		float forwardLen = observerForward.Length();
+		if (toPlayerLen <= 0 || forwardLen <= 0)
+			return true;
+		
+		float cosAngle = vector.Dot(toPlayer, observerForward) / (toPlayerLen * forwardLen);
+		return cosAngle >= m_fConeCos;
+	}
+	
+	protected bool ResolveGroupVisibility(int group, int playerID, IEntity observer, vector observerPos, IEntity playerEntity, vector playerPos)
+	{
+		int key = group * CACHE_KEY_STRIDE + playerID;
+		
+		RBL_VisibilityEntry entry;
+		m_mCache.Find(key, entry);
+		
+		if (entry && entry.ExpiresAt > m_fClock)
+		{
+			m_iCacheHits++;
+			return entry.Visible;
+		}
+		
+		// Over budget: reuse the stale answer if there is one. A pair never
+		// traced counts as unseen only until a later frame has budget for it;
+		// expired entries leave part of every frame's budget to such pairs
+		int budget = MAX_TRACES_PER_FRAME;
+		if (entry)
+			budget = MAX_REFRESH_TRACES_PER_FRAME;
+		
+		if (m_iTracesThisFrame >= budget)
+		{
+			m_iBudgetMisses++;
+			if (entry)
+				return entry.Visible;
+			return false;
+		}
+		
+		m_iTracesThisFrame++;
+		m_iTraceCount++;
+		bool visible = TraceLineOfSight(observer, observerPos, playerEntity, playerPos);
+		
+		if (!entry)
+		{
+			entry = new RBL_VisibilityEntry();
+			m_mCache.Set(key, entry);
+		}
+		entry.Visible = visible;
+		entry.ExpiresAt = m_fClock + VISIBILITY_TTL;
+		
+		return visible;
+	}
+	
+	protected bool TraceLineOfSight(IEntity observer, vector observerPos, IEntity playerEntity, vector playerPos)
+	{
+		BaseWorld world = GetGame().GetWorld();
+		if (!world)
+			return false;
+		
+		m_TraceParam.Start = observerPos + Vector(0, OBSERVER_EYE_HEIGHT, 0);
+		m_TraceParam.End = playerPos + Vector(0, TARGET_HEIGHT, 0);
+		m_TraceParam.Flags = TraceFlags.WORLD | TraceFlags.ENTS;
+		m_TraceParam.LayerMask = EPhysicsLayerPresets.Projectile;
+		m_TraceParam.Exclude = observer;
+		m_TraceParam.TraceEnt = null;
+		
+		float fraction = world.TraceMove(m_TraceParam, null);
+		if (fraction >= 1.0)
+			return true;
+		
+		// Hitting the player, or the vehicle they are riding in, counts as seen
+		IEntity hitEntity = m_TraceParam.TraceEnt;
+		if (!hitEntity)
+			return false;
+		
+		return hitEntity == playerEntity || hitEntity.GetRootParent() == playerEntity.GetRootParent();
+	}
+	
+	protected void PruneExpired()
+	{
+		for (int i = m_mCache.Count() - 1; i >= 0; i--)
+		{
+			RBL_VisibilityEntry entry = m_mCache.GetElement(i);
+			if (!entry || entry.ExpiresAt <= m_fClock)
+				m_mCache.RemoveElement(i);
+		}
+	}
+	
+	// Drop cached results for a player (disconnect, respawn)
+	void ForgetPlayer(int playerID)
+	{
+		for (int i = m_mCache.Count() - 1; i >= 0; i--)
+		{
+			int key = m_mCache.GetKey(i);
+			if (key - (key / CACHE_KEY_STRIDE) * CACHE_KEY_STRIDE == playerID)
+				m_mCache.RemoveElement(i);
+		}
+	}
+	
+	// ========================================================================
+	// STATS
+	// ========================================================================
+	int GetTraceCount() { return m_iTraceCount; }
+	int GetCacheHitCount() { return m_iCacheHits; }
+	int GetBudgetMissCount() { return m_iBudgetMisses; }
+	int GetCachedEntryCount() { return m_mCache.Count(); }
+}
@@ -22,6 +22,10 @@ class RBL_DetectionFactors
 	static const float ENEMY_CLOSE_RANGE = 15.0;
 	static const float RESTRICTED_ZONE_RANGE = 100.0;
 	
+	// Perception (enemies must see the player to raise suspicion)
+	static const float VIEW_CONE_HALF_ANGLE = 60.0;
+	static const float PERIPHERAL_AWARENESS_RANGE = 5.0;
+	
 	// Status thresholds (0-1 scale)
 	static const float THRESHOLD_SUSPICIOUS = 0.25;
 	static const float THRESHOLD_SPOTTED = 0.50;
@@ -35,14 +39,26 @@ class RBL_UndercoverSystem
 	protected const float CHECK_INTERVAL = 0.5;
 	protected float m_fTimeSinceCheck;
 	
+	// Players of the current check cycle. The cycle is spread over the
+	// frames of one interval so every player gets a share of the perception
+	// trace budget, and starts one player further along each time
+	protected ref array<int> m_aCheckQueue;
+	protected int m_iCheckCursor;
+	protected int m_iCycleOffset;
+	
 	protected ref array<string> m_aIllegalWeapons;
 	protected ref array<string> m_aIllegalClothing;
 	protected ref array<string> m_aIllegalVehicles;
 	protected ref array<string> m_aRestrictedZoneTypes;
 	
 	protected ref map<int, ref RBL_PlayerCoverState> m_mPlayerStates;
+	protected ref RBL_UndercoverPerception m_Perception;
 	protected bool m_bEnabled;
 	
+	// Equipment cache stats
+	protected int m_iEquipmentEvaluations;
+	protected int m_iEquipmentCacheHits;
+	
 	// Events
 	protected ref ScriptInvoker m_OnStatusChanged;
 	protected ref ScriptInvoker m_OnCoverBlown;
@@ -57,10 +73,16 @@ class RBL_UndercoverSystem
 	void RBL_UndercoverSystem()
 	{
 		m_mPlayerStates = new map<int, ref RBL_PlayerCoverState>();
+		m_Perception = new RBL_UndercoverPerception();
 		m_OnStatusChanged = new ScriptInvoker();
 		m_OnCoverBlown = new ScriptInvoker();
 		m_fTimeSinceCheck = 0;
+		m_aCheckQueue = new array<int>();
+		m_iCheckCursor = 0;
+		m_iCycleOffset = 0;
 		m_bEnabled = true;
+		m_iEquipmentEvaluations = 0;
+		m_iEquipmentCacheHits = 0;
 		
 		InitializeIllegalItems();
 		InitializeRestrictedZones();
@@ -121,21 +143,30 @@ class RBL_UndercoverSystem
 		if (!m_bEnabled)
 			return;
 		
-		m_fTimeSinceCheck += timeSlice;
-		
-		if (m_fTimeSinceCheck < CHECK_INTERVAL)
-			return;
+		// Trace budget is per frame, so the perception clock ticks every frame
+		m_Perception.Update(timeSlice);
 		
-		m_fTimeSinceCheck = 0;
+		m_fTimeSinceCheck += timeSlice;
 		
-		// Check all players
-		array<int> playerIDs = GetAllPlayerIDs();
+		if (m_iCheckCursor >= m_aCheckQueue.Count())
+		{
+			if (m_fTimeSinceCheck < CHECK_INTERVAL)
+				return;
+			
+			m_fTimeSinceCheck = 0;
+			BeginCheckCycle();
+		}
 		
-		for (int i = 0; i < playerIDs.Count(); i++)
+		// Each player is still checked once per interval, so suspicion builds
+		// by CHECK_INTERVAL per check
+		int perFrame = Math.Max(1, Math.Ceil(m_aCheckQueue.Count() * timeSlice / CHECK_INTERVAL));
+		while (perFrame > 0 && m_iCheckCursor < m_aCheckQueue.Count())
 		{
-			int playerID = playerIDs[i];
-			IEntity playerEntity = GetPlayerEntity(playerID);
+			int playerID = m_aCheckQueue[m_iCheckCursor];
+			m_iCheckCursor++;
+			perFrame--;
 			
+			IEntity playerEntity = GetPlayerEntity(playerID);
 			if (!playerEntity)
 				continue;
 			
@@ -143,6 +174,24 @@ class RBL_UndercoverSystem
 		}
 	}
 	
+	protected void BeginCheckCycle()
+	{
+		array<int> playerIDs = GetAllPlayerIDs();
+		
+		m_aCheckQueue.Clear();
+		m_iCheckCursor = 0;
+		
+		int count = playerIDs.Count();
+		if (count == 0)
+			return;
+		
+		m_iCycleOffset = (m_iCycleOffset + 1) % count;
+		for (int i = 0; i < count; i++)
+		{
+			m_aCheckQueue.Insert(playerIDs[(i + m_iCycleOffset) % count]);
+		}
+	}
+	
 	protected array<int> GetAllPlayerIDs()
 	{
 		array<int> ids = new array<int>();
@@ -181,19 +230,50 @@ class RBL_UndercoverSystem
 		bool instantCompromise = false;
 		string compromiseReason = "";
 		
+		// Equipment factors only re-evaluate when an inventory, equip or
+		// vehicle event has dirtied the cached record
+		RBL_PlayerEquipmentState equipment = state.m_Equipment;
+		if (equipment.NeedsRefresh(playerEntity))
+		{
+			equipment.Store(
+				CheckWeaponVisibility(playerEntity),
+				CheckClothing(playerEntity),
+				CheckVehicle(playerEntity)
+			);
+			m_iEquipmentEvaluations++;
+		}
+		else
+		{
+			m_iEquipmentCacheHits++;
+		}
+		
 		// Check each detection factor
-		bool hasIllegalWeapon = CheckWeaponVisibility(playerEntity);
-		bool hasMilitaryClothing = CheckClothing(playerEntity);
-		bool inMilitaryVehicle = CheckVehicle(playerEntity);
+		bool hasIllegalWeapon = equipment.m_bHasIllegalWeapon;
+		bool hasMilitaryClothing = equipment.m_bHasMilitaryClothing;
+		bool inMilitaryVehicle = equipment.m_bInMilitaryVehicle;
 		bool nearEnemy = false;
 		bool veryCloseToEnemy = false;
 		bool inRestrictedZone = false;
-		bool isRunning = CheckIfRunning(playerEntity);
+		bool isRunning = CheckIfRunning(equipment);
 		
-		// Enemy proximity check
+		// Enemy proximity check (gunfire is heard regardless of line of sight)
 		float nearestEnemyDist = GetNearestEnemyDistance(playerPos);
-		nearEnemy = (nearestEnemyDist <= RBL_DetectionFactors.ENEMY_DETECTION_RANGE);
-		veryCloseToEnemy = (nearestEnemyDist <= RBL_DetectionFactors.ENEMY_CLOSE_RANGE);
+		bool enemyInEarshot = (nearestEnemyDist <= RBL_DetectionFactors.ENEMY_DETECTION_RANGE);
+		
+		int nearbyEnemyCount = 0;
+		int observerCount = 0;
+		float nearestObserverDist = RBL_AISpatialHash.NO_RESULT_DISTANCE;
+		if (enemyInEarshot)
+		{
+			nearbyEnemyCount = CountNearbyEnemies(playerPos);
+			
+			// Only enemies with the player in view cone and line of sight count
+			observerCount = m_Perception.EvaluateObservers(playerID, playerEntity, playerPos,
+				RBL_DetectionFactors.ENEMY_DETECTION_RANGE, nearestObserverDist);
+		}
+		
+		nearEnemy = (observerCount > 0);
+		veryCloseToEnemy = (nearestObserverDist <= RBL_DetectionFactors.ENEMY_CLOSE_RANGE);
 		
 		// Restricted zone check
 		inRestrictedZone = CheckRestrictedZone(playerPos);
@@ -221,7 +301,7 @@ class RBL_UndercoverSystem
 			suspicionDelta += RBL_DetectionFactors.RESTRICTED_ZONE * deltaTime;
 		
 		// Check for instant compromise triggers
-		if (state.m_bJustFiredWeapon && nearEnemy)
+		if (state.m_bJustFiredWeapon && enemyInEarshot)
 		{
 			instantCompromise = true;
 			compromiseReason = "Fired weapon near enemies";
@@ -261,6 +341,8 @@ class RBL_UndercoverSystem
 		state.m_bNearEnemy = nearEnemy;
 		state.m_bInRestrictedZone = inRestrictedZone;
 		state.m_fNearestEnemyDistance = nearestEnemyDist;
+		state.m_iNearbyEnemyCount = nearbyEnemyCount;
+		state.m_iObserverCount = observerCount;
 		
 		// Update status based on suspicion level
 		UpdatePlayerStatus(playerID, state);
@@ -330,14 +412,10 @@ class RBL_UndercoverSystem
 		return IsIllegalVehicle(prefabName);
 	}
 	
-	protected bool CheckIfRunning(IEntity playerEntity)
+	protected bool CheckIfRunning(RBL_PlayerEquipmentState equipment)
 	{
-		if (!playerEntity)
-			return false;
-		
-		CharacterControllerComponent charCtrl = CharacterControllerComponent.Cast(
-			playerEntity.FindComponent(CharacterControllerComponent));
-		
+		// Controller is resolved once when the record binds to the entity
+		CharacterControllerComponent charCtrl = equipment.GetCharacterController();
 		if (!charCtrl)
 			return false;
 		
@@ -347,69 +425,21 @@ class RBL_UndercoverSystem
 	
 	protected float GetNearestEnemyDistance(vector playerPos)
 	{
-		float nearestDist = 99999.0;
-		
-		// Query nearby entities
-		BaseWorld world = GetGame().GetWorld();
-		if (!world)
-			return nearestDist;
+		// Served from the shared AI index - no sphere query or component lookups
+		RBL_AISpatialHash aiHash = RBL_AISpatialHash.GetInstance();
+		if (!aiHash)
+			return RBL_AISpatialHash.NO_RESULT_DISTANCE;
 		
-		// Get all characters in range
-		array<IEntity> nearbyEntities = new array<IEntity>();
-		GetGame().GetWorld().QueryEntitiesBySphere(
-			playerPos,
-			RBL_DetectionFactors.ENEMY_DETECTION_RANGE * 2,
-			QueryEnemyCallback,
-			FilterEnemyCallback,
-			EQueryEntitiesFlags.DYNAMIC
-		);
-		
-		// Find nearest USSR/enemy soldier
-		// This is handled by the callback storing results
-		return m_fQueryNearestEnemy;
+		return aiHash.GetNearestDistance(playerPos, RBL_DetectionFactors.ENEMY_DETECTION_RANGE * 2);
 	}
 	
-	// Query result storage
-	protected float m_fQueryNearestEnemy = 99999.0;
-	protected vector m_vQueryOrigin;
-	
-	protected bool QueryEnemyCallback(IEntity entity)
+	protected int CountNearbyEnemies(vector playerPos)
 	{
-		if (!entity)
-			return true;
-		
-		// Check if it's an AI character
-		AIControlComponent aiControl = AIControlComponent.Cast(entity.FindComponent(AIControlComponent));
-		if (!aiControl)
-			return true;
-		
-		// Check faction
-		FactionAffiliationComponent faction = FactionAffiliationComponent.Cast(
-			entity.FindComponent(FactionAffiliationComponent));
-		
-		if (!faction)
-			return true;
-		
-		Faction entityFaction = faction.GetAffiliatedFaction();
-		if (!entityFaction)
-			return true;
-		
-		string factionKey = entityFaction.GetFactionKey();
-		
-		// Check if USSR or enemy faction
-		if (factionKey == "USSR" || factionKey == "OPFOR")
-		{
-			float dist = vector.Distance(m_vQueryOrigin, entity.GetOrigin());
-			if (dist < m_fQueryNearestEnemy)
-				m_fQueryNearestEnemy = dist;
-		}
+		RBL_AISpatialHash aiHash = RBL_AISpatialHash.GetInstance();
+		if (!aiHash)
+			return 0;
 		
-		return true;
-	}
-	
-	protected bool FilterEnemyCallback(IEntity entity)
-	{
-		return entity != null;
+		return aiHash.CountWithinRadius(playerPos, RBL_DetectionFactors.ENEMY_DETECTION_RANGE);
 	}
 	
 	protected bool CheckRestrictedZone(vector playerPos)
@@ -468,6 +498,7 @@ class RBL_UndercoverSystem
 			
 			// Notify
 			m_OnStatusChanged.Invoke(playerID, oldStatus, newStatus);
+			SendStatusToOwner(playerID, state);
 			
 			// Log status changes
 			string statusName = typename.EnumToString(ERBLCoverStatus, newStatus);
@@ -484,6 +515,18 @@ class RBL_UndercoverSystem
 		}
 	}
 	
+	// The server's view of a player's cover is authoritative; only that
+	// player's client is told about it
+	protected void SendStatusToOwner(int playerID, RBL_PlayerCoverState state)
+	{
+		if (!RBL_NetworkUtils.IsMultiplayer() || !RBL_NetworkUtils.IsServer())
+			return;
+		
+		RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
+		if (netMgr)
+			netMgr.SendCoverStatus(playerID, state.m_eCurrentStatus, state.m_fSuspicionLevel, state.m_sCompromiseReason);
+	}
+	
 	// ========================================================================
 	// EVENT TRIGGERS (Call from game events)
 	// ========================================================================
@@ -501,7 +544,20 @@ class RBL_UndercoverSystem
 	
 	void OnPlayerEnteredVehicle(int playerID, IEntity vehicle)
 	{
-		// Handled in regular check
+		RBL_PlayerCoverState state = GetOrCreatePlayerState(playerID);
+		state.m_Equipment.Invalidate();
+	}
+	
+	void OnPlayerExitedVehicle(int playerID, IEntity vehicle)
+	{
+		RBL_PlayerCoverState state = GetOrCreatePlayerState(playerID);
+		state.m_Equipment.Invalidate();
+	}
+	
+	void OnPlayerEquipmentChanged(int playerID)
+	{
+		RBL_PlayerCoverState state = GetOrCreatePlayerState(playerID);
+		state.m_Equipment.Invalidate();
 	}
 	
 	// ========================================================================
@@ -673,25 +729,47 @@ class RBL_UndercoverSystem
 			state.m_bCoverBlownNotified = false;
 			state.m_sCompromiseReason = "";
 		}
+		
+		m_Perception.ForgetPlayer(playerID);
 	}
 	
 	// Item list management
 	void AddIllegalWeapon(string prefabName)
 	{
 		if (m_aIllegalWeapons.Find(prefabName) == -1)
+		{
 			m_aIllegalWeapons.Insert(prefabName);
+			InvalidateAllEquipment();
+		}
 	}
 	
 	void AddIllegalClothing(string prefabName)
 	{
 		if (m_aIllegalClothing.Find(prefabName) == -1)
+		{
 			m_aIllegalClothing.Insert(prefabName);
+			InvalidateAllEquipment();
+		}
 	}
 	
 	void AddIllegalVehicle(string prefabName)
 	{
 		if (m_aIllegalVehicles.Find(prefabName) == -1)
+		{
 			m_aIllegalVehicles.Insert(prefabName);
+			InvalidateAllEquipment();
+		}
+	}
+	
+	// Cached equipment results depend on the item lists above
+	protected void InvalidateAllEquipment()
+	{
+		for (int i = 0; i < m_mPlayerStates.Count(); i++)
+		{
+			RBL_PlayerCoverState state = m_mPlayerStates.GetElement(i);
+			if (state)
+				state.m_Equipment.Invalidate();
+		}
 	}
 	
 	// Event accessors
@@ -700,6 +778,9 @@ class RBL_UndercoverSystem
 	
 	// Stats
 	int GetTrackedPlayerCount() { return m_mPlayerStates.Count(); }
+	int GetEquipmentEvaluationCount() { return m_iEquipmentEvaluations; }
+	int GetEquipmentCacheHitCount() { return m_iEquipmentCacheHits; }
+	RBL_UndercoverPerception GetPerception() { return m_Perception; }
 }
 
 // ============================================================================
@@ -726,9 +807,15 @@ class RBL_PlayerCoverState
 	bool m_bInRestrictedZone;
 	float m_fNearestEnemyDistance;
 	int m_iNearbyEnemyCount;
+	int m_iObserverCount;
+	
+	// Cached equipment factors, invalidated by inventory/equip/vehicle events
+	ref RBL_PlayerEquipmentState m_Equipment;
 	
 	void RBL_PlayerCoverState()
 	{
+		m_Equipment = new RBL_PlayerEquipmentState();
+		
 		m_eCurrentStatus = ERBLCoverStatus.HIDDEN;
 		m_ePreviousStatus = ERBLCoverStatus.HIDDEN;
 		m_fSuspicionLevel = 0;
@@ -745,6 +832,7 @@ class RBL_PlayerCoverState
 		m_bInRestrictedZone = false;
 		m_fNearestEnemyDistance = 99999;
 		m_iNearbyEnemyCount = 0;
+		m_iObserverCount = 0;
 	}
 	
 	// Getters for UI
@@ -752,6 +840,7 @@ class RBL_PlayerCoverState
 	float GetSuspicion() { return m_fSuspicionLevel * 100.0; }
 	float GetSuspicionNormalized() { return m_fSuspicionLevel; }
 	int GetNearbyEnemyCount() { return m_iNearbyEnemyCount; }
+	int GetObserverCount() { return m_iObserverCount; }
 	float GetClosestEnemyDistance() { return m_fNearestEnemyDistance; }
 	bool HasIllegalWeapon() { return m_bHasIllegalWeapon; }
 	bool HasMilitaryClothing() { return m_bHasMilitaryClothing; }
@@ -804,6 +893,163 @@ class RBL_PlayerCoverState
 	}
 }
 
+// ============================================================================
+// PLAYER EQUIPMENT STATE
+// Cached weapon/clothing/vehicle factors for one player entity. Subscribes to
+// the entity's inventory, weapon and compartment events once on bind and is
+// only re-evaluated after one of them fires.
+// ============================================================================
+class RBL_PlayerEquipmentState
+{
+	bool m_bHasIllegalWeapon;
+	bool m_bHasMilitaryClothing;
+	bool m_bInMilitaryVehicle;
+	
+	protected IEntity m_BoundEntity;
+	protected bool m_bDirty;
+	
+	// False when a change event could not be hooked; the record is then
+	// re-evaluated every check rather than trusted
+	protected bool m_bWatched;
+	
+	protected SCR_InventoryStorageManagerComponent m_InventoryMgr;
+	protected SCR_CompartmentAccessComponent m_CompartmentAccess;
+	protected EventHandlerManagerComponent m_EventHandler;
+	protected CharacterControllerComponent m_CharController;
+	
+	void RBL_PlayerEquipmentState()
+	{
+		m_bHasIllegalWeapon = false;
+		m_bHasMilitaryClothing = false;
+		m_bInMilitaryVehicle = false;
+		m_bDirty = true;
+		m_bWatched = false;
+	}
+	
+	void ~RBL_PlayerEquipmentState()
+	{
+		Unbind();
+	}
+	
+	// Rebinds on respawn/possession change and reports whether the cached
+	// factors must be recomputed
+	bool NeedsRefresh(IEntity playerEntity)
+	{
+		if (playerEntity != m_BoundEntity)
+		{
+			Unbind();
+			Bind(playerEntity);
+		}
+		
+		return m_bDirty || !m_bWatched;
+	}
+	
+	void Store(bool hasIllegalWeapon, bool hasMilitaryClothing, bool inMilitaryVehicle)
+	{
+		m_bHasIllegalWeapon = hasIllegalWeapon;
+		m_bHasMilitaryClothing = hasMilitaryClothing;
+		m_bInMilitaryVehicle = inMilitaryVehicle;
+		m_bDirty = false;
+	}
+	
+	void Invalidate()
+	{
+		m_bDirty = true;
+	}
+	
+	bool IsDirty() { return m_bDirty; }
+	CharacterControllerComponent GetCharacterController() { return m_CharController; }
+	
+	// ========================================================================
+	// EVENT BINDING
+	// ========================================================================
+	protected void Bind(IEntity playerEntity)
+	{
+		m_BoundEntity = playerEntity;
+		m_bDirty = true;
+		m_bWatched = false;
+		
+		if (!playerEntity)
+			return;
+		
+		m_CharController = CharacterControllerComponent.Cast(
+			playerEntity.FindComponent(CharacterControllerComponent));
+		m_InventoryMgr = SCR_InventoryStorageManagerComponent.Cast(
+			playerEntity.FindComponent(SCR_InventoryStorageManagerComponent));
+		m_CompartmentAccess = SCR_CompartmentAccessComponent.Cast(
+			playerEntity.FindComponent(SCR_CompartmentAccessComponent));
+		m_EventHandler = EventHandlerManagerComponent.Cast(
+			playerEntity.FindComponent(EventHandlerManagerComponent));
+		
+		if (m_InventoryMgr)
+		{
+			m_InventoryMgr.m_OnItemAddedInvoker.Insert(OnItemAdded);
+			m_InventoryMgr.m_OnItemRemovedInvoker.Insert(OnItemRemoved);
+		}
+		
+		if (m_CompartmentAccess)
+		{
+			m_CompartmentAccess.GetOnCompartmentEntered().Insert(OnCompartmentEntered);
+			m_CompartmentAccess.GetOnCompartmentLeft().Insert(OnCompartmentLeft);
+		}
+		
+		if (m_EventHandler)
+			m_EventHandler.RegisterScriptHandler("OnWeaponChanged", this, OnWeaponChanged);
+		
+		m_bWatched = (m_InventoryMgr != null && m_CompartmentAccess != null && m_EventHandler != null);
+	}
+	
+	protected void Unbind()
+	{
+		if (m_InventoryMgr)
+		{
+			m_InventoryMgr.m_OnItemAddedInvoker.Remove(OnItemAdded);
+			m_InventoryMgr.m_OnItemRemovedInvoker.Remove(OnItemRemoved);
+		}
+		
+		if (m_CompartmentAccess)
+		{
+			m_CompartmentAccess.GetOnCompartmentEntered().Remove(OnCompartmentEntered);
+			m_CompartmentAccess.GetOnCompartmentLeft().Remove(OnCompartmentLeft);
+		}
+		
+		if (m_EventHandler)
+			m_EventHandler.RemoveScriptHandler("OnWeaponChanged", this, OnWeaponChanged);
+		
+		m_InventoryMgr = null;
+		m_CompartmentAccess = null;
+		m_EventHandler = null;
+		m_CharController = null;
+		m_BoundEntity = null;
+		m_bWatched = false;
+	}
+	
+	protected void OnItemAdded(IEntity item, BaseInventoryStorageComponent storage)
+	{
+		m_bDirty = true;
+	}
+	
+	protected void OnItemRemoved(IEntity item, BaseInventoryStorageComponent storage)
+	{
+		m_bDirty = true;
+	}
+	
+	protected void OnWeaponChanged(BaseWeaponComponent newWeapon, BaseWeaponComponent prevWeapon)
+	{
+		m_bDirty = true;
+	}
+	
+	protected void OnCompartmentEntered(IEntity targetEntity, BaseCompartmentManagerComponent manager, int mgrID, int slotID, bool move)
+	{
+		m_bDirty = true;
+	}
+	
+	protected void OnCompartmentLeft(IEntity targetEntity, BaseCompartmentManagerComponent manager, int mgrID, int slotID, bool move)
+	{
+		m_bDirty = true;
+	}
+}
+
 // ============================================================================
 // DEBUG COMMANDS
 // ============================================================================
@@ -832,6 +1078,14 @@ class RBL_UndercoverCommands
 				PrintFormat("Nearest enemy: %.0fm", state.m_fNearestEnemyDistance);
 			}
 		}
+		
+		PrintFormat("Equipment evaluations: %1 (cache hits: %2)",
+			system.GetEquipmentEvaluationCount(), system.GetEquipmentCacheHitCount());
+		
+		RBL_UndercoverPerception perception = system.GetPerception();
+		PrintFormat("LOS traces: %1 (cache hits: %2, over budget: %3, cached: %4)",
+			perception.GetTraceCount(), perception.GetCacheHitCount(),
+			perception.GetBudgetMissCount(), perception.GetCachedEntryCount());
 	}
 	
 	static void ResetCover()
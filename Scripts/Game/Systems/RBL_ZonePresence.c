@@ -0,0 +1,264 @@
+// ============================================================================
+// PROJECT REBELLION - Zone Presence
+// Live per-zone, per-faction count of AI units
+// Maintained incrementally by the garrison and QRF systems on spawn/death
+// Mobile units (FIA recruits following players) are re-homed to the zone
+// they stand in every few seconds
+// ============================================================================
+
+// Where a tracked unit is counted
+class RBL_PresenceRecord
+{
+	string ZoneID;
+	ERBLFactionKey Faction;
+	SCR_CharacterControllerComponent Controller;
+	bool Mobile;
+}
+
+class RBL_ZonePresence
+{
+	protected static ref RBL_ZonePresence s_Instance;
+	
+	// One slot per ERBLFactionKey value
+	protected const int FACTION_SLOTS = 5;
+	
+	// Units deleted without dying (cleanup, streaming) are swept up here
+	protected const float RECONCILE_INTERVAL = 30.0;
+	protected const float MOBILE_REFRESH_INTERVAL = 2.0;
+	
+	protected ref map<IEntity, ref RBL_PresenceRecord> m_mUnits;
+	protected ref map<string, ref array<int>> m_mCounts;
+	protected float m_fTimeSinceReconcile;
+	protected float m_fTimeSinceMobileRefresh;
+	
+	// Units whose zone follows their position
+	protected ref array<IEntity> m_aMobileUnits;
+	
+	static RBL_ZonePresence GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new RBL_ZonePresence();
+		return s_Instance;
+	}
+	
+	void RBL_ZonePresence()
+	{
+		m_mUnits = new map<IEntity, ref RBL_PresenceRecord>();
+		m_mCounts = new map<string, ref array<int>>();
+		m_fTimeSinceReconcile = 0;
+		m_fTimeSinceMobileRefresh = 0;
+		m_aMobileUnits = new array<IEntity>();
+	}
+	
+	// ========================================================================
+	// REGISTRATION
+	// ========================================================================
+	
+	// Start counting a unit. An empty zoneID tracks the unit without
+	// counting it toward any zone (e.g. a QRF still en route)
+	void RegisterUnit(IEntity unit, string zoneID, ERBLFactionKey faction)
+	{
+		if (!unit || m_mUnits.Contains(unit))
+			return;
+		
+		RBL_PresenceRecord record = new RBL_PresenceRecord();
+		record.ZoneID = zoneID;
+		record.Faction = faction;
+		record.Controller = SCR_CharacterControllerComponent.Cast(unit.FindComponent(SCR_CharacterControllerComponent));
+		if (record.Controller)
+			record.Controller.GetOnPlayerDeathWithParam().Insert(OnUnitDeath);
+		
+		m_mUnits.Set(unit, record);
+		AdjustCount(zoneID, faction, 1);
+	}
+	
+	// Track a unit that moves freely; it counts toward whichever zone's
+	// capture radius it is in
+	void RegisterMobileUnit(IEntity unit, ERBLFactionKey faction)
+	{
+		if (!unit || m_mUnits.Contains(unit))
+			return;
+		
+		RegisterUnit(unit, FindZoneAt(unit.GetOrigin()), faction);
+		m_mUnits.Get(unit).Mobile = true;
+		m_aMobileUnits.Insert(unit);
+	}
+	
+	void UnregisterUnit(IEntity unit)
+	{
+		RBL_PresenceRecord record;
+		if (!unit || !m_mUnits.Find(unit, record))
+			return;
+		
+		if (record.Controller)
+			record.Controller.GetOnPlayerDeathWithParam().Remove(OnUnitDeath);
+		
+		AdjustCount(record.ZoneID, record.Faction, -1);
+		m_mUnits.Remove(unit);
+		
+		if (record.Mobile)
+			m_aMobileUnits.RemoveItem(unit);
+	}
+	
+	// Re-home a tracked unit, e.g. when a QRF arrives at its target zone
+	void MoveUnit(IEntity unit, string zoneID)
+	{
+		RBL_PresenceRecord record;
+		if (!unit || !m_mUnits.Find(unit, record) || record.ZoneID == zoneID)
+			return;
+		
+		AdjustCount(record.ZoneID, record.Faction, -1);
+		record.ZoneID = zoneID;
+		AdjustCount(zoneID, record.Faction, 1);
+	}
+	
+	protected void OnUnitDeath(SCR_CharacterControllerComponent characterController, IEntity killerEntity, Instigator killer)
+	{
+		if (characterController)
+			UnregisterUnit(characterController.GetOwner());
+	}
+	
+	protected void AdjustCount(string zoneID, ERBLFactionKey faction, int delta)
+	{
+		if (zoneID.IsEmpty() || faction < 0 || faction >= FACTION_SLOTS)
+			return;
+		
+		array<int> counts;
+		if (!m_mCounts.Find(zoneID, counts))
+		{
+			counts = new array<int>();
+			for (int i = 0; i < FACTION_SLOTS; i++)
+			{
+				counts.Insert(0);
+			}
+			m_mCounts.Set(zoneID, counts);
+		}
+		
+		counts[faction] = Math.Max(counts[faction] + delta, 0);
+	}
+	
+	// ========================================================================
+	// RECONCILE
+	// ========================================================================
+	void Update(float timeSlice)
+	{
+		m_fTimeSinceMobileRefresh += timeSlice;
+		if (m_fTimeSinceMobileRefresh >= MOBILE_REFRESH_INTERVAL)
+		{
+			m_fTimeSinceMobileRefresh = 0;
+			RefreshMobileUnits();
+		}
+		
+		m_fTimeSinceReconcile += timeSlice;
+		if (m_fTimeSinceReconcile < RECONCILE_INTERVAL)
+			return;
+		
+		m_fTimeSinceReconcile = 0;
+		Reconcile();
+	}
+	
+	protected void Reconcile()
+	{
+		for (int i = m_mUnits.Count() - 1; i >= 0; i--)
+		{
+			if (m_mUnits.GetKey(i))
+				continue;
+			
+			RBL_PresenceRecord record = m_mUnits.GetElement(i);
+			if (record)
+				AdjustCount(record.ZoneID, record.Faction, -1);
+			m_mUnits.RemoveElement(i);
+		}
+		
+		for (int i = m_aMobileUnits.Count() - 1; i >= 0; i--)
+		{
+			if (!m_aMobileUnits[i])
+				m_aMobileUnits.Remove(i);
+		}
+	}
+	
+	protected void RefreshMobileUnits()
+	{
+		foreach (IEntity unit : m_aMobileUnits)
+		{
+			if (unit)
+				MoveUnit(unit, FindZoneAt(unit.GetOrigin()));
+		}
+	}
+	
+	// Zone whose capture radius contains the position, or ""
+	protected string FindZoneAt(vector position)
+	{
+		RBL_ZoneManager zoneMgr = RBL_ZoneManager.GetInstance();
+		if (!zoneMgr)
+			return "";
+		
+		RBL_VirtualZone zone = zoneMgr.GetNearestVirtualZone(position);
+		if (!zone || vector.Distance(position, zone.GetZonePosition()) > zone.GetCaptureRadius())
+			return "";
+		
+		return zone.GetZoneID();
+	}
+	
+	// ========================================================================
+	// QUERIES
+	// ========================================================================
+	
+	int GetPresence(string zoneID, ERBLFactionKey faction)
+	{
+		array<int> counts;
+		if (!m_mCounts.Find(zoneID, counts) || faction < 0 || faction >= FACTION_SLOTS)
+			return 0;
+		
+		return counts[faction];
+	}
+	
+	// Combatants in the zone that are not on the given side
+	int GetHostilePresence(string zoneID, ERBLFactionKey faction)
+	{
+		array<int> counts;
+		if (!m_mCounts.Find(zoneID, counts))
+			return 0;
+		
+		int hostile = 0;
+		for (int i = 0; i < FACTION_SLOTS; i++)
+		{
+			if (i == faction || i == ERBLFactionKey.NONE || i == ERBLFactionKey.CIVILIAN)
+				continue;
+			hostile += counts[i];
+		}
+		return hostile;
+	}
+	
+	int GetTrackedUnitCount() { return m_mUnits.Count(); }
+	int GetTrackedZoneCount() { return m_mCounts.Count(); }
+}
+
+// ============================================================================
+// DEBUG COMMANDS
+// ============================================================================
+class RBL_ZonePresenceCommands
+{
+	static void PrintStats()
+	{
+		RBL_ZonePresence presence = RBL_ZonePresence.GetInstance();
+		if (!presence)
+			return;
+		
+		PrintFormat("[RBL_Presence] === ZONE PRESENCE ===");
+		PrintFormat("Tracked units: %1", presence.GetTrackedUnitCount());
+		PrintFormat("Tracked zones: %1", presence.GetTrackedZoneCount());
+	}
+	
+	static void PrintZone(string zoneID)
+	{
+		RBL_ZonePresence presence = RBL_ZonePresence.GetInstance();
+		if (!presence)
+			return;
+		
+		PrintFormat("[RBL_Presence] %1: FIA=%2 USSR=%3 US=%4", zoneID,
+			presence.GetPresence(zoneID, ERBLFactionKey.FIA),
+			presence.GetPresence(zoneID, ERBLFactionKey.USSR),
+			presence.GetPresence(zoneID, ERBLFactionKey.US));
+	}
+}
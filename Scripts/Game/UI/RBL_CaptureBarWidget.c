@@ -91,7 +91,7 @@ class RBL_CaptureBarWidgetImpl : RBL_BaseWidget
 		{
 			m_sCapturingZoneID = zoneID;
 			m_sCapturingZoneName = zoneID;
-			m_fCaptureProgress = captureProgress / 100.0;
+			m_fCaptureProgress = GetZoneProgress(zoneID, captureProgress);
 			m_iCapturingPlayers = 1;
 			m_bIsContested = nearestZone.GetGarrisonStrength() > 0;
 		}
@@ -127,6 +127,15 @@ class RBL_CaptureBarWidgetImpl : RBL_BaseWidget
 		m_bWasCapturing = m_bIsCapturing;
 	}
 	
+	// Progress for the bar; a zone updated by the server is extrapolated
+	// between its packets
+	protected float GetZoneProgress(string zoneID, float localProgress)
+	{
+		if (m_bHasNetworkData && m_sNetworkZoneID == zoneID)
+			return GetPredictedNetworkProgress();
+		return localProgress / 100.0;
+	}
+	
 	protected IEntity GetLocalPlayer()
 	{
 		PlayerController pc = GetGame().GetPlayerController();
@@ -139,6 +148,10 @@ class RBL_CaptureBarWidgetImpl : RBL_BaseWidget
 	{
 		super.Update(timeSlice);
 		
+		m_fNetworkSampleAge += timeSlice;
+		if (m_bIsCapturing && m_bHasNetworkData && m_sCapturingZoneID == m_sNetworkZoneID)
+			m_fCaptureProgress = GetPredictedNetworkProgress();
+		
 		// Smooth progress animation
 		float targetProgress = 0;
 		if (m_bIsCapturing)
@@ -329,12 +342,21 @@ class RBL_CaptureBarWidgetImpl : RBL_BaseWidget
 	protected string m_sNetworkZoneID;
 	protected float m_fNetworkProgress;
 	protected int m_iNetworkCapturingFaction;
+	protected float m_fNetworkRate;
+	protected float m_fNetworkSampleAge;
 	
 	void SetNetworkCaptureProgress(string zoneID, float progress, int capturingFaction)
 	{
+		float newProgress = progress / 100.0;
+		if (m_bHasNetworkData && m_sNetworkZoneID == zoneID && m_fNetworkSampleAge > 0.05)
+			m_fNetworkRate = (newProgress - m_fNetworkProgress) / m_fNetworkSampleAge;
+		else
+			m_fNetworkRate = 0;
+		m_fNetworkSampleAge = 0;
+		
 		m_bHasNetworkData = true;
 		m_sNetworkZoneID = zoneID;
-		m_fNetworkProgress = progress / 100.0;
+		m_fNetworkProgress = newProgress;
 		m_iNetworkCapturingFaction = capturingFaction;
 		
 		// If player is not in capture range, use network data
@@ -383,9 +405,16 @@ class RBL_CaptureBarWidgetImpl : RBL_BaseWidget
 			// Update existing capture progress with network data
 			m_fCaptureProgress = m_fNetworkProgress;
 		}
-		
-		PrintFormat("[RBL_CaptureBar] Network progress update: %1 = %2%% (faction: %3)", 
-			zoneID, progress, capturingFaction);
+	}
+	
+	// Updates arrive as a byte, and only when the server's progress drifts
+	// from this prediction or the keepalive is due; the rate between the
+	// last two carries the bar forward until the next one, for as long as
+	// the server itself assumes
+	float GetPredictedNetworkProgress()
+	{
+		float ahead = Math.Min(m_fNetworkSampleAge, RBL_Config.TRANSIENT_KEEPALIVE);
+		return Math.Clamp(m_fNetworkProgress + m_fNetworkRate * ahead, 0, 1);
 	}
 	
 	void ClearNetworkCaptureProgress(string zoneID)
@@ -396,6 +425,7 @@ class RBL_CaptureBarWidgetImpl : RBL_BaseWidget
 			m_sNetworkZoneID = "";
 			m_fNetworkProgress = 0;
 			m_iNetworkCapturingFaction = 0;
+			m_fNetworkRate = 0;
 			
 			// If player is not in a zone either, clear display
 			if (!m_bIsCapturing || m_sCapturingZoneID == zoneID)
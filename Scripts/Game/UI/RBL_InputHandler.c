@@ -302,7 +302,7 @@ class RBL_DebugCommands
 		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
 		if (econMgr)
 		{
-			econMgr.AddMoney(amount);
+			econMgr.AddMoney(amount, RBL_EconomySource.DEBUG);
 			PrintFormat("[RBL_Debug] Added $%1. New balance: $%2", amount, econMgr.GetMoney());
 		}
 	}
@@ -312,7 +312,7 @@ class RBL_DebugCommands
 		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
 		if (econMgr)
 		{
-			econMgr.AddHR(amount);
+			econMgr.AddHR(amount, RBL_EconomySource.DEBUG);
 			PrintFormat("[RBL_Debug] Added %1 HR. New total: %2", amount, econMgr.GetHR());
 		}
 	}
@@ -350,8 +350,10 @@ class RBL_DebugCommands
 			RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
 			if (econMgr)
 			{
-				econMgr.AddMoney(zone.GetStrategicValue() / 2);
-				econMgr.AddHR(2);
+				RBL_EconomyTransaction reward = econMgr.BeginTransaction(RBL_EconomySource.DEBUG, zoneID);
+				reward.AddMoney(zone.GetStrategicValue() / 2);
+				reward.AddHR(2);
+				econMgr.CommitTransaction(reward);
 			}
 
 			// Notify campaign manager
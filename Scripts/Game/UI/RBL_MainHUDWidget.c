@@ -61,8 +61,8 @@ class RBL_MainHUDWidget : RBL_PanelWidget
 		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
 		if (econMgr)
 		{
-			int newMoney = econMgr.GetMoney();
-			int newHR = econMgr.GetHR();
+			int newMoney = econMgr.GetAvailableMoney();
+			int newHR = econMgr.GetAvailableHR();
 			
 			// Check for changes
 			if (newMoney != m_iMoney)
@@ -1,6 +1,6 @@
 // ============================================================================
 // PROJECT REBELLION - Map Marker System
-// World-space markers for zones visible in-game
+// World-space markers for zones and enemy QRFs visible in-game
 // ============================================================================
 
 // Individual zone marker
@@ -196,6 +196,42 @@ class RBL_MapMarkerManagerImpl : RBL_BaseWidget
 			
 			DrawMarker(marker);
 		}
+		
+		DrawQRFMarkers();
+	}
+	
+	// Enemy QRFs, at positions interpolated between transient updates
+	protected void DrawQRFMarkers()
+	{
+		IEntity player = GetLocalPlayer();
+		if (!player)
+			return;
+		
+		vector playerPos = player.GetOrigin();
+		map<int, ref RBL_QRFTrack> tracks = RBL_TransientChannel.GetInstance().GetQRFTracks();
+		for (int i = 0; i < tracks.Count(); i++)
+		{
+			RBL_QRFTrack track = tracks.GetElement(i);
+			vector position = track.GetPosition();
+			float distance = vector.Distance(playerPos, position);
+			if (distance > m_fMaxDrawDistance)
+				continue;
+			
+			vector screenPos;
+			if (!WorldToScreen(position, screenPos))
+				continue;
+			
+			float x = screenPos[0];
+			float y = screenPos[1];
+			float size = RBL_UISizes.ICON_LARGE * 0.75;
+			
+			int color = ApplyAlpha(RBL_UIColors.COLOR_ACCENT_RED, m_fAlpha);
+			DrawRectOutline(x - size / 2, y - size / 2, size, size, color, 2);
+			
+			DbgUI.Begin("Marker_QRF_" + track.Handle, x - 20, y + size / 2 + 4);
+			DbgUI.Text(typename.EnumToString(ERBLQRFType, track.QRFType) + " " + RBL_UIStrings.FormatDistance(distance));
+			DbgUI.End();
+		}
 	}
 	
 	protected void DrawMarker(RBL_ZoneMarker marker)
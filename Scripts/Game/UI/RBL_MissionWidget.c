@@ -11,6 +11,9 @@ class RBL_MissionListWidget : RBL_PanelWidget
 	protected ref array<ref RBL_Mission> m_aDisplayedMissions;
 	protected int m_iSelectedIndex;
 	protected bool m_bShowAvailable;
+	// Mission list version the entries were built from; progress changes
+	// update the missions in place and need no rebuild
+	protected int m_iBuiltVersion;
 	
 	void RBL_MissionListWidget()
 	{
@@ -25,6 +28,7 @@ class RBL_MissionListWidget : RBL_PanelWidget
 		m_aDisplayedMissions = new array<ref RBL_Mission>();
 		m_iSelectedIndex = 0;
 		m_bShowAvailable = false;
+		m_iBuiltVersion = -1;
 		
 		m_fUpdateInterval = 0.5;
 	}
@@ -35,6 +39,10 @@ class RBL_MissionListWidget : RBL_PanelWidget
 		if (!missionMgr)
 			return;
 		
+		if (missionMgr.GetListVersion() == m_iBuiltVersion)
+			return;
+		m_iBuiltVersion = missionMgr.GetListVersion();
+		
 		m_aDisplayedMissions.Clear();
 		
 		// Get active missions
@@ -196,6 +204,7 @@ class RBL_MissionListWidget : RBL_PanelWidget
 	void ToggleShowAvailable()
 	{
 		m_bShowAvailable = !m_bShowAvailable;
+		m_iBuiltVersion = -1;
 	}
 	
 	void ActivateSelected()
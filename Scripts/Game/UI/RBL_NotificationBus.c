@@ -0,0 +1,330 @@
+// ============================================================================
+// PROJECT REBELLION - Notification Bus
+// Every notification helper posts here instead of showing or broadcasting
+// directly. Once per tick the bus:
+//   - coalesces identical messages into one toast with a repeat count
+//   - sums numeric ones ("+$50" five times becomes "+$250")
+//   - holds back categories that were shown too recently
+//   - sends everything meant for all players as one batched reliable RPC
+// ============================================================================
+
+class RBL_QueuedNotification
+{
+	string Key;
+	string Category;
+	string Message;
+	int Color;
+	float Duration;
+	bool Broadcast;
+	int Count;
+	
+	// Numeric entries
+	bool IsAmount;
+	int Amount;
+	string Prefix;
+	string Suffix;
+	string Label;
+	
+	string Format()
+	{
+		if (IsAmount)
+		{
+			string text = Prefix + Amount.ToString() + Suffix;
+			if (!Label.IsEmpty())
+				text += " (" + Label + ")";
+			return text;
+		}
+		
+		if (Count > 1)
+			return Message + " (x" + Count.ToString() + ")";
+		return Message;
+	}
+}
+
+class RBL_NotificationBus
+{
+	static const string CATEGORY_ZONE = "zone";
+	static const string CATEGORY_CAPTURE = "capture";
+	static const string CATEGORY_COMBAT = "combat";
+	static const string CATEGORY_MISSION = "mission";
+	static const string CATEGORY_SUSPICION = "suspicion";
+	static const string CATEGORY_MONEY = "money";
+	static const string CATEGORY_HR = "hr";
+	static const string CATEGORY_GENERAL = "general";
+	
+	protected static const string RECORD_SEPARATOR = "\n";
+	protected static const string FIELD_SEPARATOR = "|";
+	
+	// Held entries beyond this are dropped rather than queued
+	protected static const int MAX_QUEUED = 64;
+	// Toasts per flush; the rest wait for the next tick
+	protected static const int MAX_PER_FLUSH = 8;
+	
+	protected static ref RBL_NotificationBus s_Instance;
+	
+	// Pending entries in post order
+	protected ref array<ref RBL_QueuedNotification> m_aQueue;
+	// Minimum seconds between toasts of one category
+	protected ref map<string, float> m_mCategoryIntervals;
+	protected ref map<string, float> m_mLastShown;
+	protected float m_fTime;
+	
+	protected int m_iPosted;
+	protected int m_iShown;
+	protected int m_iDropped;
+	protected int m_iBatchesSent;
+	
+	static RBL_NotificationBus GetInstance()
+	{
+		if (!s_Instance)
+			s_Instance = new RBL_NotificationBus();
+		return s_Instance;
+	}
+	
+	void RBL_NotificationBus()
+	{
+		m_aQueue = new array<ref RBL_QueuedNotification>();
+		m_mLastShown = new map<string, float>();
+		m_fTime = 0;
+		
+		m_mCategoryIntervals = new map<string, float>();
+		m_mCategoryIntervals.Set(CATEGORY_ZONE, 0.5);
+		m_mCategoryIntervals.Set(CATEGORY_CAPTURE, 2.0);
+		m_mCategoryIntervals.Set(CATEGORY_COMBAT, 1.0);
+		m_mCategoryIntervals.Set(CATEGORY_SUSPICION, 3.0);
+		m_mCategoryIntervals.Set(CATEGORY_MONEY, 2.0);
+		m_mCategoryIntervals.Set(CATEGORY_HR, 2.0);
+	}
+	
+	// ========================================================================
+	// POSTING
+	// ========================================================================
+	
+	// Queue a text notification. Broadcast entries reach every player when
+	// posted on a multiplayer server and are shown locally everywhere else
+	void Post(string category, string message, int color, float duration, bool broadcast)
+	{
+		m_iPosted++;
+		
+		string key = category + FIELD_SEPARATOR + message;
+		RBL_QueuedNotification entry = FindQueued(key, broadcast);
+		if (entry)
+		{
+			entry.Count++;
+			entry.Duration = Math.Max(entry.Duration, duration);
+			return;
+		}
+		
+		entry = CreateEntry(key, category, color, duration, broadcast);
+		if (!entry)
+			return;
+		
+		entry.Message = message;
+	}
+	
+	// Queue a number that is summed with others of its category until shown.
+	// The label is kept only while every merged post shares it
+	void PostAmount(string category, int amount, string label, string prefix, string suffix, int color, float duration, bool broadcast)
+	{
+		m_iPosted++;
+		
+		RBL_QueuedNotification entry = FindQueued(category, broadcast);
+		if (entry)
+		{
+			entry.Count++;
+			entry.Amount += amount;
+			if (entry.Label != label)
+				entry.Label = "";
+			return;
+		}
+		
+		entry = CreateEntry(category, category, color, duration, broadcast);
+		if (!entry)
+			return;
+		
+		entry.IsAmount = true;
+		entry.Amount = amount;
+		entry.Label = label;
+		entry.Prefix = prefix;
+		entry.Suffix = suffix;
+	}
+	
+	protected RBL_QueuedNotification FindQueued(string key, bool broadcast)
+	{
+		foreach (RBL_QueuedNotification entry : m_aQueue)
+		{
+			if (entry.Key == key && entry.Broadcast == broadcast)
+				return entry;
+		}
+		return null;
+	}
+	
+	protected RBL_QueuedNotification CreateEntry(string key, string category, int color, float duration, bool broadcast)
+	{
+		if (m_aQueue.Count() >= MAX_QUEUED)
+		{
+			m_iDropped++;
+			return null;
+		}
+		
+		RBL_QueuedNotification entry = new RBL_QueuedNotification();
+		entry.Key = key;
+		entry.Category = category;
+		entry.Color = color;
+		entry.Duration = duration;
+		entry.Broadcast = broadcast;
+		entry.Count = 1;
+		m_aQueue.Insert(entry);
+		return entry;
+	}
+	
+	// ========================================================================
+	// FLUSH
+	// ========================================================================
+	
+	void Update(float timeSlice)
+	{
+		m_fTime += timeSlice;
+		
+		if (!m_aQueue.IsEmpty())
+			Flush();
+	}
+	
+	protected void Flush()
+	{
+		RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
+		bool canBroadcast = netMgr && netMgr.IsAuthority() && RBL_NetworkUtils.IsMultiplayer();
+		
+		array<string> records = new array<string>();
+		array<string> flushedCategories = new array<string>();
+		int shown = 0;
+		int i = 0;
+		
+		while (i < m_aQueue.Count() && shown < MAX_PER_FLUSH)
+		{
+			RBL_QueuedNotification entry = m_aQueue[i];
+			
+			// Entries of one category released this tick go out together;
+			// the interval only separates ticks
+			if (flushedCategories.Find(entry.Category) == -1 && IsRateLimited(entry.Category))
+			{
+				i++;
+				continue;
+			}
+			
+			if (flushedCategories.Find(entry.Category) == -1)
+				flushedCategories.Insert(entry.Category);
+			
+			if (entry.Broadcast && canBroadcast)
+				records.Insert(PackRecord(entry.Format(), entry.Color, entry.Duration));
+			else
+				RBL_Notifications.ShowNotification(entry.Format(), entry.Color, entry.Duration);
+			
+			m_aQueue.RemoveOrdered(i);
+			shown++;
+		}
+		
+		foreach (string category : flushedCategories)
+		{
+			m_mLastShown.Set(category, m_fTime);
+		}
+		
+		m_iShown += shown;
+		
+		if (records.IsEmpty())
+			return;
+		
+		string batch = records[0];
+		for (int r = 1; r < records.Count(); r++)
+		{
+			batch += RECORD_SEPARATOR + records[r];
+		}
+		
+		netMgr.BroadcastNotificationBatch(batch);
+		m_iBatchesSent++;
+	}
+	
+	protected bool IsRateLimited(string category)
+	{
+		float interval;
+		if (!m_mCategoryIntervals.Find(category, interval) || interval <= 0)
+			return false;
+		
+		float lastShown;
+		if (!m_mLastShown.Find(category, lastShown))
+			return false;
+		
+		return m_fTime - lastShown < interval;
+	}
+	
+	// ========================================================================
+	// BATCH FORMAT
+	// color|duration|message per record, records separated by newlines
+	// ========================================================================
+	
+	protected static string PackRecord(string message, int color, float duration)
+	{
+		string text = message;
+		text.Replace(RECORD_SEPARATOR, " ");
+		return color.ToString() + FIELD_SEPARATOR + duration.ToString() + FIELD_SEPARATOR + text;
+	}
+	
+	// Show every record of a received batch
+	static void ShowBatch(string batch)
+	{
+		array<string> records = new array<string>();
+		batch.Split(RECORD_SEPARATOR, records, true);
+		
+		foreach (string record : records)
+		{
+			// The message is last and may itself contain the separator
+			int colorEnd = record.IndexOf(FIELD_SEPARATOR);
+			if (colorEnd < 0)
+				continue;
+			
+			int durationEnd = record.IndexOfFrom(colorEnd + 1, FIELD_SEPARATOR);
+			if (durationEnd < 0)
+				continue;
+			
+			int color = record.Substring(0, colorEnd).ToInt();
+			float duration = record.Substring(colorEnd + 1, durationEnd - colorEnd - 1).ToFloat();
+			string message = record.Substring(durationEnd + 1, record.Length() - durationEnd - 1);
+			RBL_Notifications.ShowNotification(message, color, duration);
+		}
+	}
+	
+	// ========================================================================
+	// STATS
+	// ========================================================================
+	
+	int GetQueuedCount() { return m_aQueue.Count(); }
+	int GetPostedCount() { return m_iPosted; }
+	int GetShownCount() { return m_iShown; }
+	int GetDroppedCount() { return m_iDropped; }
+	int GetBatchesSent() { return m_iBatchesSent; }
+}
+
+// ============================================================================
+// DEBUG COMMANDS
+// ============================================================================
+class RBL_NotificationBusCommands
+{
+	static void PrintStats()
+	{
+		RBL_NotificationBus bus = RBL_NotificationBus.GetInstance();
+		PrintFormat("[RBL_NotificationBus] Posted: %1, shown: %2, queued: %3, dropped: %4, batches: %5",
+			bus.GetPostedCount(), bus.GetShownCount(), bus.GetQueuedCount(), bus.GetDroppedCount(), bus.GetBatchesSent());
+	}
+	
+	// Simulate a combat burst
+	static void Burst()
+	{
+		for (int i = 0; i < 5; i++)
+		{
+			RBL_Notifications.MoneyReceived(50, "Kill");
+			RBL_Notifications.ZoneContested("Test Zone");
+			RBL_Notifications.SuspicionIncreased();
+		}
+		PrintStats();
+	}
+}
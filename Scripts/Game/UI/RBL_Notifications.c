@@ -19,20 +19,11 @@ class RBL_Notifications
 	// NETWORK BROADCAST HELPERS
 	// ========================================================================
 	
-	protected static void BroadcastNotification(string message, int color, float duration)
+	// Queued on the notification bus, which coalesces bursts and sends one
+	// batched RPC per tick; off the server the message is shown locally
+	protected static void BroadcastNotification(string category, string message, int color, float duration)
 	{
-		if (RBL_NetworkUtils.IsServer())
-		{
-			RBL_NetworkManager netMgr = RBL_NetworkManager.GetInstance();
-			if (netMgr)
-			{
-				netMgr.BroadcastNotification(message, color, duration);
-				return;
-			}
-		}
-		
-		// Fallback to local notification
-		ShowNotification(message, color, duration);
+		RBL_NotificationBus.GetInstance().Post(category, message, color, duration, true);
 	}
 	
 	protected static void SendToPlayer(int playerID, string message, int color, float duration)
@@ -90,24 +81,24 @@ class RBL_Notifications
 	
 	static void ZoneCaptured(string zoneName)
 	{
-		BroadcastNotification("ZONE CAPTURED: " + zoneName, RBL_UIColors.COLOR_ACCENT_GREEN, 4.0);
+		BroadcastNotification(RBL_NotificationBus.CATEGORY_ZONE, "ZONE CAPTURED: " + zoneName, RBL_UIColors.COLOR_ACCENT_GREEN, 4.0);
 		PrintFormat("[RBL] Zone captured: %1", zoneName);
 	}
 	
 	static void ZoneLost(string zoneName)
 	{
-		BroadcastNotification("ZONE LOST: " + zoneName, RBL_UIColors.COLOR_ACCENT_RED, 4.0);
+		BroadcastNotification(RBL_NotificationBus.CATEGORY_ZONE, "ZONE LOST: " + zoneName, RBL_UIColors.COLOR_ACCENT_RED, 4.0);
 		PrintFormat("[RBL] Zone lost: %1", zoneName);
 	}
 	
 	static void ZoneContested(string zoneName)
 	{
-		BroadcastNotification("Zone Contested: " + zoneName, RBL_UIColors.COLOR_ACCENT_YELLOW, 3.0);
+		BroadcastNotification(RBL_NotificationBus.CATEGORY_ZONE, "Zone Contested: " + zoneName, RBL_UIColors.COLOR_ACCENT_YELLOW, 3.0);
 	}
 	
 	static void CaptureStarted(string zoneName)
 	{
-		ShowNotification("Capturing: " + zoneName, RBL_UIColors.COLOR_TEXT_PRIMARY, 2.0);
+		RBL_NotificationBus.GetInstance().Post(RBL_NotificationBus.CATEGORY_CAPTURE, "Capturing: " + zoneName, RBL_UIColors.COLOR_TEXT_PRIMARY, 2.0, false);
 	}
 	
 	// ========================================================================
@@ -116,18 +107,18 @@ class RBL_Notifications
 	
 	static void QRFIncoming(string type, string targetZone)
 	{
-		BroadcastNotification("ENEMY QRF INCOMING: " + type, RBL_UIColors.COLOR_ACCENT_RED, 5.0);
+		BroadcastNotification(RBL_NotificationBus.CATEGORY_COMBAT, "ENEMY QRF INCOMING: " + type, RBL_UIColors.COLOR_ACCENT_RED, 5.0);
 		PrintFormat("[RBL] QRF incoming: %1 to %2", type, targetZone);
 	}
 	
 	static void QRFDefeated()
 	{
-		BroadcastNotification("Enemy QRF Eliminated", RBL_UIColors.COLOR_ACCENT_GREEN, 3.0);
+		BroadcastNotification(RBL_NotificationBus.CATEGORY_COMBAT, "Enemy QRF Eliminated", RBL_UIColors.COLOR_ACCENT_GREEN, 3.0);
 	}
 	
 	static void WarLevelIncreased(int newLevel)
 	{
-		BroadcastNotification("WAR LEVEL: " + newLevel.ToString(), RBL_UIColors.COLOR_ACCENT_YELLOW, 4.0);
+		BroadcastNotification(RBL_NotificationBus.CATEGORY_GENERAL, "WAR LEVEL: " + newLevel.ToString(), RBL_UIColors.COLOR_ACCENT_YELLOW, 4.0);
 		PrintFormat("[RBL] War level increased to %1", newLevel);
 	}
 	
@@ -143,7 +134,7 @@ class RBL_Notifications
 	
 	static void SuspicionIncreased()
 	{
-		ShowNotification("Suspicion Rising...", RBL_UIColors.COLOR_ACCENT_YELLOW, 2.0);
+		RBL_NotificationBus.GetInstance().Post(RBL_NotificationBus.CATEGORY_SUSPICION, "Suspicion Rising...", RBL_UIColors.COLOR_ACCENT_YELLOW, 2.0, false);
 	}
 	
 	static void CoverRestored()
@@ -157,12 +148,13 @@ class RBL_Notifications
 	
 	static void MoneyReceived(int amount, string source)
 	{
-		ShowNotification("+$" + amount.ToString() + " (" + source + ")", RBL_UIColors.COLOR_ACCENT_GREEN, 2.0);
+		// Summed with other payouts until the category is shown again
+		RBL_NotificationBus.GetInstance().PostAmount(RBL_NotificationBus.CATEGORY_MONEY, amount, source, "+$", "", RBL_UIColors.COLOR_ACCENT_GREEN, 2.0, true);
 	}
 	
 	static void HRReceived(int amount, string source)
 	{
-		ShowNotification("+" + amount.ToString() + " HR (" + source + ")", RBL_UIColors.COLOR_ACCENT_GREEN, 2.0);
+		RBL_NotificationBus.GetInstance().PostAmount(RBL_NotificationBus.CATEGORY_HR, amount, source, "+", " HR", RBL_UIColors.COLOR_ACCENT_GREEN, 2.0, true);
 	}
 	
 	static void InsufficientFunds()
@@ -210,17 +202,17 @@ class RBL_Notifications
 	
 	static void MissionReceived(string missionName)
 	{
-		BroadcastNotification("NEW MISSION: " + missionName, RBL_UIColors.COLOR_ACCENT_BLUE, 4.0);
+		BroadcastNotification(RBL_NotificationBus.CATEGORY_MISSION, "NEW MISSION: " + missionName, RBL_UIColors.COLOR_ACCENT_BLUE, 4.0);
 	}
 	
 	static void MissionComplete(string missionName)
 	{
-		BroadcastNotification("MISSION COMPLETE: " + missionName, RBL_UIColors.COLOR_ACCENT_GREEN, 4.0);
+		BroadcastNotification(RBL_NotificationBus.CATEGORY_MISSION, "MISSION COMPLETE: " + missionName, RBL_UIColors.COLOR_ACCENT_GREEN, 4.0);
 	}
 	
 	static void MissionFailed(string missionName)
 	{
-		BroadcastNotification("MISSION FAILED: " + missionName, RBL_UIColors.COLOR_ACCENT_RED, 4.0);
+		BroadcastNotification(RBL_NotificationBus.CATEGORY_MISSION, "MISSION FAILED: " + missionName, RBL_UIColors.COLOR_ACCENT_RED, 4.0);
 	}
 	
 	// ========================================================================
@@ -46,8 +46,8 @@ class RBL_ScreenHUD
 		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
 		if (econMgr)
 		{
-			DbgUI.Text("Money: $" + econMgr.GetMoney().ToString());
-			DbgUI.Text("HR: " + econMgr.GetHR().ToString());
+			DbgUI.Text("Money: $" + econMgr.GetAvailableMoney().ToString());
+			DbgUI.Text("HR: " + econMgr.GetAvailableHR().ToString());
 		}
 
 		DbgUI.Text("---");
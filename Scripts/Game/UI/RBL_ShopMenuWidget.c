@@ -15,10 +15,12 @@ class RBL_ShopMenuWidgetImpl : RBL_PanelWidget
 	// Cached data from ShopManager
 	protected ref array<ref RBL_ShopCategory> m_aCategories;
 	
-	// Player resources
+	// Player resources, with purchases awaiting the server already taken off
 	protected int m_iPlayerMoney;
 	protected int m_iPlayerHR;
 	protected int m_iWarLevel;
+	protected int m_iPendingMoney;
+	protected bool m_bHasPending;
 	
 	// Animation
 	protected float m_fOpenAnimation;
@@ -42,6 +44,8 @@ class RBL_ShopMenuWidgetImpl : RBL_PanelWidget
 		m_iPlayerMoney = 0;
 		m_iPlayerHR = 0;
 		m_iWarLevel = 1;
+		m_iPendingMoney = 0;
+		m_bHasPending = false;
 		
 		m_fOpenAnimation = 0;
 		m_bClosing = false;
@@ -219,6 +223,14 @@ class RBL_ShopMenuWidgetImpl : RBL_PanelWidget
 		DbgUI.Text(RBL_UIStrings.FormatHR(m_iPlayerHR));
 		DbgUI.End();
 		
+		// Purchases sent but not yet confirmed by the server
+		if (m_bHasPending)
+		{
+			DbgUI.Begin("Shop_Pending", x + width - 200, y + 32);
+			DbgUI.Text("pending -" + RBL_UIStrings.FormatMoney(m_iPendingMoney));
+			DbgUI.End();
+		}
+		
 		// War level indicator
 		DbgUI.Begin("Shop_WarLevel", x + width - 300, y + 16);
 		DbgUI.Text(string.Format("WL:%1", m_iWarLevel));
@@ -577,6 +589,8 @@ class RBL_ShopMenuWidgetImpl : RBL_PanelWidget
 		
 		bool success = shopMgr.PurchaseItem(item.GetID());
 		
+		// In multiplayer the cost is already reserved, so the new balance
+		// shows before the server confirms
 		if (success)
 		{
 			RefreshPlayerResources();
@@ -599,8 +613,10 @@ class RBL_ShopMenuWidgetImpl : RBL_PanelWidget
 		RBL_EconomyManager econMgr = RBL_EconomyManager.GetInstance();
 		if (econMgr)
 		{
-			m_iPlayerMoney = econMgr.GetMoney();
-			m_iPlayerHR = econMgr.GetHR();
+			m_iPlayerMoney = econMgr.GetAvailableMoney();
+			m_iPlayerHR = econMgr.GetAvailableHR();
+			m_iPendingMoney = econMgr.GetPendingMoney();
+			m_bHasPending = econMgr.HasPendingTransactions();
 		}
 		
 		RBL_CampaignManager campMgr = RBL_CampaignManager.GetInstance();
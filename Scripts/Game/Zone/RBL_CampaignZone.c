@@ -128,6 +128,7 @@ class RBL_CampaignZone : GenericEntity
 		ERBLFactionKey previousOwner = m_eOwnerFaction;
 		m_ePreviousOwner = previousOwner;
 		m_eOwnerFaction = newOwner;
+		RBL_StateVersion.Bump();
 		
 		m_OnZoneCaptured.Invoke(this, previousOwner, newOwner);
 	}
@@ -143,7 +144,10 @@ class RBL_CampaignZone : GenericEntity
 		m_iCivilianSupport = Math.Clamp(support, 0, 100);
 		
 		if (previousSupport != m_iCivilianSupport)
+		{
+			RBL_StateVersion.Bump();
 			m_OnSupportChanged.Invoke(this, m_iCivilianSupport);
+		}
 	}
 
 	void SetSupportLevel(int support)
@@ -176,6 +180,7 @@ class RBL_CampaignZone : GenericEntity
 		if (m_bIsUnderAttack != isAttacked)
 		{
 			m_bIsUnderAttack = isAttacked;
+			RBL_StateVersion.Bump();
 			
 			if (isAttacked)
 				m_OnZoneAttacked.Invoke(this, attacker);
@@ -211,6 +216,7 @@ class RBL_CampaignZone : GenericEntity
 	void SetDestroyed(bool destroyed)
 	{
 		m_bIsDestroyed = destroyed;
+		RBL_StateVersion.Bump();
 	}
 
 	void SetLastCaptureTime(float time)
@@ -258,6 +264,7 @@ class RBL_CampaignZone : GenericEntity
 	void SetGarrisonStrength(int strength)
 	{
 		m_iCurrentGarrison = Math.Max(0, strength);
+		RBL_StateVersion.Bump();
 	}
 
 	void SetMaxGarrison(int maxGarrison)